@@ -14,4 +14,5 @@
 #include <nf/Future.h>
 #include <nf/MulticastPromise.h>
 #include <nf/Promise.h>
+#include <nf/async/Coroutine.h>
 #include <nf/async/Execute.h>
@@ -226,6 +226,22 @@ public:
      */
     void enablePeriodicBuildInfo(std::chrono::seconds interval = std::chrono::seconds{30});
 
+    /**
+     * @brief Enable periodic logging of the main executor's statistics.
+     *
+     * Enables @ref Executor::enableStatistics() "statistics" of the main thread's executor and
+     * logs them every specified interval, or, if none given, every 30 seconds. Tasks running
+     * longer than @p slowTaskThreshold are logged as they finish.
+     *
+     * @param interval Time in seconds between subsequent statistics logs.
+     * @param slowTaskThreshold Run time above which a task is logged as slow.
+     *
+     * @since 5.7
+     */
+    void enablePeriodicExecutorStatistics(
+        std::chrono::seconds interval = std::chrono::seconds{30},
+        std::chrono::microseconds slowTaskThreshold = std::chrono::milliseconds{100});
+
     /**
      * @brief Run the application.
      *
@@ -417,6 +433,11 @@ private:
      */
     void startVersionLogging() noexcept;
 
+    /**
+     * @brief Start periodically logging the main executor's statistics.
+     */
+    void startStatisticsLogging() noexcept;
+
     /**
      * @brief Prevents multiple application instances from running
      *
@@ -443,12 +464,15 @@ private:
     std::string m_description;
     std::string m_version;
     std::optional<std::chrono::seconds> m_buildInfoInterval;
+    std::optional<std::chrono::seconds> m_statisticsInterval;
+    std::chrono::microseconds m_slowTaskThreshold{0};
 
     std::unique_ptr<ApplicationOptions> m_options;
     std::vector<InitializationStep> m_ctors;
     std::vector<InitializationStep> m_dtors;
     std::unique_ptr<Timer> m_watchdogTimer;
     std::unique_ptr<Timer> m_versionTimer;
+    std::unique_ptr<Timer> m_statisticsTimer;
     std::unique_ptr<boost::interprocess::file_lock> m_uniqueInstanceLock;
 };
 
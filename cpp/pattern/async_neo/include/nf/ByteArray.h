@@ -29,6 +29,9 @@ NF_BEGIN_NAMESPACE
  * <code> std::basic_string<std::byte> </code> to replace @c ByteArray and implement all required
  * methods by your own, but this class offers some futures that makes coding easy.
  *
+ * @note Copies and sub-arrays of a @c ByteArray copy its content. Use @ref SharedBytes to share
+ * big payloads or to slice them without copying.
+ *
  * Consider that we have a wav-file and want to read that from the disk, validate and get
  * some parameters.
  *
@@ -874,6 +877,23 @@ public:
      */
     std::string toBase64() const noexcept;
 
+    /**
+     * @brief Convert the data to a lower-case hex-string without separators.
+     *
+     * @code
+     * auto arr = 0x0A'2B'3C_hex;
+     * auto hex = arr.toHex(); // "0a2b3c"
+     * @endcode
+     *
+     * @return Hex-encoded string which can be passed to @ref ByteArray::fromHex.
+     *
+     * @since 5.7
+     */
+    std::string toHex() const noexcept;
+
+private:
+    friend class SharedBytes;
+
 private:
     Container m_data;
 };
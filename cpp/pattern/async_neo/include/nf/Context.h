@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -64,7 +64,8 @@ public:
      *
      * @see @nfref{Executor::post()}.
      */
-    void post(Task &&task) const noexcept;
+    void post(Task &&task,
+              const source_location &location = source_location::current()) const noexcept;
 
     /**
      * @brief Post a delayed task to the bound executor.
@@ -80,6 +81,37 @@ public:
      */
     void post(Executor::Delay when, Task &&task) const noexcept;
 
+    /**
+     * @brief Post a task with a @p priority to the bound executor.
+     *
+     * This function enqueues a given task to the lane of the @p priority of the bound executor.
+     *
+     * If this instance of @ref Context is @ref reset() "reset" or destroyed before the task
+     * is invoked, all associated resources (e.g. captured objects in a lambda) are freed
+     * and the task will not be invoked.
+     *
+     * @see @nfref{Executor::post()}.
+     * @since 5.7
+     */
+    void post(Executor::Priority priority, Task &&task,
+              const source_location &location = source_location::current()) const noexcept;
+
+    /**
+     * @brief Post a batch of tasks to the bound executor.
+     *
+     * This function enqueues the given @p tasks as if they were posted one by one in the same
+     * order with @ref post(Task&&) const "post()". The tasks are stored in this context and
+     * handed over to the bound executor at once, see @nfref{Executor::postBatch()}.
+     *
+     * If this instance of @ref Context is @ref reset() "reset" or destroyed before a task
+     * is invoked, all associated resources (e.g. captured objects in a lambda) are freed
+     * and the task will not be invoked.
+     *
+     * @since 5.7
+     */
+    void postBatch(std::vector<Task> &&tasks,
+                   const source_location &location = source_location::current()) const noexcept;
+
     /**
      * @brief Bind an arbitrary callable and possibly make it a deferred one.
      *
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <nf/Function.h>
+#include <nf/detail/SlabAllocator.h>
 
 #include <boost/core/noncopyable.hpp>
 
@@ -21,6 +22,7 @@ NF_BEGIN_NAMESPACE
 
 class Context;
 class ContextItem;
+class Executor;
 
 namespace detail {
 
@@ -85,7 +87,8 @@ class ContextItem : boost::noncopyable, public std::enable_shared_from_this<Cont
 {
 public:
     using Task = Function<void()>;
-    using List = std::list<std::shared_ptr<ContextItem>>;
+    using List = std::list<std::shared_ptr<ContextItem>,
+                           detail::SlabAllocator<std::shared_ptr<ContextItem>>>;
     using Iterator = List::const_iterator;
 
 protected:
@@ -147,6 +150,14 @@ protected:
      */
     void post(Task &&task) noexcept;
 
+    /**
+     * @brief Get the executor of the bound context.
+     *
+     * @returns The executor, or @c nullptr if the item is not bound to a context.
+     * @since 5.7
+     */
+    std::shared_ptr<Executor> executor() const noexcept;
+
 private:
     friend class detail::ContextState;
     void contextualize(std::weak_ptr<detail::ContextState> &&state, Iterator it) noexcept;
@@ -16,15 +16,47 @@
 #include <nf/Function.h>
 #include <nf/LinuxSignal.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
+#include <optional>
 #include <thread>
+#include <vector>
+
+#include <experimental/source_location>
 
 NF_BEGIN_NAMESPACE
 
 class Timer;
 class IoWatch;
 
+using std::experimental::source_location;
+
+namespace detail {
+class TaskMonitor;
+
+/* While it lives, the tasks which this thread posts are attributed to the given location in the
+ * statistics of their executor. */
+class PostSite
+{
+public:
+    explicit PostSite(const source_location &location) noexcept;
+    ~PostSite();
+
+    PostSite(const PostSite &) = delete;
+    PostSite &operator=(const PostSite &) = delete;
+
+    /* The innermost site of this thread, if any. */
+    static const source_location *current() noexcept;
+
+private:
+    const source_location *m_previous;
+};
+} // namespace detail
+
 /**
  * @ingroup nf_core_Executors
  * @brief The executor.
@@ -48,6 +80,52 @@ public:
     using IoWatchTask = Function<bool(std::int16_t)>;
     using ExceptionHandler = Function<void(const std::exception_ptr &)>;
 
+    /**
+     * @brief Priority of a task.
+     *
+     * @see @ref post(Priority,Task&&)
+     * @since 5.7
+     */
+    enum class Priority
+    {
+        /// Latency-critical tasks, e.g. control messages.
+        High,
+        /// Regular tasks. This is the priority of tasks posted without one.
+        Normal,
+        /// Bulk work which may wait, e.g. flushing logs or dumping diagnostics.
+        Background
+    };
+
+    /**
+     * @brief Statistics of the tasks posted to an executor.
+     *
+     * @see @ref enableStatistics()
+     * @since 5.7
+     */
+    struct Statistics
+    {
+        /// Distribution of a duration. Percentiles are accurate to 12.5%.
+        struct Durations
+        {
+            std::uint64_t count{0};
+            std::chrono::nanoseconds mean{0};
+            std::chrono::nanoseconds p50{0};
+            std::chrono::nanoseconds p99{0};
+            std::chrono::nanoseconds max{0};
+        };
+
+        /// Number of tasks which are posted but not run yet.
+        std::uint64_t queued{0};
+        /// Number of tasks waiting in each lane, indexed by @ref Priority.
+        std::array<std::uint64_t, 3> queuedPerPriority{};
+        /// Number of tasks which ran longer than the slow task threshold.
+        std::uint64_t slowTasks{0};
+        /// Time between posting a task and starting to run it.
+        Durations queueWait;
+        /// Time to run a task.
+        Durations runTime;
+    };
+
 public:
     /**
      * @brief Get an executor for a caller's thread.
@@ -88,6 +166,49 @@ public:
      */
     void post(Delay delay, Task &&task) noexcept;
 
+    /**
+     * @brief Post a batch of tasks to the executor.
+     *
+     * This method enqueues the given @p tasks as if they were posted one by one in the same
+     * order, but at the cost of a single post: the queue is locked and the event loop is woken
+     * up at most once for the whole batch. Use it to fan out many small tasks to one executor.
+     *
+     * The default implementation posts the tasks one by one.
+     *
+     * @see @ref nf::Context::postBatch()
+     * @since 5.7
+     */
+    virtual void postBatch(std::vector<Task> &&tasks) noexcept;
+
+    /**
+     * @brief Post a task with a @p priority to the executor.
+     *
+     * The event loop keeps a queue, a @e lane, per priority. Tasks of the same lane run in the
+     * order they were posted, tasks of different lanes in no particular order. The lanes are
+     * served in a weighted round robin, which takes up to 16 high, 4 normal and 1 background
+     * task(s) per round. This way a burst of bulk work delays latency-critical tasks by a few
+     * tasks at most, while a busy lane cannot starve the lanes below it. @ref post(Task&&) and
+     * @ref postBatch() post to the @ref Priority::Normal "normal" lane.
+     *
+     * Executors without lanes, e.g. @ref ThreadPoolExecutor, post the task as usual.
+     *
+     * @see @ref nf::post(Executor::Priority,Executor::Task&&)
+     * @see @ref Timer::setPriority(), @ref IoWatch::setPriority()
+     * @since 5.7
+     */
+    void post(Priority priority, Task &&task,
+              const source_location &location = source_location::current()) noexcept;
+
+    /**
+     * @brief Get the number of tasks waiting in the lane of a @p priority.
+     *
+     * Executors without lanes return zero.
+     *
+     * @see @ref post(Priority,Task&&)
+     * @since 5.7
+     */
+    virtual std::size_t queueDepth(Priority priority) const noexcept;
+
     /**
      * @brief Make a timer using this executor.
      *
@@ -257,9 +378,51 @@ public:
      */
     bool isThisThread() const noexcept;
 
+    /**
+     * @brief Start collecting statistics of posted tasks.
+     *
+     * Afterwards, the executor measures the queue wait and the run time of every task posted
+     * with @ref post() or @ref postBatch(), and the number of queued tasks. A task running longer
+     * than @p slowTaskThreshold is logged as a warning together with the location it was posted
+     * from. That location is known for tasks posted through @ref Context, @ref post(Priority,Task&&)
+     * and the free @ref nf::post() functions. For tasks posted directly with @ref post(Task&&),
+     * the type of their target is logged instead. Timers and I/O watches are not measured.
+     *
+     * The statistics cost a few clock readings and an allocation per task, so they are
+     * disabled by default. Calling this method again only changes the threshold.
+     *
+     * @see @ref BaseApplication::enablePeriodicExecutorStatistics()
+     * @since 5.7
+     */
+    void enableStatistics(
+        std::chrono::microseconds slowTaskThreshold = std::chrono::milliseconds(100)) noexcept;
+
+    /**
+     * @brief Get the statistics collected since @ref enableStatistics() was called.
+     *
+     * @return Statistics, or nothing if they are not enabled.
+     *
+     * @since 5.7
+     */
+    std::optional<Statistics> statistics() const noexcept;
+
 protected:
     Executor() noexcept;
-    virtual ~Executor() = default;
+    virtual ~Executor();
+
+    /**
+     * @brief Prepare a task for statistics.
+     *
+     * Implementations must call it for every task right before enqueuing it.
+     *
+     * @since 5.7
+     */
+    void instrument(Task &task) noexcept
+    {
+        if (m_taskMonitor.load(std::memory_order_acquire)) {
+            instrumentImpl(task);
+        }
+    }
 
 private:
     /**
@@ -286,6 +449,14 @@ private:
      */
     virtual void postImpl(Delay delay, Task &&task) noexcept = 0;
 
+    /**
+     * @brief Post a task to the lane of a @p priority.
+     *
+     * It will be called by @c post(Priority, Task&&). The default implementation ignores the
+     * priority and calls @c post(Task&&).
+     */
+    virtual void postToLane(Priority priority, Task &&task) noexcept;
+
     /**
      * @brief Resets the Executor's queue.
      *
@@ -303,10 +474,22 @@ private:
 protected:
     std::thread::id m_threadId;
 
+private:
+    void instrumentImpl(Task &task) noexcept;
+
 private:
     ExceptionHandler m_exceptionHandler;
+    std::atomic<detail::TaskMonitor *> m_taskMonitor{nullptr};
 };
 
+/**
+ * @ingroup nf_core_Executors
+ * @brief Print executor statistics, e.g. to log them.
+ *
+ * @since 5.7
+ */
+std::ostream &operator<<(std::ostream &os, const Executor::Statistics &statistics) noexcept;
+
 /**
  * @ingroup nf_core_Executors
  * @brief Post a task to the executor of the current thread.
@@ -314,8 +497,10 @@ private:
  * Equivalent of <code>@ref nf::Executor::thisThread() "nf::Executor::thisThread()"->@ref
  * nf::Executor::post(Task&&) "post(task)"</code>.
  */
-inline void post(Executor::Task &&task) noexcept
+inline void post(Executor::Task &&task,
+                 const source_location &location = source_location::current()) noexcept
 {
+    detail::PostSite site(location);
     Executor::thisThread()->post(std::move(task));
 }
 
@@ -332,4 +517,19 @@ inline void post(Executor::Delay delay, Executor::Task &&task) noexcept
     Executor::thisThread()->post(delay, std::move(task));
 }
 
+/**
+ * @ingroup nf_core_Executors
+ * @brief Post a task with a priority to the executor of the current thread.
+ *
+ * Equivalent of <code>@ref nf::Executor::thisThread() "nf::Executor::thisThread()"->@ref
+ * nf::Executor::post(Priority,Task&&) "post(priority, task)"</code>.
+ *
+ * @since 5.7
+ */
+inline void post(Executor::Priority priority, Executor::Task &&task,
+                 const source_location &location = source_location::current()) noexcept
+{
+    Executor::thisThread()->post(priority, std::move(task), location);
+}
+
 NF_END_NAMESPACE
@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2019-2021 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2019-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -87,6 +87,45 @@ public:
     std::shared_ptr<Executor> makeExecutor() noexcept override;
 };
 
+/**
+ * @ingroup nf_Core
+ * @brief The NF epoll backend.
+ *
+ * This backend is based on Linux @c epoll and uses a lock-free queue for posted tasks. It is
+ * an alternative to @ref AsioFramework for executors which are fed by many threads. See
+ * @ref backend::EpollExecutor for details.
+ *
+ * @code
+ * nf::Framework::initialize(std::make_unique<nf::EpollFramework>());
+ * @endcode
+ */
+class EpollFramework : public Framework
+{
+public:
+    std::shared_ptr<Executor> makeExecutor() noexcept override;
+};
+
+/**
+ * @ingroup nf_Core
+ * @brief The NF io_uring backend.
+ *
+ * This backend extends the @ref EpollFramework "epoll backend" by performing the I/O
+ * operations of @ref nf/async/Io.h via Linux io_uring. See @ref backend::UringExecutor for
+ * details. If the kernel does not support io_uring, e.g. because it is too old or io_uring is
+ * disabled, this backend falls back to the epoll backend.
+ *
+ * @code
+ * nf::Framework::initialize(std::make_unique<nf::UringFramework>());
+ * @endcode
+ *
+ * @since 5.7
+ */
+class UringFramework : public Framework
+{
+public:
+    std::shared_ptr<Executor> makeExecutor() noexcept override;
+};
+
 namespace detail {
 // NOLINTNEXTLINE(readability-identifier-naming)
 extern std::unique_ptr<Framework> g_framework;
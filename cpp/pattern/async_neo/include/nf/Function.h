@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2019-2021 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2019-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -14,12 +14,32 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 
 NF_BEGIN_NAMESPACE
 
+/**
+ * @ingroup nf_core_Functional
+ * @brief Capacity of the inline storage of @ref nf::Function, in pointer-sized words.
+ *
+ * Targets which fit into this storage (together with a pointer to their virtual table) and
+ * which are @e nothrow move constructible are stored inside the @ref nf::Function object.
+ * Other targets are allocated on the heap. The value affects the layout of @ref nf::Function,
+ * so it must be defined consistently for all translation units of an application.
+ */
+#ifndef NF_FUNCTION_INLINE_CAPACITY
+#define NF_FUNCTION_INLINE_CAPACITY 6
+#endif
+
 namespace detail {
 
+inline constexpr std::size_t kFunctionInlineSize = NF_FUNCTION_INLINE_CAPACITY * sizeof(void *);
+
 class InvocableNtBase : boost::noncopyable
 {
 public:
@@ -31,11 +51,22 @@ class InvocableBase : public InvocableNtBase
 {
 public:
     virtual tReturn invoke(tArgs... args) noexcept(IsNoexcept) = 0;
+
+    /* Transfer the target into the storage of another function. An inline target is moved
+     * into @p storage, a heap allocated one just hands over its pointer. */
+    virtual InvocableBase *relocate(void *storage) noexcept = 0;
+
+    /* Destroy the target and release its memory if it was heap allocated. */
+    virtual void destroy() noexcept = 0;
+
+    virtual const std::type_info &targetType() const noexcept = 0;
 };
 
-template <bool IsNoexcept, typename tFunc, typename tReturn, typename... tArgs>
+template <bool IsInline, bool IsNoexcept, typename tFunc, typename tReturn, typename... tArgs>
 class Invocable final : public InvocableBase<IsNoexcept, tReturn, tArgs...>
 {
+    using BaseType = InvocableBase<IsNoexcept, tReturn, tArgs...>;
+
 public:
     template <typename xFunc,
               typename = std::enable_if_t<
@@ -45,6 +76,12 @@ public:
     {
     }
 
+    Invocable(Invocable &&other) noexcept
+        : BaseType()
+        , m_f(std::move(other.m_f))
+    {
+    }
+
     tReturn invoke(tArgs... args) noexcept(IsNoexcept) override
     {
         if constexpr (std::is_void_v<tReturn>) {
@@ -54,6 +91,31 @@ public:
         }
     }
 
+    BaseType *relocate([[maybe_unused]] void *storage) noexcept override
+    {
+        if constexpr (IsInline) {
+            auto *moved = new (storage) Invocable(std::move(*this));
+            this->~Invocable();
+            return moved;
+        } else {
+            return this;
+        }
+    }
+
+    void destroy() noexcept override
+    {
+        if constexpr (IsInline) {
+            this->~Invocable();
+        } else {
+            delete this;
+        }
+    }
+
+    const std::type_info &targetType() const noexcept override
+    {
+        return typeid(std::decay_t<tFunc>);
+    }
+
 private:
     std::decay_t<tFunc> m_f;
 };
@@ -73,6 +135,22 @@ protected:
 template <bool IsNoexcept, typename tReturn, typename... tArgs>
 class FunctionBase : public FunctionNtBase
 {
+    using InvocableType = detail::InvocableBase<IsNoexcept, tReturn, tArgs...>;
+
+    template <typename tFunc>
+    using InlineInvocable = Invocable<true, IsNoexcept, tFunc, tReturn, tArgs...>;
+
+    template <typename tFunc>
+    using HeapInvocable = Invocable<false, IsNoexcept, tFunc, tReturn, tArgs...>;
+
+    /* A target is stored inline only if relocating it cannot throw, because moving a function
+     * must stay noexcept. */
+    template <typename tFunc>
+    static constexpr bool IsStoredInline =
+        sizeof(InlineInvocable<tFunc>) <= kFunctionInlineSize
+        && alignof(InlineInvocable<tFunc>) <= alignof(void *)
+        && std::is_nothrow_move_constructible_v<std::decay_t<tFunc>>;
+
 public:
     FunctionBase() noexcept = default;
 
@@ -80,9 +158,32 @@ public:
               typename = std::enable_if_t<
                   !std::is_base_of_v<FunctionNtBase, std::remove_reference_t<tFunc>>>>
     FunctionBase(tFunc &&f) noexcept // NOLINT(google-explicit-constructor)
-        : m_f(std::make_unique<Invocable<IsNoexcept, tFunc, tReturn, tArgs...>>(
-            std::forward<tFunc>(f)))
     {
+        if constexpr (IsStoredInline<tFunc>) {
+            m_f = new (&m_storage) InlineInvocable<tFunc>(std::forward<tFunc>(f));
+        } else {
+            m_f = new HeapInvocable<tFunc>(std::forward<tFunc>(f));
+        }
+    }
+
+    FunctionBase(FunctionBase &&other) noexcept
+        : FunctionNtBase(std::move(other))
+    {
+        takeFrom(other);
+    }
+
+    FunctionBase &operator=(FunctionBase &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~FunctionBase()
+    {
+        reset();
     }
 
     template <typename... xArgs>
@@ -101,13 +202,42 @@ public:
 
     explicit operator bool() const noexcept
     {
-        return static_cast<bool>(m_f);
+        return m_f != nullptr;
+    }
+
+    /**
+     * @brief Get the type of the target, or @c typeid(void) if the function is empty.
+     *
+     * Use @ref nf::demangle() to get a human-readable name of the target, e.g. to log where
+     * a task comes from.
+     *
+     * @since 5.7
+     */
+    const std::type_info &targetType() const noexcept
+    {
+        return m_f ? m_f->targetType() : typeid(void);
+    }
+
+private:
+    void takeFrom(FunctionBase &other) noexcept
+    {
+        if (other.m_f) {
+            m_f = other.m_f->relocate(&m_storage);
+            other.m_f = nullptr;
+        }
+    }
+
+    void reset() noexcept
+    {
+        if (m_f) {
+            std::exchange(m_f, nullptr)->destroy();
+        }
     }
 
 private:
     friend class AnyFunction;
-    using InvocableType = detail::InvocableBase<IsNoexcept, tReturn, tArgs...>;
-    std::unique_ptr<InvocableType> m_f;
+    InvocableType *m_f{nullptr};
+    alignas(void *) std::byte m_storage[kFunctionInlineSize]; // NOLINT
 };
 
 class AnyFunction;
@@ -139,6 +269,11 @@ inline constexpr bool IsFunction =
  * In contrast to @c std::function, @c nf::Function is non-copyable and thus can store
  * non-copyable targets.
  *
+ * Small targets, e.g. lambdas capturing a few pointers, are stored inside the
+ * @c nf::Function object itself and do not require a heap allocation. The size of this inline
+ * storage is defined by @ref NF_FUNCTION_INLINE_CAPACITY. Bigger targets and targets which
+ * may throw when moved are allocated on the heap.
+ *
  * If an empty @c nf::Function is invoked:
  * - For @e noexcept targets @c std::terminate() is called.
  * - Else, @cppdoc{std::bad_function_call,utility/functional/bad_function_call} is thrown.
@@ -23,6 +23,9 @@ NF_BEGIN_NAMESPACE
 
 namespace detail {
 
+template <typename tValue, typename tStorage>
+class FutureAwaiter;
+
 template <typename tValue, typename tStorage = tValue>
 class FutureBase
 {
@@ -61,6 +64,7 @@ public:
 
 protected:
     friend Promise<tValue>;
+    friend FutureAwaiter<tValue, tStorage>;
     using SharedState = AsyncSharedState<tStorage>;
 
 protected:
@@ -10,7 +10,9 @@
 
 #pragma once
 
+#include <nf/Executor.h>
 #include <nf/Function.h>
+#include <nf/detail/CallbackScope.h>
 
 #include <boost/core/noncopyable.hpp>
 
@@ -91,6 +93,25 @@ public:
      */
     bool isActive() const noexcept;
 
+    /**
+     * @brief Set the priority of the I/O watch task.
+     *
+     * By default, the task runs as soon as an event occurs, ahead of the tasks waiting in the
+     * lanes of the executor. With a lower priority, the watch posts its task to the lane of
+     * that priority instead, see @nfrefmethod{Executor,post(Priority,Task&&)}. Meanwhile, the
+     * watch is still active and can be stopped.
+     *
+     * @since 5.7
+     */
+    void setPriority(Executor::Priority priority) noexcept;
+
+    /**
+     * @brief Get the priority of the I/O watch task.
+     *
+     * @since 5.7
+     */
+    Executor::Priority priority() const noexcept;
+
     /**
      * @brief Start an I/O watch.
      *
@@ -106,7 +127,7 @@ public:
     void stop() noexcept;
 
 protected:
-    IoWatch(int fd, std::int16_t events, Task &&task) noexcept;
+    IoWatch(Executor &executor, int fd, std::int16_t events, Task &&task) noexcept;
     bool isReadWatch() const noexcept;
     bool isWriteWatch() const noexcept;
     void startWatch() noexcept;
@@ -116,6 +137,7 @@ protected:
 private:
     virtual void onStarted() noexcept = 0;
     virtual void onStopped() noexcept = 0;
+    void dispatch() noexcept;
 
 protected:
     Task m_task;
@@ -123,7 +145,11 @@ protected:
     std::int16_t m_events;
 
 private:
+    Executor &m_executor;
     bool m_isActive;
+    Executor::Priority m_priority{Executor::Priority::High};
+    /* Guards the task posted to a lane of the executor. */
+    detail::CallbackScope m_laneScope;
 };
 
 NF_END_NAMESPACE
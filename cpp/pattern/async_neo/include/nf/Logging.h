@@ -17,6 +17,7 @@
 #include <boost/noncopyable.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <optional>
@@ -124,17 +125,17 @@
 #define NF_LOG_USE_CONTEXT(name)                                                                   \
     static const ::nf::LogContext &ActiveLogContext = NF_LOG_GET_CONTEXT(name);                    \
     [[maybe_unused]] constexpr auto fatal =                                                        \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Fatal);               \
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Fatal>(impl_NF_LOG_ACTIVECTX);               \
     [[maybe_unused]] constexpr auto error =                                                        \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Error);               \
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Error>(impl_NF_LOG_ACTIVECTX);               \
     [[maybe_unused]] constexpr auto warn =                                                         \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Warn);                \
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Warn>(impl_NF_LOG_ACTIVECTX);                \
     [[maybe_unused]] constexpr auto info =                                                         \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Info);                \
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Info>(impl_NF_LOG_ACTIVECTX);                \
     [[maybe_unused]] constexpr auto debug =                                                        \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Debug);               \
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Debug>(impl_NF_LOG_ACTIVECTX);               \
     [[maybe_unused]] constexpr auto verbose =                                                      \
-        ::nf::detail::makeLogFunction(impl_NF_LOG_ACTIVECTX, ::nf::LogLevel::Verbose)
+        ::nf::detail::makeLogFunction<::nf::LogLevel::Verbose>(impl_NF_LOG_ACTIVECTX)
 
 /**
  * @hideinitializer
@@ -193,7 +194,8 @@ temporary to accommodate a migration from NF4 to NF5 and will be removed at some
     do {                                                                                           \
         const auto &_nf_ctx = ctx;                                                                 \
         const auto &_nf_level = level;                                                             \
-        if (::nf::Logging::isEnabled(_nf_ctx, _nf_level)) {                                        \
+        if (::nf::detail::isCompiledIn(_nf_level)                                                  \
+            && ::nf::Logging::isEnabled(_nf_ctx, _nf_level)) {                                     \
             std::ostringstream _nf_os;                                                             \
             _nf_os << msg;                                                                         \
             ::nf::Logging::write(_nf_ctx, _nf_level, _nf_os, nullptr, nullptr, 0);                 \
@@ -207,7 +209,8 @@ temporary to accommodate a migration from NF4 to NF5 and will be removed at some
     do {                                                                                           \
         const auto &_nf_ctx = ctx;                                                                 \
         const auto &_nf_level = level;                                                             \
-        if (::nf::Logging::isEnabled(_nf_ctx, _nf_level)) {                                        \
+        if (::nf::detail::isCompiledIn(_nf_level)                                                  \
+            && ::nf::Logging::isEnabled(_nf_ctx, _nf_level)) {                                     \
             std::ostringstream _nf_os;                                                             \
             _nf_os << msg;                                                                         \
             const char *_nf_filename = ::nf::detail::extractFilename(file);                        \
@@ -238,8 +241,30 @@ struct LogContext : boost::noncopyable
     const char *id;
     const char *desc;
     void *data;
+    /* The index of the most severe level which filters suppress for the whole context. Messages
+     * of this and less severe levels are dropped without being formatted. */
+    std::atomic<int> suppressedFrom;
 };
 
+namespace detail {
+
+#ifdef NF_LOG_MIN_LEVEL
+constexpr LogLevel kMinLogLevel = LogLevel::NF_LOG_MIN_LEVEL;
+#else
+constexpr LogLevel kMinLogLevel = LogLevel::Verbose;
+#endif
+
+/**
+ * @internal
+ * @brief Check if messages of the @p level are compiled in, see @ref NF_LOG_MIN_LEVEL.
+ */
+constexpr bool isCompiledIn(LogLevel level) noexcept
+{
+    return static_cast<int>(level) <= static_cast<int>(kMinLogLevel);
+}
+
+} // namespace detail
+
 /**
  * @ingroup nf_core_Logging
  * @brief Detailed log information.
@@ -378,6 +403,11 @@ public:
      */
     virtual bool isSuspended() const noexcept;
 
+    /*
+     * @brief Block until buffered log entries, if any, are written to output.
+     */
+    virtual void flush() noexcept;
+
     static const char *toString(LogLevel level) noexcept;
 };
 
@@ -505,7 +535,10 @@ public:
     }
 
     /**
-     * @todo Document method
+     * @brief Check if messages of the @p level in the @p context are not suppressed by filters.
+     *
+     * This is a cheap check which only considers filters applying to the whole context. A
+     * message for which it returns @c true can still be suppressed by a filter for its file.
      */
     static bool isEnabled(const LogContext &context, LogLevel level) noexcept;
 
@@ -555,6 +588,20 @@ public:
      */
     static void resumeOutput() noexcept;
 
+    /**
+     * @brief Write out log entries buffered by log backends.
+     *
+     * Blocks until log backends which buffer entries, like @ref backend::AsyncLogger, have
+     * written them to their output. Calling this method when the @c Logging is uninitialized
+     * has no effect.
+     *
+     * @warning This method is not thread-safe.
+     * Other threads may try to remove log backend that is being flushed.
+     *
+     * @since 5.7
+     */
+    static void flush() noexcept;
+
 private:
     static void remove(const std::type_info &backendType, std::size_t index) noexcept;
     static std::optional<std::shared_ptr<LogBackend>> backend(const std::type_info &backendType,
@@ -563,6 +610,11 @@ private:
 
 /// @}
 
+inline bool Logging::isEnabled(const LogContext &context, LogLevel level) noexcept
+{
+    return static_cast<int>(level) < context.suppressedFrom.load(std::memory_order_relaxed);
+}
+
 namespace detail {
 
 /**
@@ -610,12 +662,50 @@ struct FormatAndLocation
 void log(const LogContext &context, LogLevel level, fmt::string_view format, fmt::format_args args,
          const source_location &location) noexcept;
 
-constexpr auto makeLogFunction(const LogContext &(*context)(), LogLevel level) noexcept
+template <typename tFunction>
+constexpr bool kIsLazyMessage = std::is_invocable_v<tFunction &>;
+
+template <typename tFunction>
+void logLazy(const LogContext &context, LogLevel level, tFunction &message,
+             const source_location &location) noexcept
 {
-    return [context, level](FormatAndLocation fl, auto &&...args) noexcept {
-        detail::log(context(), level, fl.format,
-                    fmt::make_format_args(std::forward<decltype(args)>(args)...), fl.location);
-    };
+    if (isCompiledIn(level) && Logging::isEnabled(context, level)) {
+        const auto text = message();
+        detail::log(context, level, "{}", fmt::make_format_args(text), location);
+    }
+}
+
+/* The type of the logging functions defined by NF_LOG_USE_CONTEXT(). */
+template <LogLevel tLevel>
+struct LogFunction
+{
+    const LogContext &(*context)();
+
+    template <typename... tArgs>
+    void operator()(FormatAndLocation fl, tArgs &&...args) const noexcept
+    {
+        if constexpr (isCompiledIn(tLevel)) {
+            const auto &ctx = context();
+            if (Logging::isEnabled(ctx, tLevel)) {
+                detail::log(ctx, tLevel, fl.format, fmt::make_format_args(args...), fl.location);
+            }
+        }
+    }
+
+    template <typename tFunction, std::enable_if_t<kIsLazyMessage<tFunction>, int> = 0>
+    void operator()(tFunction &&message,
+                    const source_location &location = source_location::current()) const noexcept
+    {
+        if constexpr (isCompiledIn(tLevel)) {
+            logLazy(context(), tLevel, message, location);
+        }
+    }
+};
+
+template <LogLevel tLevel>
+constexpr auto makeLogFunction(const LogContext &(*context)()) noexcept
+{
+    return LogFunction<tLevel>{context};
 }
 
 } // namespace detail
@@ -636,43 +726,131 @@ using FormatString = detail::FormatAndLocation;
 template <typename... tArgs>
 void log(const LogContext &context, LogLevel level, FormatString format, tArgs &&...args) noexcept
 {
-    detail::log(context, level, format.format, fmt::make_format_args(args...), format.location);
+    if (detail::isCompiledIn(level) && Logging::isEnabled(context, level)) {
+        detail::log(context, level, format.format, fmt::make_format_args(args...), format.location);
+    }
+}
+
+/**
+ * @ingroup nf_core_Logging
+ * @brief Log a message produced by @p message using a custom log context and level.
+ *
+ * The @p message function is called and its result is formatted only if the message is not
+ * suppressed, see @ref nf_log_Disabled. It must not throw.
+ *
+ * @code
+ * nf::log(context, nf::LogLevel::Debug, [&] { return fmt::format("State: {}", dumpState()); });
+ * @endcode
+ *
+ * @since 5.7
+ */
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void log(const LogContext &context, LogLevel level, tFunction &&message,
+         const source_location &location = source_location::current()) noexcept
+{
+    detail::logLazy(context, level, message, location);
 }
 
 template <typename... tArgs>
 void fatal(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Fatal, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Fatal)) {
+        log(context, LogLevel::Fatal, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void fatal(const LogContext &context, tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Fatal)) {
+        detail::logLazy(context, LogLevel::Fatal, message, location);
+    }
 }
 
 template <typename... tArgs>
 void error(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Error, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Error)) {
+        log(context, LogLevel::Error, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void error(const LogContext &context, tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Error)) {
+        detail::logLazy(context, LogLevel::Error, message, location);
+    }
 }
 
 template <typename... tArgs>
 void warn(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Warn, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Warn)) {
+        log(context, LogLevel::Warn, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void warn(const LogContext &context, tFunction &&message,
+          const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Warn)) {
+        detail::logLazy(context, LogLevel::Warn, message, location);
+    }
 }
 
 template <typename... tArgs>
 void info(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Info, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Info)) {
+        log(context, LogLevel::Info, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void info(const LogContext &context, tFunction &&message,
+          const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Info)) {
+        detail::logLazy(context, LogLevel::Info, message, location);
+    }
 }
 
 template <typename... tArgs>
 void debug(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Debug, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Debug)) {
+        log(context, LogLevel::Debug, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void debug(const LogContext &context, tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Debug)) {
+        detail::logLazy(context, LogLevel::Debug, message, location);
+    }
 }
 
 template <typename... tArgs>
 void verbose(const LogContext &context, FormatString format, tArgs &&...args) noexcept
 {
-    log(context, LogLevel::Verbose, format, std::forward<tArgs>(args)...);
+    if constexpr (detail::isCompiledIn(LogLevel::Verbose)) {
+        log(context, LogLevel::Verbose, format, std::forward<tArgs>(args)...);
+    }
+}
+
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void verbose(const LogContext &context, tFunction &&message,
+             const source_location &location = source_location::current()) noexcept
+{
+    if constexpr (detail::isCompiledIn(LogLevel::Verbose)) {
+        detail::logLazy(context, LogLevel::Verbose, message, location);
+    }
 }
 
 NF_END_NAMESPACE
@@ -693,36 +871,78 @@ void fatal(FormatString format, tArgs &&...args) noexcept
     fatal(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void fatal(tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    fatal(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 template <typename... tArgs>
 void error(FormatString format, tArgs &&...args) noexcept
 {
     error(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void error(tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    error(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 template <typename... tArgs>
 void warn(FormatString format, tArgs &&...args) noexcept
 {
     warn(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void warn(tFunction &&message,
+          const source_location &location = source_location::current()) noexcept
+{
+    warn(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 template <typename... tArgs>
 void info(FormatString format, tArgs &&...args) noexcept
 {
     info(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void info(tFunction &&message,
+          const source_location &location = source_location::current()) noexcept
+{
+    info(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 template <typename... tArgs>
 void debug(FormatString format, tArgs &&...args) noexcept
 {
     debug(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void debug(tFunction &&message,
+           const source_location &location = source_location::current()) noexcept
+{
+    debug(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 template <typename... tArgs>
 void verbose(FormatString format, tArgs &&...args) noexcept
 {
     verbose(ActiveLogContext, format, std::forward<tArgs>(args)...);
 }
 
+template <typename tFunction, std::enable_if_t<detail::kIsLazyMessage<tFunction>, int> = 0>
+void verbose(tFunction &&message,
+             const source_location &location = source_location::current()) noexcept
+{
+    verbose(ActiveLogContext, std::forward<tFunction>(message), location);
+}
+
 NF_END_NAMESPACE
 
 #endif
@@ -10,17 +10,18 @@
 
 #pragma once
 
-#include <nf/Context.h>
 #include <nf/RaiiToken.h>
 
+#include <boost/core/noncopyable.hpp>
+
 #include <functional>
-#include <list>
-#include <mutex>
+#include <optional>
+#include <ostream>
 
 NF_BEGIN_NAMESPACE
 
 namespace detail {
-struct RwLockWaiter;
+class RwLockState;
 } // namespace detail
 
 /**
@@ -31,13 +32,28 @@ struct RwLockWaiter;
  * allows to have multiple readers at the same time, while a writer requires an exclusive
  * access.
  *
+ * @ref lockRead() and @ref lockWrite() always invoke their callbacks asynchronously. Where
+ * the lock is mostly free, e.g. for frequently read data, @ref tryLockRead() and
+ * @ref tryLockWrite() acquire it immediately, without allocating and without a round trip
+ * through the event loop:
+ *
+ * @code
+ * if (auto token = lock.tryLockRead()) {
+ *     readConfig();
+ * } else {
+ *     m_token = lock.lockRead([this] { readConfig(); });
+ * }
+ * @endcode
+ *
+ * When a write-lock is released, all waiting readers acquire the lock together.
+ *
  * @par Thread-safety
  *
  * All methods are thread-safe.
  *
  * @since 3.21, 4.1
  */
-class RwLock
+class RwLock : private boost::noncopyable
 {
 public:
     using OnLockAcquired = std::function<void()>;
@@ -82,23 +98,33 @@ public:
      */
     [[nodiscard]] RaiiToken lockWrite(OnLockAcquired cb) noexcept;
 
-private:
-    using Waiter = detail::RwLockWaiter;
-    using Waiters = std::list<std::shared_ptr<Waiter>>;
+    /**
+     * @brief Try to acquire a read-lock immediately.
+     *
+     * If there is no write-lock acquired, this function acquires a read-lock and returns the
+     * RAII token holding it. Otherwise it returns @c std::nullopt. It never blocks.
+     *
+     * @since 5.7
+     */
+    [[nodiscard]] std::optional<RaiiToken> tryLockRead() noexcept;
+
+    /**
+     * @brief Try to acquire a write-lock immediately.
+     *
+     * If there is no other write-lock or read-lock acquired, this function acquires a write-lock
+     * and returns the RAII token holding it. Otherwise it returns @c std::nullopt. It never
+     * blocks.
+     *
+     * @since 5.7
+     */
+    [[nodiscard]] std::optional<RaiiToken> tryLockWrite() noexcept;
 
 private:
     friend std::ostream &operator<<(std::ostream &os, const RwLock &rwLock) noexcept;
-    void wakeUp(Waiter &waiter) noexcept;
-    RaiiToken addLock(bool isReader, OnLockAcquired &cb) noexcept;
-    void removeLock(Waiters::iterator it) noexcept;
-    void wakeUpNext() noexcept;
 
 private:
-    Context m_context;
-    std::mutex m_mutex;
-    Waiters m_waiters;
-    int m_cntReaders{0};
-    bool m_hasWriter{false};
+    /* Shared with the tokens, so that they can outlive the lock. */
+    detail::RwLockState *m_state;
 };
 
 NF_END_NAMESPACE
@@ -0,0 +1,238 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/ByteArray.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+NF_BEGIN_NAMESPACE
+
+/**
+ * @ingroup nf_core_Types
+ * @brief Immutable, reference-counted bytes which can be sliced and shared without copying.
+ *
+ * A @ref ByteArray owns its bytes, so copying it or taking a sub-array with
+ * @ref ByteArray::mid() copies the payload. This becomes expensive for big payloads, e.g. camera
+ * frames passed through signals to several contexts. @c SharedBytes takes the storage over from
+ * a @ref ByteArray and never modifies it afterwards: copies share the same storage, and slices
+ * refer to a range of it. Both are O(1) and do not allocate.
+ *
+ * The storage is freed when the last @c SharedBytes referring to it is destroyed. Since the
+ * bytes are never modified, @c SharedBytes can be passed to other threads freely.
+ *
+ * @note A small slice keeps the whole storage alive. Use @ref SharedBytes::toByteArray() to
+ * copy it out if it has to outlive a big payload.
+ *
+ * @code
+ * nf::ByteArray frame = camera.grab();
+ * auto shared = nf::SharedBytes{std::move(frame)}; // no copy of the payload
+ *
+ * frameReceived.notify(shared);                     // listeners share the same storage
+ *
+ * auto header = shared.first(kHeaderSize);          // no copy either
+ * auto payload = shared.mid(kHeaderSize);
+ * @endcode
+ *
+ * @since 5.7
+ */
+class SharedBytes
+{
+public:
+    using ConstIterator = const std::byte *;
+    // Needed for STL compatibility
+    using const_iterator = ConstIterator;
+    using value_type = std::byte;
+
+public:
+    SharedBytes() noexcept = default;
+
+    /**
+     * @brief Take over the storage of @p bytes.
+     *
+     * The payload is not copied, only its storage is moved over.
+     *
+     * @param bytes Bytes to share.
+     */
+    explicit SharedBytes(ByteArray &&bytes);
+
+    /**
+     * @brief Copy @p bytes into a new shared storage.
+     *
+     * @param bytes Bytes to share.
+     */
+    explicit SharedBytes(const ByteArray &bytes);
+
+    /**
+     * @brief Copy the bytes into a new @ref ByteArray which can be modified.
+     */
+    [[nodiscard]] ByteArray toByteArray() const;
+
+    /**
+     * @brief Return a read-only pointer to the bytes.
+     */
+    [[nodiscard]] const std::byte *data() const noexcept;
+
+    /**
+     * @brief Return an iterator that points to the begin of the bytes.
+     */
+    [[nodiscard]] ConstIterator begin() const noexcept;
+
+    /**
+     * @brief Return an iterator that points to the end of the bytes.
+     */
+    [[nodiscard]] ConstIterator end() const noexcept;
+
+    /**
+     * @brief Same as @ref SharedBytes::begin().
+     */
+    [[nodiscard]] ConstIterator cbegin() const noexcept;
+
+    /**
+     * @brief Same as @ref SharedBytes::end().
+     */
+    [[nodiscard]] ConstIterator cend() const noexcept;
+
+    /**
+     * @brief Get the number of bytes.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Check if there are no bytes.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    /**
+     * @brief Return the value of the byte in the position @c index.
+     *
+     * If <code> index >= size() </code>, the behavior is undefined.
+     */
+    [[nodiscard]] std::byte operator[](std::size_t index) const noexcept;
+
+    /**
+     * @brief Return the byte in the position @c index.
+     *
+     * @exception std::out_of_range if <code> index >= size() </code>.
+     */
+    [[nodiscard]] std::byte at(std::size_t index) const noexcept(false);
+
+    /**
+     * @brief Get a slice from the @c index till the end.
+     *
+     * The slice shares the storage with this object.
+     *
+     * @exception std::out_of_range if <code> index > size() </code>.
+     * @sa @ref ByteArray::mid(std::size_t)
+     */
+    [[nodiscard]] SharedBytes mid(std::size_t index) const noexcept(false);
+
+    /**
+     * @brief Get a slice from the @c index and with up to @c length bytes.
+     *
+     * The slice shares the storage with this object.
+     *
+     * @exception std::out_of_range if <code> index > size() </code>.
+     * @sa @ref ByteArray::mid(std::size_t, std::size_t)
+     */
+    [[nodiscard]] SharedBytes mid(std::size_t index, std::size_t length) const noexcept(false);
+
+    /**
+     * @brief Get a slice with up to @c count bytes from the beginning.
+     *
+     * The slice shares the storage with this object.
+     */
+    [[nodiscard]] SharedBytes first(std::size_t count) const noexcept;
+
+    /**
+     * @brief Get a slice with up to @c count bytes from the end.
+     *
+     * The slice shares the storage with this object.
+     */
+    [[nodiscard]] SharedBytes last(std::size_t count) const noexcept;
+
+    /**
+     * @brief Test if the bytes start with @c other.
+     */
+    [[nodiscard]] bool startsWith(const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Test if the bytes end with @c other.
+     */
+    [[nodiscard]] bool endsWith(const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Test if the bytes entirely contain @c other.
+     */
+    [[nodiscard]] bool contains(const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Test if the bytes starting from the @c index fully match @c other.
+     *
+     * @return @c false if they do not match or if the @c index is out of range.
+     */
+    [[nodiscard]] bool matches(std::size_t index, const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Check if two objects have equal content.
+     */
+    [[nodiscard]] bool operator==(const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Check if two objects have different content.
+     */
+    [[nodiscard]] bool operator!=(const SharedBytes &other) const noexcept;
+
+    /**
+     * @brief Cast bytes starting from the @c position into a value of type @c tIntegral.
+     *
+     * @sa @ref ByteArray::reinterpret()
+     */
+    template <typename tIntegral>
+    [[nodiscard]] std::optional<tIntegral> reinterpret(std::size_t position) const noexcept;
+
+private:
+    using View = std::basic_string_view<std::byte>;
+
+    SharedBytes(std::shared_ptr<const ByteArray::Container> storage, View view) noexcept;
+
+    [[nodiscard]] View view() const noexcept;
+
+private:
+    std::shared_ptr<const ByteArray::Container> m_storage;
+    const std::byte *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+template <typename tIntegral>
+std::optional<tIntegral> SharedBytes::reinterpret(std::size_t position) const noexcept
+{
+    static_assert(std::is_integral_v<tIntegral> || std::is_same_v<tIntegral, std::byte>,
+                  "Expected integral type or std::byte");
+    // Regarding https://gcc.gnu.org/bugzilla/show_bug.cgi?id=80635
+    if (position + sizeof(tIntegral) > m_size) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+        return {};
+#pragma GCC diagnostic pop
+    }
+
+    auto value = tIntegral{};
+    std::memcpy(&value, m_data + position, sizeof(value));
+    return value;
+}
+
+NF_END_NAMESPACE
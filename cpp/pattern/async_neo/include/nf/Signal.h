@@ -16,12 +16,27 @@
 #include <nf/Assert.h>
 #include <nf/Subscription.h>
 
+#include <algorithm>
 #include <type_traits>
+#include <vector>
 
 NF_BEGIN_NAMESPACE
 
 class Context;
 
+/**
+ * @ingroup nf_core_Signals
+ * @brief How a signal delivers notifications to asynchronous and contextual listeners.
+ *
+ * @see @ref nf_sig_Delivery
+ * @since 5.7
+ */
+enum class SignalDelivery
+{
+    PerListener, ///< Each listener is invoked by its own task with its own copy of the arguments.
+    Coalesced    ///< Listeners sharing an executor are invoked by one task with shared arguments.
+};
+
 /**
  * @ingroup nf_core_Signals
  * @brief The signal.
@@ -37,6 +52,17 @@ template <typename... tArgs>
 class Signal : public detail::SignalNtBase
 {
 public:
+    Signal() noexcept = default;
+
+    /**
+     * @brief Construct a signal which delivers notifications as specified by @p delivery.
+     * @since 5.7
+     */
+    explicit Signal(SignalDelivery delivery) noexcept
+        : m_delivery(delivery)
+    {
+    }
+
     /**
      * @brief Subscribe to the signal (synchronous).
      * @param f Function to be called when the signal is emitted.
@@ -93,26 +119,133 @@ public:
         bind(context, std::make_shared<Listener>(std::forward<tFunc>(f)));
     }
 
+    /**
+     * @brief Subscribe to the signal, receiving only the latest notification (asynchronous).
+     *
+     * Like @ref subscribe(const std::shared_ptr<Executor>&, tFunc&&) const "subscribe()", but at
+     * most one notification is pending for @p f. A newer one replaces it.
+     *
+     * @param executor Executor to post @p f to.
+     * @param f Function to be invoked through the executor with the latest arguments.
+     * @returns Subscription RAII token.
+     * @see @ref nf_sig_Conflated
+     * @since 5.7
+     */
+    template <typename tFunc>
+    [[nodiscard]] Subscription subscribeConflated(const std::shared_ptr<Executor> &executor,
+                                                  tFunc &&f) const noexcept
+    {
+        static_assert(std::is_invocable_v<tFunc, tArgs...>,
+                      "Provided callable is not compatible with signal arguments");
+
+        assertThat(executor != nullptr, "Executor must not be null");
+
+        using Listener = detail::ConflatingListener<tFunc, tArgs...>;
+        return bind(
+            std::make_shared<Listener>(executor, std::forward<tFunc>(f), conflatedCounter()));
+    }
+
+    /**
+     * @brief Subscribe to the signal, receiving only the latest notification (with context).
+     *
+     * Like @ref subscribe(const Context&, tFunc&&) const "subscribe()", but at most one
+     * notification is pending for @p f. A newer one replaces it.
+     *
+     * @param context Context to bind the subscription to.
+     * @param f Function to be invoked through the context's executor with the latest arguments.
+     * @see @ref nf_sig_Conflated
+     * @since 5.7
+     */
+    template <typename tFunc>
+    void subscribeConflated(const Context &context, tFunc &&f) const noexcept
+    {
+        static_assert(std::is_invocable_v<tFunc, tArgs...>,
+                      "Provided callable is not compatible with signal arguments");
+
+        using Listener = detail::ConflatingListener<tFunc, tArgs...>;
+        bind(context, std::make_shared<Listener>(std::forward<tFunc>(f), conflatedCounter()));
+    }
+
+    /**
+     * @brief Get the number of notifications which conflated subscriptions skipped.
+     *
+     * A notification is skipped if it is replaced by a newer one before the listener runs.
+     *
+     * @see @ref nf_sig_Conflated
+     * @since 5.7
+     */
+    std::uint64_t conflatedCount() const noexcept
+    {
+        return loadConflatedCount();
+    }
+
     /**
      * @brief Notify the signal.
      *
-     * Notifies the listeners subscribed to the signal with the given arguments.
+     * Notifies the listeners subscribed to the signal with the given arguments. Asynchronous and
+     * contextual listeners are posted as specified by the signal's @ref SignalDelivery.
      *
      * @param args Arguments for notification.
      */
     void notify(const tArgs &...args) const noexcept
     {
-        /* Notify on a copy of listeners because the list can be modified in process. */
-        std::unique_lock lock(m_mutex);
-        auto listeners = this->m_listeners;
-        lock.unlock();
-
-        for (const auto &wListener : listeners) {
-            if (auto listener = wListener.lock()) {
-                std::static_pointer_cast<detail::ListenerBase<tArgs...>>(listener)->invoke(args...);
+        if (m_delivery == SignalDelivery::Coalesced) {
+            notifyCoalesced(args...);
+            return;
+        }
+
+        forEachListener([&args...](detail::ListenerNtBase &listener) {
+            static_cast<detail::ListenerBase<tArgs...> &>(listener).invoke(args...);
+        });
+    }
+
+private:
+    using Listener = detail::ListenerBase<tArgs...>;
+
+    struct Batch
+    {
+        std::shared_ptr<Executor> executor;
+        std::vector<std::weak_ptr<ContextItem>> listeners;
+    };
+
+    void notifyCoalesced(const tArgs &...args) const noexcept
+    {
+        std::vector<Batch> batches;
+        forEachListener([&](detail::ListenerNtBase &listenerNt) {
+            auto &listener = static_cast<Listener &>(listenerNt);
+            auto executor = listener.sharedExecutor();
+            if (!executor) {
+                listener.invoke(args...);
+                return;
+            }
+
+            auto it = std::find_if(batches.begin(), batches.end(), [&executor](const Batch &b) {
+                return b.executor == executor;
+            });
+            if (it == batches.end()) {
+                it = batches.insert(batches.end(), Batch{std::move(executor), {}});
             }
+            it->listeners.push_back(listener.weak_from_this());
+        });
+
+        if (batches.empty()) {
+            return;
+        }
+
+        auto arguments = std::make_shared<const typename Listener::Arguments>(args...);
+        for (auto &batch : batches) {
+            batch.executor->post([arguments, listeners = std::move(batch.listeners)] {
+                for (const auto &wListener : listeners) {
+                    if (auto listener = wListener.lock()) {
+                        static_cast<Listener &>(*listener).invokeShared(*arguments);
+                    }
+                }
+            });
         }
     }
+
+private:
+    const SignalDelivery m_delivery = SignalDelivery::PerListener;
 };
 
 NF_END_NAMESPACE
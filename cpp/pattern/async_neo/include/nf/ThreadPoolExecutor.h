@@ -0,0 +1,153 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NF_BEGIN_NAMESPACE
+
+/**
+ * @ingroup nf_core_Executors
+ * @brief An executor running tasks on a pool of threads.
+ *
+ * @code
+ * #include <nf/ThreadPoolExecutor.h>
+ * @endcode
+ *
+ * The pool starts its worker threads when it is created and runs tasks until it is stopped or
+ * destroyed. Tasks run concurrently and in no particular order. Each worker keeps the tasks it
+ * posts itself in its own lock-free deque, and idle workers steal tasks from the others. Tasks
+ * posted from other threads are shared by all workers.
+ *
+ * The pool can be used wherever an executor is expected, e.g. to bind a @ref Context to it or
+ * with @ref nf::async::execute(). Code written for a single-threaded executor usually assumes
+ * that tasks of a context never run concurrently. Use a @ref makeStrand() "strand" to keep this
+ * assumption:
+ *
+ * @code
+ * auto pool = nf::ThreadPoolExecutor::create(4);
+ * nf::Context parallel(pool);                 // tasks run concurrently
+ * nf::Context serialized(pool->makeStrand()); // tasks run one after another, in order
+ * @endcode
+ *
+ * The pool has no event loop of its own. Timers, I/O watches, Linux signal handlers and delayed
+ * tasks are handled by the @e reactor executor given to @ref create(). The tasks of timers and
+ * I/O watches run in the reactor's thread, whereas delayed tasks run in the pool.
+ *
+ * @ref run() only waits until the pool is @ref stop() "stopped" and rethrows exceptions of
+ * tasks there, see @ref nf_core_ExecutionFlow. While nobody runs the pool, exceptions of tasks
+ * are logged and dropped. A stopped pool cannot be restarted.
+ *
+ * @note @ref Executor::thisThread() in a task of the pool does @b not return the pool. Post to
+ *       the pool or to a context bound to it explicitly.
+ *
+ * @since 5.7
+ */
+class ThreadPoolExecutor final : public Executor,
+                                 public std::enable_shared_from_this<ThreadPoolExecutor>
+{
+public:
+    /**
+     * @brief Create a pool and start its worker threads.
+     *
+     * @param threadCount Number of worker threads. Zero means one per CPU.
+     * @param reactor Executor for timers, I/O watches, signal handlers and delayed tasks.
+     */
+    static std::shared_ptr<ThreadPoolExecutor>
+    create(std::size_t threadCount = 0,
+           const std::shared_ptr<Executor> &reactor = Executor::thisThread()) noexcept;
+
+    /**
+     * @brief Stop the pool and join its worker threads.
+     *
+     * The tasks which have not been run are discarded.
+     */
+    ~ThreadPoolExecutor() override;
+
+public:
+    using Executor::post;
+    void post(Task &&task) noexcept override;
+    void postBatch(std::vector<Task> &&tasks) noexcept override;
+    std::unique_ptr<Timer> makeTimer(Interval interval, TimerTask &&task) noexcept override;
+    std::unique_ptr<IoWatch> makeIoWatch(int fd, std::int16_t events,
+                                         IoWatchTask &&task) noexcept override;
+    bool setSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override;
+    bool appendSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override;
+    void stop() noexcept override;
+    void stop(int exitCode) noexcept override;
+    std::chrono::milliseconds now() const noexcept override;
+
+    /**
+     * @brief Make a strand of this pool.
+     *
+     * A strand is an executor which runs its tasks in the pool, but one after another and in
+     * the order they were posted, like a single-threaded executor does. Consecutive tasks may
+     * run in different threads. Timers and I/O watches of a strand are those of the pool.
+     *
+     * Bind a @ref Context to a strand to serialize the execution of its tasks.
+     */
+    std::shared_ptr<Executor> makeStrand() noexcept;
+
+    /**
+     * @brief Get the number of worker threads.
+     */
+    std::size_t threadCount() const noexcept;
+
+private:
+    struct Worker;
+
+    ThreadPoolExecutor(std::size_t threadCount, const std::shared_ptr<Executor> &reactor) noexcept;
+
+    int runImpl() override;
+    void postImpl(Delay delay, Task &&task) noexcept override;
+    void discardAllPostedEvents() noexcept override;
+
+    void work(Worker &worker) noexcept;
+    Task *findTask(Worker &worker) noexcept;
+    Task *takeInjected(Worker &worker) noexcept;
+    bool hasTasks() const noexcept;
+    void wakeUp(std::size_t count) noexcept;
+    void discardTasks() noexcept;
+
+private:
+    const std::shared_ptr<Executor> m_reactor;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    /* Tasks posted by other threads. */
+    mutable std::mutex m_injectedMutex;
+    std::deque<Task *> m_injected;
+    std::atomic<std::size_t> m_injectedCount{0};
+
+    /* Idle workers wait here. */
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+    std::atomic<int> m_idleCount{0};
+    std::atomic<bool> m_isStopping{false};
+
+    /* run() waits here for the pool to stop or for exceptions of tasks. */
+    std::mutex m_runMutex;
+    std::condition_variable m_runCv;
+    bool m_isRunning{false};
+    int m_exitCode{EXIT_SUCCESS};
+    std::vector<std::exception_ptr> m_exceptions;
+};
+
+NF_END_NAMESPACE
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <nf/Executor.h>
 #include <nf/Function.h>
 
 #include <boost/core/noncopyable.hpp>
@@ -126,6 +127,25 @@ public:
      */
     void setTask(Task &&task) noexcept;
 
+    /**
+     * @brief Set the priority of the timer task.
+     *
+     * By default, the task runs as soon as the timer expires, ahead of the tasks waiting in
+     * the lanes of the executor. With a lower priority, an expired timer posts its task to
+     * the lane of that priority instead, see @nfrefmethod{Executor,post(Priority,Task&&)}.
+     * Meanwhile, the timer is still running and can be stopped. Use it for periodic bulk work.
+     *
+     * @since 5.7
+     */
+    void setPriority(Executor::Priority priority) noexcept;
+
+    /**
+     * @brief Get the priority of the timer task.
+     *
+     * @since 5.7
+     */
+    Executor::Priority priority() const noexcept;
+
     /**
      * @brief Check if the timer is running.
      */
@@ -203,6 +223,7 @@ protected:
     Task m_task;
     Interval m_interval;
     State m_state;
+    Executor::Priority m_priority{Executor::Priority::High};
 };
 
 NF_END_NAMESPACE
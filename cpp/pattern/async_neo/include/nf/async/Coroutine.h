@@ -0,0 +1,454 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Context.h>
+#include <nf/ContextItem.h>
+#include <nf/Future.h>
+#include <nf/Promise.h>
+#include <nf/detail/AsyncSharedState.h>
+
+/* Coroutines are available only if the user of the framework is built as C++20. */
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define NF_HAS_COROUTINES 1
+
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <variant>
+
+NF_BEGIN_NAMESPACE
+
+namespace async {
+
+template <typename tValue>
+class Task;
+
+} // namespace async
+
+namespace detail {
+
+/*
+ * Owns the frame of a coroutine on behalf of its context, so that resetting the context destroys
+ * the frame of a suspended coroutine. A coroutine which is running at that moment cannot be
+ * destroyed from outside, it destroys itself at its next suspension point instead.
+ */
+class CoroutineItem final : public ContextItem
+{
+public:
+    CoroutineItem(std::coroutine_handle<> handle, CoroutineItem *&backRef) noexcept
+        : m_handle{handle}
+        , m_backRef{&backRef}
+    {
+        backRef = this;
+    }
+
+    ~CoroutineItem() override
+    {
+        *m_backRef = nullptr;
+        if (!m_isRunning) {
+            m_handle.destroy();
+        }
+    }
+
+    void suspend() noexcept
+    {
+        m_isRunning = false;
+    }
+
+    void resume() noexcept
+    {
+        /* The post() holds this item, so the frame stays alive while the coroutine runs. */
+        post([this] {
+            m_isRunning = true;
+            m_handle.resume();
+        });
+    }
+
+    void cancel() noexcept
+    {
+        /* The item must not be destroyed while the context's lock is held by decontextualize(). */
+        auto self = shared_from_this();
+        decontextualize();
+    }
+
+private:
+    std::coroutine_handle<> m_handle;
+    CoroutineItem **m_backRef;
+    bool m_isRunning = true;
+};
+
+class TaskPromiseBase
+{
+public:
+    template <typename... tArgs>
+    explicit TaskPromiseBase(const Context &context, const tArgs &...) noexcept
+        : m_context{context}
+    {
+    }
+
+    template <typename tClass, typename... tArgs>
+    requires(!std::is_convertible_v<const tClass &, const Context &>)
+    TaskPromiseBase(const tClass &, const Context &context, const tArgs &...) noexcept
+        : m_context{context}
+    {
+    }
+
+    TaskPromiseBase(const TaskPromiseBase &) = delete;
+    TaskPromiseBase &operator=(const TaskPromiseBase &) = delete;
+
+    auto initial_suspend() noexcept
+    {
+        /* Start right away on the context's thread, otherwise go through its executor. */
+        struct StartAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return promise.m_context.isThisThread();
+            }
+
+            void await_suspend(std::coroutine_handle<>) const noexcept
+            {
+                promise.m_item->suspend();
+                promise.m_item->resume();
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            TaskPromiseBase &promise;
+        };
+
+        return StartAwaiter{*this};
+    }
+
+    auto final_suspend() noexcept
+    {
+        /* A coroutine whose context is gone frees its own frame, otherwise the item does it. */
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return promise.m_item == nullptr;
+            }
+
+            void await_suspend(std::coroutine_handle<>) const noexcept
+            {
+                promise.m_item->suspend();
+                promise.m_item->cancel();
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            TaskPromiseBase &promise;
+        };
+
+        return FinalAwaiter{*this};
+    }
+
+    void unhandled_exception()
+    {
+        /* The exception goes to the executor just like one thrown by a task. The coroutine is
+         * left at its final suspension point, and the frame is freed with the context. */
+        if (m_item) {
+            m_item->suspend();
+        }
+        throw;
+    }
+
+    CoroutineItem *item() const noexcept
+    {
+        return m_item;
+    }
+
+protected:
+    void start(std::coroutine_handle<> handle) noexcept
+    {
+        detail::bind(m_context, std::make_shared<CoroutineItem>(handle, m_item));
+    }
+
+private:
+    const Context &m_context; // This is safe, because it is only used before the first suspension
+    CoroutineItem *m_item = nullptr;
+};
+
+template <typename tValue>
+class TaskPromise final : public TaskPromiseBase
+{
+public:
+    using TaskPromiseBase::TaskPromiseBase;
+
+    async::Task<tValue> get_return_object() noexcept
+    {
+        start(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        return async::Task<tValue>{m_promise.future()};
+    }
+
+    void return_value(tValue value)
+    {
+        m_promise.fulfill(std::move(value));
+    }
+
+private:
+    Promise<tValue> m_promise;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase
+{
+public:
+    using TaskPromiseBase::TaskPromiseBase;
+
+    async::Task<void> get_return_object() noexcept;
+
+    void return_void()
+    {
+        m_promise.fulfill();
+    }
+
+private:
+    Promise<void> m_promise;
+};
+
+/*
+ * The awaiter lives in the coroutine frame and is the receiver of the awaited state, so awaiting
+ * a future does not allocate. The state only refers to it weakly through the item which owns the
+ * frame, thus a destroyed frame is never touched.
+ */
+template <typename tValue, typename tStorage>
+class FutureAwaiter final : public AsyncReceiver<tStorage>
+{
+public:
+    explicit FutureAwaiter(const FutureBase<tValue, tStorage> &future) noexcept
+        : m_state{future.m_state}
+    {
+    }
+
+    /* A temporary future lives in the frame until the coroutine is resumed, so its state is
+     * taken over to let a broken promise free it. */
+    explicit FutureAwaiter(FutureBase<tValue, tStorage> &&future) noexcept
+        : m_state{std::move(future.m_state)}
+    {
+    }
+
+    bool await_ready() noexcept
+    {
+        m_value = m_state->take();
+        return m_value.has_value();
+    }
+
+    template <typename tPromise>
+    void await_suspend(std::coroutine_handle<tPromise> handle) noexcept
+    {
+        static_assert(std::is_base_of_v<TaskPromiseBase, tPromise>,
+                      "Futures can only be awaited by nf::async::Task coroutines");
+
+        m_item = handle.promise().item();
+        if (!m_item) {
+            /* The context is gone while the coroutine was running. */
+            handle.destroy();
+            return;
+        }
+
+        m_item->suspend();
+        /* The state is released, so that a broken promise destroys it and cancels the
+         * coroutine just like it frees a continuation. */
+        auto state = std::move(m_state);
+        state->setReceiver(
+            std::shared_ptr<AsyncReceiver<tStorage>>(m_item->shared_from_this(), this));
+    }
+
+    auto await_resume() noexcept
+    {
+        if constexpr (!std::is_same_v<tStorage, std::monostate>) {
+            return std::move(*m_value);
+        }
+    }
+
+private:
+    void accept(tStorage &&value) noexcept override
+    {
+        m_value.emplace(std::move(value));
+        m_item->resume();
+    }
+
+    void abandon() noexcept override
+    {
+        m_item->cancel();
+    }
+
+private:
+    std::shared_ptr<AsyncSharedState<tStorage>> m_state;
+    std::optional<tStorage> m_value;
+    CoroutineItem *m_item = nullptr;
+};
+
+template <typename tValue, typename tStorage>
+auto makeAwaiter(const FutureBase<tValue, tStorage> &future) noexcept
+{
+    return FutureAwaiter<tValue, tStorage>{future};
+}
+
+template <typename tValue, typename tStorage>
+auto makeAwaiter(FutureBase<tValue, tStorage> &&future) noexcept
+{
+    return FutureAwaiter<tValue, tStorage>{std::move(future)};
+}
+
+} // namespace detail
+
+namespace async {
+
+/**
+ * @addtogroup nf_core_Async
+ * @{
+ */
+
+/**
+ * @brief Return type of a coroutine which runs in a @ref Context.
+ *
+ * A coroutine returning @c Task must take a @ref Context as its first parameter (the first
+ * parameter after the object for a member function). The coroutine starts immediately if the
+ * context belongs to the current thread, otherwise it is posted to the executor of the context.
+ *
+ * The coroutine can @c co_await any @nfref{Future}. It is always resumed via the executor of its
+ * context, no matter which thread fulfills the promise. The coroutine is bound to its context:
+ * resetting the context destroys the suspended coroutine together with all its local variables.
+ * A coroutine waiting for a promise which gets destroyed without being fulfilled is destroyed
+ * as well.
+ *
+ * An exception escaping the coroutine is handled by the executor like one thrown by any task.
+ *
+ * @note Coroutines are available only if the code using them is built as C++20, in which case
+ * the @c NF_HAS_COROUTINES macro is defined.
+ *
+ * @par Example
+ *
+ * @code
+ * nf::async::Task<int> sum(const nf::Context &context, Storage &storage)
+ * {
+ *     auto a = co_await storage.read("a");   // read() returns nf::Future<int>
+ *     auto b = co_await storage.read("b");
+ *     co_return a + b;
+ * }
+ *
+ * sum(context, storage).future().then(context, [](int value) { nf::info("Sum: {}", value); });
+ * @endcode
+ *
+ * @tparam tValue Type of the value produced by the coroutine.
+ *
+ * @since 5.7
+ */
+template <typename tValue>
+class Task final
+{
+public:
+    using promise_type = detail::TaskPromise<tValue>;
+
+public:
+    /**
+     * @brief Get the future of the value produced by the coroutine.
+     */
+    Future<tValue> future() const & noexcept
+    {
+        return m_future;
+    }
+
+    /**
+     * @brief Get the future of the value produced by the coroutine.
+     */
+    Future<tValue> future() && noexcept
+    {
+        return std::move(m_future);
+    }
+
+private:
+    friend promise_type;
+
+    explicit Task(Future<tValue> future) noexcept
+        : m_future{std::move(future)}
+    {
+    }
+
+private:
+    Future<tValue> m_future;
+};
+
+/** @} */
+
+} // namespace async
+
+namespace detail {
+
+inline async::Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    start(std::coroutine_handle<TaskPromise>::from_promise(*this));
+    return async::Task<void>{m_promise.future()};
+}
+
+} // namespace detail
+
+/**
+ * @ingroup nf_core_Async
+ * @brief Await a future in an @nfref{async::Task} coroutine.
+ *
+ * @since 5.7
+ */
+template <typename tValue>
+auto operator co_await(const Future<tValue> &future) noexcept
+{
+    return detail::makeAwaiter(future);
+}
+
+/**
+ * @ingroup nf_core_Async
+ * @brief Await a temporary future in an @nfref{async::Task} coroutine.
+ *
+ * @since 5.7
+ */
+template <typename tValue>
+auto operator co_await(Future<tValue> &&future) noexcept
+{
+    return detail::makeAwaiter(std::move(future));
+}
+
+/**
+ * @ingroup nf_core_Async
+ * @brief Await the result of another @nfref{async::Task} coroutine.
+ *
+ * @since 5.7
+ */
+template <typename tValue>
+auto operator co_await(const async::Task<tValue> &task) noexcept
+{
+    return detail::makeAwaiter(task.future());
+}
+
+/**
+ * @ingroup nf_core_Async
+ * @brief Await the result of a temporary @nfref{async::Task} coroutine.
+ *
+ * @since 5.7
+ */
+template <typename tValue>
+auto operator co_await(async::Task<tValue> &&task) noexcept
+{
+    return detail::makeAwaiter(std::move(task).future());
+}
+
+NF_END_NAMESPACE
+
+#endif
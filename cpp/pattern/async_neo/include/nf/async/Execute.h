@@ -84,6 +84,24 @@ auto execute(Thread &thread, F func, tArgs... args) noexcept
     return std::move(future);
 }
 
+/**
+ * @brief Execute a function asynchronously in a provided executor.
+ *
+ * @param executor Executor to execute a function in, e.g. a @nfref{ThreadPoolExecutor}.
+ * @param func     Function to execute.
+ * @param args     Function arguments.
+ *
+ * @return @nfref{Future} which can be used to attach a continuation.
+ * @since 5.7
+ */
+template <typename F, typename... tArgs>
+auto execute(Executor &executor, F func, tArgs... args) noexcept
+{
+    auto [callable, future] = detail::prepareExecution(func, args...);
+    executor.post(std::move(callable));
+    return std::move(future);
+}
+
 /// @}
 
 } // namespace async
@@ -0,0 +1,126 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/ByteArray.h>
+#include <nf/Function.h>
+#include <nf/Future.h>
+#include <nf/RaiiToken.h>
+#include <nf/Result.h>
+
+#include <cstddef>
+#include <system_error>
+
+NF_BEGIN_NAMESPACE
+
+namespace async {
+
+/**
+ * @addtogroup nf_core_Async
+ * @{
+ */
+
+/**
+ * @brief The future of an I/O operation.
+ *
+ * It is fulfilled with the result of the operation or with the error it failed with.
+ *
+ * @since 5.7
+ */
+template <typename T>
+using IoFuture = FutureResult<T, std::error_code>;
+
+/**
+ * @brief The handler of data received by @ref receive().
+ *
+ * @since 5.7
+ */
+using ReceiveHandler = Function<void(Result<ByteArray, std::error_code>)>;
+
+/*
+ * The functions below perform I/O operations in the event loop of the calling thread.
+ *
+ * With the @ref UringFramework, the operations are submitted to the kernel via io_uring and
+ * complete without further system calls in the caller. All operations submitted while the event
+ * loop processes a batch of tasks are submitted together. With other backends, the functions
+ * perform the operation right away and, if the descriptor is not ready, wait for it via an
+ * @ref IoWatch.
+ *
+ * The buffers are owned by the operations, so a future may be dropped at any time. Use
+ * non-blocking descriptors, otherwise the fallback may block when writing.
+ */
+
+/**
+ * @brief Read up to @p size bytes from @p fd at its current position.
+ *
+ * The future is fulfilled with the data read, which is empty at the end of a file.
+ *
+ * @since 5.7
+ */
+IoFuture<ByteArray> read(int fd, std::size_t size) noexcept;
+
+/**
+ * @brief Write @p data to @p fd at its current position.
+ *
+ * The future is fulfilled with the number of bytes written.
+ *
+ * @since 5.7
+ */
+IoFuture<std::size_t> write(int fd, ByteArray data) noexcept;
+
+/**
+ * @brief Receive up to @p size bytes from the socket @p fd.
+ *
+ * The future is fulfilled with the data received, which is empty if the peer has closed the
+ * connection.
+ *
+ * @since 5.7
+ */
+IoFuture<ByteArray> recv(int fd, std::size_t size) noexcept;
+
+/**
+ * @brief Send @p data to the socket @p fd.
+ *
+ * The future is fulfilled with the number of bytes sent.
+ *
+ * @since 5.7
+ */
+IoFuture<std::size_t> send(int fd, ByteArray data) noexcept;
+
+/**
+ * @brief Accept a connection on the listening socket @p fd.
+ *
+ * The future is fulfilled with the descriptor of the accepted connection, which is
+ * non-blocking and closed on exec.
+ *
+ * @since 5.7
+ */
+IoFuture<int> accept(int fd) noexcept;
+
+/**
+ * @brief Receive data from the socket @p fd continuously.
+ *
+ * The @p handler is invoked with each chunk of received data until the peer closes the
+ * connection, which is reported as an empty chunk, or an error occurs. With io_uring, a single
+ * multishot receive is submitted for all of them and the kernel picks the buffers from a pool
+ * registered by the executor.
+ *
+ * Receiving stops when the returned token is destroyed.
+ *
+ * @since 5.7
+ */
+[[nodiscard]] RaiiToken receive(int fd, ReceiveHandler handler) noexcept;
+
+/** @} */
+
+} // namespace async
+
+NF_END_NAMESPACE
@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2019-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2019-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -13,18 +13,20 @@
 
 #include <nf/Executor.h>
 #include <nf/detail/CallbackScope.h>
+#include <nf/detail/TaskLanes.h>
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
 
-#include <list>
-#include <mutex>
+#include <atomic>
+#include <optional>
 
 NF_BEGIN_NAMESPACE
 
 namespace backend {
 
-class AsioTimer;
+class TimerWheel;
 
 /**
  * @ingroup nf_Core
@@ -33,6 +35,11 @@ class AsioTimer;
  * This executor is based on @c boost::asio::io_service object. See boost::asio <a href=
  * "https://www.boost.org/doc/libs/1_65_0/doc/html/boost_asio.html"> documentation</a> for
  * more details.
+ *
+ * Timers and delayed tasks are kept in a timer wheel, which is driven by a single
+ * @c boost::asio::steady_timer. Posted tasks are kept in the lanes of their priorities and
+ * run by a single handler of @c io_service, which yields to the other handlers after a
+ * limited number of tasks.
  */
 class AsioExecutor final : public Executor
 {
@@ -40,6 +47,8 @@ public:
     AsioExecutor();
     ~AsioExecutor() override;
     void post(Task &&task) noexcept override;
+    void postBatch(std::vector<Task> &&tasks) noexcept override;
+    std::size_t queueDepth(Priority priority) const noexcept override;
     std::unique_ptr<Timer> makeTimer(Interval interval, TimerTask &&task) noexcept override;
     std::unique_ptr<IoWatch> makeIoWatch(int fd, std::int16_t events,
                                          IoWatchTask &&task) noexcept override;
@@ -62,18 +71,26 @@ public:
 
 private:
     void handleSignals(const boost::system::error_code &ec, int signalNumber);
+    void scheduleDrain() noexcept;
+    void drain();
+    void armTimer(std::optional<std::int64_t> tick) noexcept;
     int runImpl() override;
     void postImpl(Delay delay, Task &&task) noexcept override;
+    void postToLane(Priority priority, Task &&task) noexcept override;
     void discardAllPostedEvents() noexcept override;
 
 private:
+    static constexpr int kMaxTasksPerDrain = 64;
+
     boost::asio::io_service m_ios;
+    detail::TaskLanes m_lanes;
+    std::atomic<bool> m_isDrainScheduled{false};
     std::unique_ptr<boost::asio::io_service::work> m_work;
     std::unique_ptr<boost::asio::signal_set> m_asioSignals;
     detail::CallbackScope m_cbScope;
     std::vector<LinuxSignalHandler> m_signalHandlers;
-    std::list<std::unique_ptr<AsioTimer>> m_postTimers;
-    std::mutex m_mutex;
+    std::unique_ptr<boost::asio::steady_timer> m_wheelTimer;
+    std::unique_ptr<TimerWheel> m_timerWheel;
     int m_exitCode{EXIT_SUCCESS};
 };
 
@@ -0,0 +1,143 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Logging.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+/**
+ * @ingroup nf_core_Logging
+ * @brief A log backend which writes to other backends from a dedicated thread.
+ *
+ * Backends are called synchronously by the thread which logs, so a slow output like stdout or
+ * DLT stalls the event loop of this thread. @c AsyncLogger decouples them: a logging thread
+ * only copies the formatted entry into a ring buffer of its own, which is lock-free, and a
+ * writer thread owned by the logger takes the entries from all rings and passes them to the
+ * wrapped backends.
+ *
+ * Entries of one thread are written in order. Entries of different threads are not ordered
+ * between each other. If a ring is full, the @ref OverflowPolicy decides what happens.
+ *
+ * @code
+ * nf::Logging::initialize(appId, {std::make_shared<nf::backend::AsyncLogger>(
+ *                                    std::vector<std::shared_ptr<nf::LogBackend>>{
+ *                                        std::make_shared<nf::backend::StdoutLogger>()})});
+ * @endcode
+ *
+ * Pending entries are written by @ref flush(), which @ref BaseApplication calls on shutdown via
+ * @ref Logging::flush(), and when the logger is destroyed.
+ *
+ * @since 5.7
+ */
+class AsyncLogger final : public LogBackend
+{
+public:
+    /**
+     * @brief What a logging thread does if its ring buffer is full.
+     */
+    enum class OverflowPolicy
+    {
+        Block,        ///< Wait until the writer thread makes room.
+        Drop,         ///< Discard the entry and count it, see @ref droppedCount().
+        DropAndReport ///< Like @c Drop, but also write a warning with the number of dropped ones.
+    };
+
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+public:
+    /**
+     * @brief Start a writer thread which writes to @p backends.
+     *
+     * @param backends Backends to write to. They are only called by the writer thread.
+     * @param policy What to do if a ring buffer is full.
+     * @param capacity The number of entries each logging thread can have pending. It is rounded
+     *                 up to a power of two.
+     */
+    explicit AsyncLogger(std::vector<std::shared_ptr<LogBackend>> backends,
+                         OverflowPolicy policy = OverflowPolicy::DropAndReport,
+                         std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Write all pending entries and stop the writer thread.
+     */
+    ~AsyncLogger() override;
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    void registerContext(LogContext &context) noexcept override;
+    void write(const LogContext &context, LogLevel level,
+               const std::string &message) noexcept override;
+    void write(const LogEntry &logEntry) noexcept override;
+    void suspendOutput() noexcept override;
+    void resumeOutput() noexcept override;
+    bool isSuspended() const noexcept override;
+
+    /**
+     * @brief Block until all entries written before this call have been passed to the backends.
+     */
+    void flush() noexcept override;
+
+    /**
+     * @brief Get the number of entries discarded because of full ring buffers.
+     */
+    std::uint64_t droppedCount() const noexcept;
+
+private:
+    class Ring;
+
+    Ring &localRing();
+    void run() noexcept;
+    bool drain(const std::vector<std::shared_ptr<Ring>> &rings) noexcept;
+    void reportDropped() noexcept;
+    void releaseFinishedRings() noexcept;
+    bool hasPendingEntries() const noexcept;
+    void wakeUp() noexcept;
+    void output(const LogEntry &logEntry) noexcept;
+
+private:
+    const std::vector<std::shared_ptr<LogBackend>> m_backends;
+    const OverflowPolicy m_policy;
+    const std::size_t m_capacity;
+    const std::uint64_t m_id;
+
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::uint64_t m_reported = 0;
+
+    /* Serializes calls to the backends. */
+    mutable std::mutex m_outputM;
+
+    mutable std::mutex m_m;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_flushed;
+    std::vector<std::shared_ptr<Ring>> m_rings;
+    std::atomic<bool> m_isWaiting{false};
+    std::uint64_t m_flushRequested = 0;
+    std::uint64_t m_flushDone = 0;
+    bool m_isStopping = false;
+
+    std::thread m_writer;
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
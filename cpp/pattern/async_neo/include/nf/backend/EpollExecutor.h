@@ -0,0 +1,141 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Executor.h>
+#include <nf/detail/TaskLanes.h>
+
+#include <sys/epoll.h>
+
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <optional>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+class TimerWheel;
+
+/**
+ * @ingroup nf_Core
+ * @brief The NF epoll executor implementation.
+ *
+ * This executor runs its own event loop on top of Linux
+ * <a href="https://man7.org/linux/man-pages/man7/epoll.7.html">epoll</a>. Posted tasks are
+ * passed through an intrusive lock-free multi-producer/single-consumer queue, so producers
+ * never contend on a mutex. A waiting event loop is woken up via an @c eventfd at most once
+ * per batch of posted tasks. Timers and delayed tasks are kept in a timer wheel, which is driven
+ * by a single @c timerfd waited for, together with I/O watches, by the same @c epoll instance.
+ *
+ * Linux signals are received via a @c signalfd. Therefore the handled signals are blocked in
+ * the thread calling @ref setSignalHandlers(), see @ref nf_core_LinuxSignals for details.
+ *
+ * The executor can be extended by further event sources via @ref addWatch(), see
+ * @ref UringExecutor.
+ */
+class EpollExecutor : public Executor
+{
+public:
+    /**
+     * @internal
+     * @brief The receiver of events for a file descriptor watched by the executor.
+     */
+    class EventHandler
+    {
+    public:
+        virtual void handleEvents(std::uint32_t events) noexcept = 0;
+
+    protected:
+        ~EventHandler() = default;
+    };
+
+public:
+    EpollExecutor() noexcept;
+    ~EpollExecutor() override;
+    void post(Task &&task) noexcept override;
+    void postBatch(std::vector<Task> &&tasks) noexcept override;
+    std::size_t queueDepth(Priority priority) const noexcept override;
+    std::unique_ptr<Timer> makeTimer(Interval interval, TimerTask &&task) noexcept override;
+    std::unique_ptr<IoWatch> makeIoWatch(int fd, std::int16_t events,
+                                         IoWatchTask &&task) noexcept override;
+    void stop() noexcept override;
+    void stop(int exitCode) noexcept override;
+    bool setSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override;
+    bool appendSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override;
+
+    /**
+     * @brief Get current time of the executor.
+     *
+     * Returns @c steady_time as timers are based on @c CLOCK_MONOTONIC.
+     */
+    std::chrono::milliseconds now() const noexcept override;
+
+    /**
+     * @internal
+     * @brief Watch @p fd for @p events and pass them to @p handler.
+     */
+    bool addWatch(int fd, std::uint32_t events, EventHandler *handler) noexcept;
+
+    /**
+     * @internal
+     * @brief Change @p events a watched @p fd is waited for.
+     */
+    bool modifyWatch(int fd, std::uint32_t events, EventHandler *handler) noexcept;
+
+    /**
+     * @internal
+     * @brief Stop watching @p fd.
+     *
+     * Events which have already been received but not yet passed to @p handler are dropped,
+     * so the handler may be destroyed right after this call.
+     */
+    void removeWatch(int fd, EventHandler *handler) noexcept;
+
+private:
+    int runImpl() override;
+    void postImpl(Delay delay, Task &&task) noexcept override;
+    void postToLane(Priority priority, Task &&task) noexcept override;
+    void discardAllPostedEvents() noexcept override;
+    void wakeUp() noexcept;
+    void dispatchEvents() noexcept;
+    bool processTasks();
+    void armTimer(std::optional<std::int64_t> tick) noexcept;
+    void handleSignals() noexcept;
+    void resetSignals() noexcept;
+
+private:
+    static constexpr int kMaxEvents = 64;
+    static constexpr int kMaxTasksPerIteration = 256;
+
+    int m_epollFd;
+    int m_wakeupFd;
+    int m_timerFd;
+    std::unique_ptr<TimerWheel> m_timerWheel;
+    detail::TaskLanes m_lanes;
+    std::atomic<bool> m_isWakeupPending{false};
+    std::atomic<bool> m_isStopRequested{false};
+    bool m_hasPendingTasks{true};
+    std::array<::epoll_event, kMaxEvents> m_events{};
+    int m_eventCount{0};
+    int m_eventIndex{0};
+    std::vector<LinuxSignalHandler> m_signalHandlers;
+    ::sigset_t m_blockedSignals{};
+    int m_signalFd{-1};
+    unsigned m_signalGeneration{0};
+    std::unique_ptr<IoWatch> m_signalWatch;
+    int m_exitCode{EXIT_SUCCESS};
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
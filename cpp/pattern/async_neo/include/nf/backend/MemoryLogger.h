@@ -12,12 +12,23 @@
 
 #include <nf/Logging.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 
 NF_BEGIN_NAMESPACE
 
 namespace backend {
 
+/**
+ * @brief A backend which keeps log entries in memory.
+ *
+ * By default, all entries are kept until @ref clear() is called. A logger constructed with a
+ * capacity keeps the latest messages only, in a ring of compact binary records preallocated
+ * upfront: the time stamp, the level, the context and the message. Older records are
+ * overwritten when the ring is full, so the memory stays bounded regardless of the log volume.
+ */
 class MemoryLogger : public LogBackend
 {
 public:
@@ -33,6 +44,19 @@ public:
     };
 
 public:
+    MemoryLogger() = default;
+
+    /**
+     * @brief Construct a logger which keeps the latest messages in a ring of @p capacity bytes.
+     *
+     * Messages which do not fit into the ring are truncated. The entries returned by
+     * @ref logEntries() have the time stamp, the level, the context and the message of the
+     * original entries only.
+     *
+     * @since 5.7
+     */
+    explicit MemoryLogger(std::size_t capacity) noexcept;
+
     void write(const LogContext &context, LogLevel level,
                const std::string &message) noexcept override;
     void write(const LogEntry &logEntry) noexcept override;
@@ -40,9 +64,46 @@ public:
     std::vector<LogEntry> logEntries() const noexcept;
     void clear() noexcept;
 
+    /**
+     * @brief Get the number of entries which have been overwritten since the last @ref clear().
+     *
+     * It is always 0 for a logger without a capacity.
+     *
+     * @since 5.7
+     */
+    std::size_t overwrittenCount() const noexcept;
+
+    /**
+     * @brief Write the kept entries as text lines to the descriptor @p fd.
+     *
+     * The lines are written without allocating memory, so the dump can be done from a crash
+     * handler. The dump is skipped if an entry is being written at the same time, e.g. by the
+     * crashed thread.
+     *
+     * @since 5.7
+     */
+    void dump(int fd) const noexcept;
+
 protected:
     std::vector<LogEntry> m_logEntries;
     mutable std::mutex m_m;
+
+private:
+    struct RecordHeader;
+
+    void writeRecord(const LogEntry &logEntry) noexcept;
+    template <typename F>
+    void forEachRecord(F &&func) const noexcept;
+    void copyIn(std::size_t offset, const void *data, std::size_t size) noexcept;
+    void copyOut(std::size_t offset, void *data, std::size_t size) const noexcept;
+
+private:
+    std::unique_ptr<std::byte[]> m_ring;
+    std::size_t m_capacity{0};
+    /* The offset of the oldest record and the number of bytes used by all records. */
+    std::size_t m_head{0};
+    std::size_t m_size{0};
+    std::size_t m_cntOverwritten{0};
 };
 
 } // namespace backend
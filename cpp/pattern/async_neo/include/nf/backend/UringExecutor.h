@@ -0,0 +1,96 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/async/Io.h>
+#include <nf/backend/EpollExecutor.h>
+
+#include <memory>
+#include <unordered_map>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+class IoUring;
+
+/**
+ * @ingroup nf_Core
+ * @brief The NF io_uring executor implementation.
+ *
+ * This executor is an @ref EpollExecutor which performs the I/O operations of
+ * @ref nf/async/Io.h via Linux <a href="https://man7.org/linux/man-pages/man7/io_uring.7.html">
+ * io_uring</a>. Instead of waiting for a descriptor to become ready and reading or writing it
+ * with a separate system call, an operation is submitted to the kernel and its completion is
+ * reported back. Operations started while the event loop processes a batch of tasks are
+ * submitted with a single system call. Completions are signalled via an @c eventfd, which the
+ * epoll event loop waits for.
+ *
+ * Continuous receives use multishot receive with a pool of buffers registered with the kernel,
+ * if the kernel supports it.
+ *
+ * Use the functions of @ref nf/async/Io.h rather than this class, they work with any executor.
+ * The methods of this class must be called from the executor's thread.
+ */
+class UringExecutor final : public EpollExecutor, private EpollExecutor::EventHandler
+{
+public:
+    template <typename T>
+    using IoFuture = async::IoFuture<T>;
+
+public:
+    /**
+     * @brief Check if the kernel supports io_uring with all features the executor needs.
+     */
+    static bool isSupported() noexcept;
+
+    UringExecutor() noexcept;
+    ~UringExecutor() override;
+
+    IoFuture<ByteArray> read(int fd, std::size_t size) noexcept;
+    IoFuture<std::size_t> write(int fd, ByteArray data) noexcept;
+    IoFuture<ByteArray> recv(int fd, std::size_t size) noexcept;
+    IoFuture<std::size_t> send(int fd, ByteArray data) noexcept;
+    IoFuture<int> accept(int fd) noexcept;
+    [[nodiscard]] RaiiToken receive(int fd, async::ReceiveHandler handler) noexcept;
+
+private:
+    struct Operation;
+    struct Receiver;
+
+    template <typename T, typename tPrepare, typename tFinish>
+    IoFuture<T> start(ByteArray &&buffer, tPrepare &&prepare, tFinish &&finish) noexcept;
+    template <typename tPrepare>
+    std::uint64_t submit(std::unique_ptr<Operation> operation, tPrepare &&prepare) noexcept;
+    void scheduleSubmit() noexcept;
+    void armReceiver(const std::shared_ptr<Receiver> &receiver) noexcept;
+    void cancel(std::uint64_t id) noexcept;
+    void handleEvents(std::uint32_t events) noexcept override;
+    void complete(std::uint64_t id, std::int32_t result, std::uint32_t flags) noexcept;
+
+private:
+    static constexpr unsigned kEntries = 256;
+    static constexpr unsigned kBufferCount = 128;
+    static constexpr std::size_t kBufferSize = 4096;
+
+    std::unique_ptr<IoUring> m_ring;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Operation>> m_operations;
+    std::uint64_t m_lastId{0};
+    bool m_isSubmitScheduled{false};
+    /* Cleared when the kernel turns out not to support multishot receives. */
+    bool m_hasMultishot{true};
+    bool m_hasSelectedBuffer{false};
+    bool m_isClosing{false};
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
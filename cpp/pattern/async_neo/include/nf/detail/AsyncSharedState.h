@@ -22,9 +22,10 @@
 #include <boost/hana/if.hpp>
 #include <boost/hana/type.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <variant>
 
@@ -137,11 +138,25 @@ private:
 template <typename tValue>
 class AsyncSharedState;
 
+/* The receiving side of a shared state, either a continuation or an awaiting coroutine. */
 template <typename tInput>
-class ContinuationBase : public ContextItem
+class AsyncReceiver
 {
 public:
-    void accept(tInput &&input) noexcept
+    virtual void accept(tInput &&input) noexcept = 0;
+
+    /* The state is destroyed without ever getting a value. */
+    virtual void abandon() noexcept = 0;
+
+protected:
+    ~AsyncReceiver() = default;
+};
+
+template <typename tInput>
+class ContinuationBase : public ContextItem, public AsyncReceiver<tInput>
+{
+public:
+    void accept(tInput &&input) noexcept override
     {
         /* No guard for this is needed because it guarded by post(). */
         post([this, input = std::move(input)]() mutable {
@@ -150,10 +165,12 @@ public:
         });
     }
 
-    using ContextItem::decontextualize;
+    void abandon() noexcept override
+    {
+        decontextualize();
+    }
 
 private:
-    friend AsyncSharedState<tInput>;
     virtual void handle(tInput &&input) = 0;
 };
 
@@ -161,6 +178,8 @@ template <typename tFunc, typename tInput, typename tOutput>
 class Continuation : public ContinuationBase<tInput>
 {
 public:
+    /* The state of the returned future is kept apart from this object, so that the future
+     * does not keep the function and its captures alive once the context is reset. */
     Continuation(const Context &context, tFunc &&func) noexcept
         : m_invocator(context, std::move(func))
     {
@@ -181,6 +200,11 @@ private:
     InvocationHelper<tFunc, tOutput, tInput> m_invocator;
 };
 
+/*
+ * The state is shared by a promise and its future. Both the value and the continuation are set
+ * exactly once, so the state only moves forward: empty -> value set or continuation set -> done.
+ * Whoever completes the state hands the value over to the continuation, no lock is needed.
+ */
 template <typename tValue>
 class AsyncSharedState final
 {
@@ -194,47 +218,70 @@ public:
     ~AsyncSharedState()
     {
         // If a continuation is set and still alive, remove it from context so it gets freed
-        if (m_continuation) {
-            if (auto ptr = m_continuation->lock()) {
-                ptr->decontextualize();
+        if (m_status.load(std::memory_order_acquire) == kContinuationSet) {
+            if (auto ptr = m_receiver.lock()) {
+                ptr->abandon();
             }
         }
     }
 
     void setValue(tValue &&value)
     {
-        std::unique_lock lock(m_mutex);
-        assertThat(!m_value, "Value is already set");
-        m_value = std::move(value);
-        notify();
+        assertThat(!(m_status.load(std::memory_order_acquire) & kValueSet),
+                   "Value is already set");
+        m_value.emplace(std::move(value));
+        if (m_status.fetch_or(kValueSet, std::memory_order_acq_rel) == kContinuationSet) {
+            notify();
+        }
     }
 
     void setContinuation(const Context &context,
                          std::shared_ptr<ContinuationBase<tValue>> &&continuation)
     {
-        std::unique_lock lock(m_mutex);
-        assertThat(!m_continuation, "Continuation is already set");
+        assertThat(!(m_status.load(std::memory_order_acquire) & kContinuationSet),
+                   "Continuation is already set");
         detail::bind(context, continuation);
-        m_continuation = std::move(continuation);
-        notify();
+        setReceiver(std::move(continuation));
+    }
+
+    /* Unlike a continuation, the receiver is not bound to any context, its owner is. */
+    void setReceiver(std::weak_ptr<AsyncReceiver<tValue>> receiver)
+    {
+        assertThat(!(m_status.load(std::memory_order_acquire) & kContinuationSet),
+                   "Continuation is already set");
+        m_receiver = std::move(receiver);
+        if (m_status.fetch_or(kContinuationSet, std::memory_order_acq_rel) == kValueSet) {
+            notify();
+        }
+    }
+
+    /* Take the value if it is already there, no continuation can be set afterwards. Only the
+     * future side sets the continuation, so there is no race once the value is set. */
+    std::optional<tValue> take() noexcept
+    {
+        if (m_status.load(std::memory_order_acquire) != kValueSet) {
+            return std::nullopt;
+        }
+        m_status.store(kValueSet | kContinuationSet, std::memory_order_relaxed);
+        return std::move(m_value);
     }
 
 private:
+    static constexpr std::uint8_t kValueSet = 1;
+    static constexpr std::uint8_t kContinuationSet = 2;
+
     void notify() noexcept
     {
-        if (m_continuation && m_value) {
-            if (auto ptr = m_continuation->lock()) {
-                ptr->accept(std::move(*m_value));
-            }
-            // Invalidate pointer, but keep optional valid to prevent double use
-            m_continuation.emplace();
+        if (auto ptr = m_receiver.lock()) {
+            ptr->accept(std::move(*m_value));
         }
+        m_receiver.reset();
     }
 
 private:
-    std::mutex m_mutex;
+    std::atomic<std::uint8_t> m_status{0};
     std::optional<tValue> m_value;
-    std::optional<std::weak_ptr<ContinuationBase<tValue>>> m_continuation;
+    std::weak_ptr<AsyncReceiver<tValue>> m_receiver;
 };
 
 } // namespace detail
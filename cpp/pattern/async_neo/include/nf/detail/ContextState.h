@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "AnyFunction.h"
+#include "SlabAllocator.h"
 
 #include <nf/Executor.h>
 #include <nf/Future.h>
@@ -24,6 +25,7 @@
 #include <mutex>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 NF_BEGIN_NAMESPACE
 
@@ -132,14 +134,18 @@ class ContextState final : boost::noncopyable, public std::enable_shared_from_th
 
 public:
     using Task = Function<void()>;
-    using TaskList = std::list<AnyFunction>;
+    using TaskList = std::list<AnyFunction, SlabAllocator<AnyFunction>>;
     using TaskIterator = TaskList::const_iterator;
 
+    /* Tasks posted to the executor are invoked once, so they are stored as they are. */
+    using PostedList = std::list<Task, SlabAllocator<Task>>;
+    using PostedIterator = PostedList::iterator;
+
     using Item = std::shared_ptr<ContextItem>;
-    using ItemList = std::list<Item>;
+    using ItemList = std::list<Item, SlabAllocator<Item>>; // Same as ContextItem::List
     using ItemIterator = ItemList::const_iterator;
 
-    using TokenList = std::list<RaiiToken>;
+    using TokenList = std::list<RaiiToken, SlabAllocator<RaiiToken>>;
 
     class StoredTask
     {
@@ -234,6 +240,45 @@ public:
         TaskIterator m_it;
     };
 
+    /* A posted task as it is passed to the executor. It is small enough to be stored inline
+     * by Executor::Task. */
+    class PostedTask
+    {
+    public:
+        PostedTask(std::weak_ptr<ContextState> &&state, PostedIterator it) noexcept
+            : m_state(std::move(state))
+            , m_it(it)
+        {
+        }
+
+        PostedTask(const PostedTask &) = delete;
+        PostedTask(PostedTask &&) noexcept = default;
+        PostedTask &operator=(const PostedTask &) = delete;
+        PostedTask &operator=(PostedTask &&) noexcept = default;
+
+        ~PostedTask()
+        {
+            if (auto state = m_state.lock()) {
+                // NOTE: like in StoredTask, the task is destroyed after unlocking the mutex
+                Task delayDelete;
+                std::unique_lock lock(state->m_mutex);
+                delayDelete = std::move(*m_it);
+                state->m_posted.erase(m_it);
+            }
+        }
+
+        void invoke() const
+        {
+            if (auto state = m_state.lock()) {
+                (*m_it)();
+            }
+        }
+
+    private:
+        std::weak_ptr<ContextState> m_state;
+        PostedIterator m_it;
+    };
+
 public:
     static ContextState &from(const Context &context) noexcept;
     static void reset(std::shared_ptr<ContextState> &state) noexcept;
@@ -245,6 +290,8 @@ public:
 public:
     void post(Task &&task) noexcept;
     void post(Executor::Delay when, Task &&task) noexcept;
+    void post(Executor::Priority priority, Task &&task) noexcept;
+    void postBatch(std::vector<Task> &&tasks) noexcept;
 
     template <typename tFunc, typename = std::enable_if_t<!IsNonCallableBindable<tFunc>>>
     [[nodiscard]] auto bind(tFunc &&f) noexcept
@@ -271,11 +318,21 @@ public:
 
 private:
     std::shared_ptr<StoredTask> store(AnyFunction &&task) noexcept;
+    PostedTask storePosted(Task &&task) noexcept;
 
 private:
     mutable std::mutex m_mutex;
     std::shared_ptr<Executor> m_executor;
+
+    /* The nodes of the lists are recycled, so that posting through a context does not
+     * allocate once it is warmed up. The pools are guarded by the mutex as the lists are. */
+    SlabPool m_taskPool;
+    SlabPool m_postedPool;
+    SlabPool m_itemPool;
+    SlabPool m_tokenPool;
+
     TaskList m_tasks;
+    PostedList m_posted;
     ItemList m_items;
     TokenList m_tokens;
 };
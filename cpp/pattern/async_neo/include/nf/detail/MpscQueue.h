@@ -0,0 +1,80 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Global.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+
+NF_BEGIN_NAMESPACE
+namespace detail {
+
+/**
+ * @internal
+ * @brief A node of the @ref MpscQueue.
+ *
+ * Queued types derive from this class, so that pushing to the queue does not allocate.
+ */
+class MpscQueueNode
+{
+private:
+    friend class MpscQueue;
+    std::atomic<MpscQueueNode *> m_next{nullptr};
+};
+
+/**
+ * @internal
+ * @brief An intrusive lock-free multi-producer/single-consumer queue.
+ *
+ * This is the queue by Dmitry Vyukov. Pushing is wait-free and can be done from any thread.
+ * Popping must be done from a single (consumer) thread only. The queue does not own the nodes.
+ */
+class MpscQueue : private boost::noncopyable
+{
+public:
+    MpscQueue() noexcept;
+
+    /**
+     * @brief Append a @p node to the queue.
+     */
+    void push(MpscQueueNode *node) noexcept;
+
+    /**
+     * @brief Append a chain of nodes from @p first to @p last to the queue at once.
+     *
+     * The nodes must have been chained with @ref link() before. Consumers see either none or
+     * all of them.
+     */
+    void push(MpscQueueNode *first, MpscQueueNode *last) noexcept;
+
+    /**
+     * @brief Chain @p next after @p node to be pushed at once.
+     */
+    static void link(MpscQueueNode *node, MpscQueueNode *next) noexcept;
+
+    /**
+     * @brief Take the first node from the queue.
+     *
+     * Returns @c nullptr if the queue is empty. It also returns @c nullptr if a producer is in
+     * the middle of a push; the caller must make sure it gets notified once the push completes.
+     */
+    MpscQueueNode *pop() noexcept;
+
+private:
+    std::atomic<MpscQueueNode *> m_head;
+    MpscQueueNode *m_tail;
+    MpscQueueNode m_stub;
+};
+
+} // namespace detail
+NF_END_NAMESPACE
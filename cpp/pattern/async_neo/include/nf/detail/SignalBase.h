@@ -15,9 +15,13 @@
 
 #include <boost/core/noncopyable.hpp>
 
-#include <list>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 NF_BEGIN_NAMESPACE
 
@@ -31,10 +35,6 @@ class SignalNtBase : private boost::noncopyable
 {
     friend class ListenerNtBase;
 
-public:
-    using ListenerList = std::list<std::weak_ptr<ListenerNtBase>>;
-    using Iterator = ListenerList::iterator;
-
 public:
     // DEPRECATED. Move it to protected after C++20.
     ~SignalNtBase();
@@ -44,9 +44,45 @@ protected:
     void bind(const Context &context, std::shared_ptr<ListenerNtBase> &&listener) const noexcept;
     void unbind(ListenerNtBase &listener) const noexcept;
 
-protected:
+    /* Call f for every listener which is still alive, without locking or allocating. Listeners
+     * bound or unbound during the iteration do not affect it, and the signal may be destroyed by
+     * one of them. */
+    template <typename tFunc>
+    void forEachListener(tFunc &&f) const noexcept;
+
+    /* The counter of the notifications which conflating listeners skipped. It is shared with the
+     * listeners, which may outlive the signal, and created for the first of them. */
+    std::shared_ptr<std::atomic<std::uint64_t>> conflatedCounter() const noexcept;
+    std::uint64_t loadConflatedCount() const noexcept;
+
+private:
+    struct Entry
+    {
+        const ListenerNtBase *listener;
+        std::weak_ptr<ListenerNtBase> wListener;
+    };
+
+    /* An immutable list of listeners. bind() and unbind() publish a new one. The signal holds one
+     * reference to the current one and each running notify() holds another. */
+    struct Snapshot
+    {
+        std::vector<Entry> entries;
+        mutable std::atomic<int> refs{1};
+    };
+
+    void insert(const std::shared_ptr<ListenerNtBase> &listener) const noexcept;
+    const Snapshot *acquireSnapshot() const noexcept;
+    static void releaseSnapshot(const Snapshot *snapshot) noexcept;
+    void publish(std::unique_ptr<Snapshot> &&snapshot) const noexcept;
+
+private:
+    /* Serializes bind() and unbind(). */
     mutable std::mutex m_mutex;
-    mutable ListenerList m_listeners;
+    /* Guarded by m_mutex. */
+    mutable std::shared_ptr<std::atomic<std::uint64_t>> m_conflatedCount;
+    mutable std::atomic<const Snapshot *> m_snapshot{nullptr};
+    /* The number of threads between loading m_snapshot and taking a reference to it. */
+    mutable std::atomic<int> m_acquiring{0};
 };
 
 class ListenerNtBase : public ContextItem
@@ -59,17 +95,72 @@ protected:
     ~ListenerNtBase() override;
 
 private:
-    SignalNtBase::Iterator m_it;
     const SignalNtBase *m_signal{nullptr};
 };
 
+inline const SignalNtBase::Snapshot *SignalNtBase::acquireSnapshot() const noexcept
+{
+    /* Pairs with publish(): either the snapshot is retired after this thread has taken its
+     * reference, or this thread loads the new one. */
+    m_acquiring.fetch_add(1);
+    const auto *snapshot = m_snapshot.load();
+    if (snapshot) {
+        snapshot->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_acquiring.fetch_sub(1, std::memory_order_release);
+    return snapshot;
+}
+
+inline void SignalNtBase::releaseSnapshot(const Snapshot *snapshot) noexcept
+{
+    if (snapshot && snapshot->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete snapshot;
+    }
+}
+
+template <typename tFunc>
+void SignalNtBase::forEachListener(tFunc &&f) const noexcept
+{
+    /* Only the snapshot is used from now on, because a listener may destroy the signal. */
+    const auto *snapshot = acquireSnapshot();
+    if (!snapshot) {
+        return;
+    }
+
+    for (const auto &entry : snapshot->entries) {
+        if (auto listener = entry.wListener.lock()) {
+            f(*listener);
+        }
+    }
+    releaseSnapshot(snapshot);
+}
+
 template <typename... tArgs>
 class ListenerBase : public ListenerNtBase
 {
+public:
+    using Arguments = std::tuple<std::decay_t<tArgs>...>;
+
 public:
     virtual void invoke(const tArgs &...args) noexcept = 0;
+
+    /* A listener which can be invoked with a copy of the arguments shared with other listeners
+     * returns the executor to invoke it on, see SignalDelivery::Coalesced. */
+    virtual std::shared_ptr<Executor> sharedExecutor() const noexcept
+    {
+        return nullptr;
+    }
+
+    virtual void invokeShared(const Arguments & /*args*/) noexcept
+    {
+    }
 };
 
+/* Whether a listener can be invoked with shared arguments instead of its own copy. */
+template <typename tFunc, typename... tArgs>
+constexpr bool kAcceptsSharedArguments =
+    std::is_invocable_v<std::decay_t<tFunc> &, const std::decay_t<tArgs> &...>;
+
 template <typename tFunc, typename... tArgs>
 class DirectListener final : public ListenerBase<tArgs...>
 {
@@ -115,6 +206,22 @@ public:
         }
     }
 
+    std::shared_ptr<Executor> sharedExecutor() const noexcept override
+    {
+        if constexpr (kAcceptsSharedArguments<tFunc, tArgs...>) {
+            return m_executor.lock();
+        } else {
+            return nullptr;
+        }
+    }
+
+    void invokeShared(const typename ListenerBase<tArgs...>::Arguments &args) noexcept override
+    {
+        if constexpr (kAcceptsSharedArguments<tFunc, tArgs...>) {
+            std::apply(m_f, args);
+        }
+    }
+
 private:
     std::weak_ptr<Executor> m_executor;
     std::decay_t<tFunc> m_f;
@@ -138,8 +245,99 @@ public:
         });
     }
 
+    std::shared_ptr<Executor> sharedExecutor() const noexcept override
+    {
+        if constexpr (kAcceptsSharedArguments<tFunc, tArgs...>) {
+            return this->executor();
+        } else {
+            return nullptr;
+        }
+    }
+
+    void invokeShared(const typename ListenerBase<tArgs...>::Arguments &args) noexcept override
+    {
+        if constexpr (kAcceptsSharedArguments<tFunc, tArgs...>) {
+            std::apply(m_f, args);
+        }
+    }
+
+private:
+    std::decay_t<tFunc> m_f;
+};
+
+/* Keeps at most one notification pending. A newer one replaces the pending one in place, so the
+ * listener only gets the latest. */
+template <typename tFunc, typename... tArgs>
+class ConflatingListener final : public ListenerBase<tArgs...>
+{
+public:
+    /* Posts to the executor. */
+    ConflatingListener(const std::shared_ptr<Executor> &executor, tFunc &&f,
+                       std::shared_ptr<std::atomic<std::uint64_t>> conflatedCount) noexcept
+        : m_executor(executor)
+        , m_isContextual(false)
+        , m_f(std::move(f))
+        , m_conflatedCount(std::move(conflatedCount))
+    {
+    }
+
+    /* Posts to the bound context. */
+    ConflatingListener(tFunc &&f,
+                       std::shared_ptr<std::atomic<std::uint64_t>> conflatedCount) noexcept
+        : m_isContextual(true)
+        , m_f(std::move(f))
+        , m_conflatedCount(std::move(conflatedCount))
+    {
+    }
+
+public:
+    void invoke(const tArgs &...args) noexcept override
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_pending) {
+            *m_pending = std::tie(args...);
+            m_conflatedCount->fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_pending.emplace(args...);
+        lock.unlock();
+
+        if (m_isContextual && this->executor()) {
+            /* No guard for this is needed because it guarded by post(). */
+            this->post([this] { deliver(); });
+        } else if (auto executor = m_isContextual ? nullptr : m_executor.lock()) {
+            executor->post([this, wSelf = this->weak_from_this()] {
+                if (auto self = wSelf.lock()) {
+                    deliver();
+                }
+            });
+        } else {
+            /* Nothing is posted, so the next notification must not wait for it. */
+            lock.lock();
+            m_pending.reset();
+        }
+    }
+
+private:
+    void deliver() noexcept
+    {
+        std::unique_lock lock(m_mutex);
+        auto args = std::move(*m_pending);
+        m_pending.reset();
+        lock.unlock();
+
+        std::apply(m_f, std::move(args));
+    }
+
 private:
+    const std::weak_ptr<Executor> m_executor;
+    const bool m_isContextual;
     std::decay_t<tFunc> m_f;
+    /* Shared, because a listener may destroy the signal during notify(). */
+    const std::shared_ptr<std::atomic<std::uint64_t>> m_conflatedCount;
+
+    std::mutex m_mutex;
+    std::optional<typename ListenerBase<tArgs...>::Arguments> m_pending;
 };
 
 } // namespace detail
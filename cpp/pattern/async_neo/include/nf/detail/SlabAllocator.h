@@ -0,0 +1,126 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Global.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+NF_BEGIN_NAMESPACE
+namespace detail {
+
+/**
+ * @internal
+ * @brief A free list of equally sized memory blocks, which are allocated in slabs.
+ *
+ * The size of the blocks is taken from the first allocation. Freed blocks are reused, the
+ * slabs are released only when the pool is destroyed. The pool is not thread-safe.
+ */
+class SlabPool : private boost::noncopyable
+{
+public:
+    explicit SlabPool(std::size_t blocksPerSlab = 32) noexcept;
+    ~SlabPool();
+
+    /**
+     * @brief Allocate a block of @p size bytes.
+     *
+     * Sizes other than the one of the first allocation are passed to the global allocator.
+     */
+    void *allocate(std::size_t size);
+
+    /**
+     * @brief Free a @p block of @p size bytes allocated by this pool.
+     */
+    void deallocate(void *block, std::size_t size) noexcept;
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    void grow();
+
+private:
+    const std::size_t m_blocksPerSlab;
+    std::size_t m_size{0};
+    std::size_t m_blockSize{0};
+    FreeBlock *m_free{nullptr};
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+};
+
+/**
+ * @internal
+ * @brief An allocator taking single objects from a @ref SlabPool.
+ *
+ * It suits node-based containers like @c std::list, whose nodes are all of the same size.
+ * Arrays are passed to the global allocator.
+ */
+template <typename T>
+class SlabAllocator
+{
+public:
+    using value_type = T;
+
+    explicit SlabAllocator(SlabPool &pool) noexcept
+        : m_pool(&pool)
+    {
+    }
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U> &other) noexcept // NOLINT(google-explicit-constructor)
+        : m_pool(other.m_pool)
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T *>(m_pool->allocate(sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        m_pool->deallocate(p, sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U> &other) const noexcept
+    {
+        return m_pool == other.m_pool;
+    }
+
+    template <typename U>
+    bool operator!=(const SlabAllocator<U> &other) const noexcept
+    {
+        return m_pool != other.m_pool;
+    }
+
+private:
+    template <typename U>
+    friend class SlabAllocator;
+
+    SlabPool *m_pool;
+};
+
+} // namespace detail
+NF_END_NAMESPACE
@@ -0,0 +1,98 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Executor.h>
+#include <nf/detail/MpscQueue.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+NF_BEGIN_NAMESPACE
+namespace detail {
+
+/**
+ * @internal
+ * @brief The queues of posted tasks of an event loop, one per @ref Executor::Priority.
+ *
+ * Any thread can push tasks, but only the event loop's thread may pop them. The lanes are
+ * served in a weighted round robin, see @ref Executor::post(Executor::Priority,Executor::Task&&).
+ */
+class TaskLanes : private boost::noncopyable
+{
+public:
+    using Priority = Executor::Priority;
+
+    struct Node : MpscQueueNode
+    {
+        explicit Node(Executor::Task &&task) noexcept;
+
+        Executor::Task task;
+    };
+
+public:
+    TaskLanes() noexcept;
+
+    /**
+     * @brief Destroy the lanes together with the tasks which have not been popped.
+     */
+    ~TaskLanes();
+
+    /**
+     * @brief Append a @p task to the lane of a @p priority.
+     */
+    void push(Priority priority, Executor::Task &&task) noexcept;
+
+    /**
+     * @brief Append @p tasks to the lane of a @p priority at once.
+     */
+    void push(Priority priority, std::vector<Executor::Task> &&tasks) noexcept;
+
+    /**
+     * @brief Take the next task.
+     *
+     * Like @ref MpscQueue::pop(), this returns @c nullptr while a producer is in the middle of
+     * a push. The caller must make sure it gets notified once the push completes.
+     */
+    std::unique_ptr<Node> pop() noexcept;
+
+    /**
+     * @brief Get the number of tasks in the lane of a @p priority.
+     */
+    std::size_t depth(Priority priority) const noexcept;
+
+    /**
+     * @brief Destroy all tasks which have not been popped.
+     */
+    void discard() noexcept;
+
+private:
+    static constexpr std::size_t kLaneCount = 3;
+
+    struct Lane
+    {
+        MpscQueue queue;
+        std::atomic<std::size_t> depth{0};
+    };
+
+    std::array<Lane, kLaneCount> m_lanes;
+
+    /* The round robin state, owned by the consumer. */
+    std::size_t m_current{0};
+    unsigned m_credit{0};
+};
+
+} // namespace detail
+NF_END_NAMESPACE
@@ -0,0 +1,165 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Global.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+NF_BEGIN_NAMESPACE
+namespace detail {
+
+/**
+ * @internal
+ * @brief A lock-free work-stealing deque of pointers.
+ *
+ * This is the Chase-Lev deque with the memory orders by Lê, Pop, Cohen and Zappa Nardelli
+ * ("Correct and Efficient Work-Stealing for Weak Memory Models"). The owner thread pushes and
+ * pops at the bottom, i.e. in LIFO order, other threads steal from the top, i.e. in FIFO order.
+ * The deque grows as needed and does not own the elements.
+ */
+template <typename T>
+class WorkStealingDeque : private boost::noncopyable
+{
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 256) noexcept
+    {
+        m_arrays.push_back(std::make_unique<Array>(capacity));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Push an @p element to the bottom. Must be called by the owner only.
+     */
+    void push(T *element) noexcept
+    {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed);
+        const auto top = m_top.load(std::memory_order_acquire);
+        auto *array = m_array.load(std::memory_order_relaxed);
+        if (bottom - top > array->mask) {
+            array = grow(array, top, bottom);
+        }
+        array->put(bottom, element);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take an element from the bottom. Must be called by the owner only.
+     *
+     * Returns @c nullptr if the deque is empty.
+     */
+    T *pop() noexcept
+    {
+        const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        auto *array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = m_top.load(std::memory_order_relaxed);
+
+        T *element = nullptr;
+        if (top <= bottom) {
+            element = array->get(bottom);
+            if (top == bottom) {
+                /* The last element, race against thieves for it. */
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed)) {
+                    element = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        } else {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return element;
+    }
+
+    /**
+     * @brief Take an element from the top. Can be called by any thread.
+     *
+     * Returns @c nullptr if the deque is empty or another thread took the element first.
+     */
+    T *steal() noexcept
+    {
+        auto top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        auto *element = m_array.load(std::memory_order_acquire)->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return element;
+    }
+
+    /**
+     * @brief Check if the deque is empty. The result is only a hint if other threads use it.
+     */
+    bool isEmpty() const noexcept
+    {
+        return m_bottom.load(std::memory_order_seq_cst) <= m_top.load(std::memory_order_seq_cst);
+    }
+
+private:
+    struct Array
+    {
+        explicit Array(std::size_t capacity) noexcept
+            : mask(static_cast<std::int64_t>(capacity) - 1)
+            , elements(new std::atomic<T *>[capacity])
+        {
+        }
+
+        T *get(std::int64_t index) const noexcept
+        {
+            return elements[index & mask].load(std::memory_order_acquire);
+        }
+
+        void put(std::int64_t index, T *element) noexcept
+        {
+            elements[index & mask].store(element, std::memory_order_release);
+        }
+
+        const std::int64_t mask;
+        std::unique_ptr<std::atomic<T *>[]> elements;
+    };
+
+    Array *grow(Array *array, std::int64_t top, std::int64_t bottom) noexcept
+    {
+        /* Thieves may still read the old array, so it is kept until the deque is destroyed.
+         * Arrays double in size, so all of them together take at most twice the memory. */
+        m_arrays.push_back(std::make_unique<Array>(2 * (array->mask + 1)));
+        auto *grown = m_arrays.back().get();
+        for (auto i = top; i < bottom; ++i) {
+            grown->put(i, array->get(i));
+        }
+        m_array.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+private:
+    alignas(64) std::atomic<std::int64_t> m_top{0};
+    alignas(64) std::atomic<std::int64_t> m_bottom{0};
+    std::atomic<Array *> m_array;
+    /* Owned by the owner thread. */
+    std::vector<std::unique_ptr<Array>> m_arrays;
+};
+
+} // namespace detail
+NF_END_NAMESPACE
@@ -123,6 +123,13 @@ void BaseApplication::enablePeriodicBuildInfo(std::chrono::seconds interval)
     m_buildInfoInterval = interval;
 }
 
+void BaseApplication::enablePeriodicExecutorStatistics(std::chrono::seconds interval,
+                                                       std::chrono::microseconds slowTaskThreshold)
+{
+    m_statisticsInterval = interval;
+    m_slowTaskThreshold = slowTaskThreshold;
+}
+
 void BaseApplication::ensureUniqueInstance() noexcept
 {
     const std::string processName{__progname};
@@ -210,6 +217,7 @@ int BaseApplication::run()
     initializeLogging();
     initializeFramework();
     startVersionLogging();
+    startStatisticsLogging();
 
     if (!startApplicationHeartbeat()) {
         nf::warn("Application is started without watchdog heartbeat configured!");
@@ -239,6 +247,8 @@ int BaseApplication::run()
         SingletonRegistry::releaseAll();
 
         nf::info("Bye...");
+        /* Asynchronous log backends may still hold the last messages. */
+        Logging::flush();
         terminateFramework();
     });
 
@@ -451,7 +461,26 @@ void BaseApplication::startVersionLogging() noexcept
                 nf::info("{} version is {}!", __progname, m_version);
                 return true;
             });
+            m_versionTimer->setPriority(Executor::Priority::Background);
             m_versionTimer->start();
         }
     }
 }
+
+void BaseApplication::startStatisticsLogging() noexcept
+{
+    if (!m_statisticsInterval) {
+        return;
+    }
+
+    const auto &executor = Executor::mainThread();
+    executor->enableStatistics(m_slowTaskThreshold);
+    m_statisticsTimer = executor->makeTimer(m_statisticsInterval.value(), [] {
+        if (auto statistics = Executor::mainThread()->statistics()) {
+            nf::info("Main executor statistics: {}", statistics.value());
+        }
+        return true;
+    });
+    m_statisticsTimer->setPriority(Executor::Priority::Background);
+    m_statisticsTimer->start();
+}
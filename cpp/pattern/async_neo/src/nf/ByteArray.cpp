@@ -10,13 +10,11 @@
  */
 #include "nf/ByteArray.h"
 
+#include "detail/ByteCodec.h"
+
 #include <nf/Logging.h>
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-#include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
 #include <charconv>
@@ -84,12 +82,21 @@ Result<ByteArray> ByteArray::fromHex(std::string_view hex,
 {
     try {
         ByteArray arr;
-        arr.m_data.reserve(hex.size() / 2);
+        arr.m_data.resize(hex.size() / 2);
+        auto *out = arr.m_data.data();
         const auto *it = hex.cbegin();
         while (it != hex.cend()) {
-            arr.m_data.push_back(decodeOneByte(it, hex.cend(), specialCharacters));
+            /* Runs of plain hex digits are decoded in bulk, anything else byte by byte. */
+            const auto consumed =
+                detail::decodeHex(it, static_cast<std::size_t>(hex.cend() - it), out);
+            it += consumed;
+            out += consumed / 2;
+            if (it != hex.cend()) {
+                *out++ = decodeOneByte(it, hex.cend(), specialCharacters);
+            }
         }
 
+        arr.m_data.resize(static_cast<std::size_t>(out - arr.m_data.data()));
         return arr;
     } catch (std::exception &) {
         return nf::result::Err{};
@@ -98,14 +105,9 @@ Result<ByteArray> ByteArray::fromHex(std::string_view hex,
 
 Result<ByteArray> ByteArray::fromBase64(std::string_view base64) noexcept
 {
-    using namespace boost::archive::iterators;
-    using FromBase64Iter = transform_width<binary_from_base64<std::string::const_iterator>, 8, 6>;
-    const auto charToByte = [](char ch) -> std::byte { return static_cast<std::byte>(ch); };
     try {
-        // Note: binary_from_base64 converts *all* '=' to '\0', therefore need to
-        // ... manually check for non-padding '=' and
-        // ... trim exactly as many trailing '\0' from the decoded result as '=' were appended
-        //     to the Base64 input.
+        // Note: the padding is validated here and is not passed to the decoder, therefore need
+        // to manually check for non-padding '='.
         const auto size = base64.size();
         const auto firstPadding = base64.find('=');
         if (firstPadding != std::string::npos && firstPadding < size - 2) {
@@ -122,11 +124,17 @@ Result<ByteArray> ByteArray::fromBase64(std::string_view base64) noexcept
             return nf::result::Err{};
         };
 
-        auto decoded =
-            ByteArray(boost::make_transform_iterator(FromBase64Iter(std::begin(base64)),
-                                                     charToByte),
-                      boost::make_transform_iterator(FromBase64Iter(std::end(base64)), charToByte));
-        return decoded.erase(decoded.size() - numPadding);
+        ByteArray decoded;
+        decoded.m_data.resize(detail::base64DecodedSize(sizeWithoutPadding));
+        const auto decodedSize =
+            detail::decodeBase64(base64.data(), sizeWithoutPadding, decoded.m_data.data());
+        if (!decodedSize) {
+            nf::error("Unable to decode Base64 string: Illegal character or length");
+            return nf::result::Err{};
+        }
+
+        decoded.m_data.resize(*decodedSize);
+        return decoded;
     } catch (const std::exception &exc) {
         nf::error("Unable to decode Base64 string: {}", exc.what());
         return nf::result::Err{};
@@ -370,13 +378,14 @@ void ByteArray::swap(ByteArray &other) noexcept
 
 std::string ByteArray::toBase64() const noexcept
 {
-    using namespace boost::archive::iterators;
-    const auto byteToChar = [](const std::byte &byte) -> char { return static_cast<char>(byte); };
-
-    auto toCharBegin = boost::make_transform_iterator(cbegin(), byteToChar);
-    auto toCharEnd = boost::make_transform_iterator(cend(), byteToChar);
-    using ToBase64Iter = base64_from_binary<transform_width<decltype(toCharBegin), 6, 8>>;
+    auto result = std::string(detail::base64EncodedSize(m_data.size()), '\0');
+    detail::encodeBase64(m_data.data(), m_data.size(), result.data());
+    return result;
+}
 
-    auto result = std::string{ToBase64Iter(toCharBegin), ToBase64Iter(toCharEnd)};
-    return result.append((3 - m_data.size() % 3) % 3, '=');
+std::string ByteArray::toHex() const noexcept
+{
+    auto result = std::string(2 * m_data.size(), '\0');
+    detail::encodeHex(m_data.data(), m_data.size(), result.data());
+    return result;
 }
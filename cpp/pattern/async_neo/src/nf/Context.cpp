@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -27,8 +27,9 @@ Context::Context(const std::shared_ptr<Executor> &executor) noexcept
                "Context cannot be created with a null executor. Is framework initialized?");
 }
 
-void Context::post(Task &&task) const noexcept
+void Context::post(Task &&task, const source_location &location) const noexcept
 {
+    detail::PostSite site(location);
     m_state->post(std::move(task));
 }
 
@@ -37,6 +38,19 @@ void Context::post(Executor::Delay when, Task &&task) const noexcept
     m_state->post(when, std::move(task));
 }
 
+void Context::post(Executor::Priority priority, Task &&task,
+                   const source_location &location) const noexcept
+{
+    detail::PostSite site(location);
+    m_state->post(priority, std::move(task));
+}
+
+void Context::postBatch(std::vector<Task> &&tasks, const source_location &location) const noexcept
+{
+    detail::PostSite site(location);
+    m_state->postBatch(std::move(tasks));
+}
+
 void Context::bind(Subscription &&sub) const noexcept
 {
     m_state->bind(std::move(sub));
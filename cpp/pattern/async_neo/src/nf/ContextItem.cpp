@@ -16,6 +16,8 @@
 
 using namespace nf;
 
+static_assert(std::is_same_v<ContextItem::Iterator, detail::ContextState::ItemIterator>);
+
 ContextItem::ContextItem() noexcept = default;
 ContextItem::~ContextItem() = default;
 
@@ -47,6 +49,14 @@ void ContextItem::post(Task &&task) noexcept
     }
 }
 
+std::shared_ptr<Executor> ContextItem::executor() const noexcept
+{
+    if (auto state = m_state.lock()) {
+        return state->m_executor;
+    }
+    return nullptr;
+}
+
 void nf::detail::bind(const Context &context, std::shared_ptr<ContextItem> item) noexcept
 {
     context.bind(std::move(item));
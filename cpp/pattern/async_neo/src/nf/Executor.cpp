@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2018-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2018-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -16,8 +16,10 @@
 #include <nf/Framework.h>
 #include <nf/Logging.h>
 #include <nf/RaiiToken.h>
+#include <nf/detail/TaskMonitor.h>
 
 #include <mutex>
+#include <ostream>
 
 using namespace nf;
 
@@ -84,6 +86,11 @@ Executor::Executor() noexcept
 {
 }
 
+Executor::~Executor()
+{
+    delete m_taskMonitor.load();
+}
+
 void Executor::setExceptionHandler(ExceptionHandler handler)
 {
     m_exceptionHandler = std::move(handler);
@@ -120,7 +127,87 @@ void Executor::post(Delay delay, Task &&task) noexcept
     postImpl(delay, std::move(task));
 }
 
+void Executor::postBatch(std::vector<Task> &&tasks) noexcept
+{
+    for (auto &task : tasks) {
+        post(std::move(task));
+    }
+}
+
+void Executor::post(Priority priority, Task &&task, const source_location &location) noexcept
+{
+    detail::PostSite site(location);
+    postToLane(priority, std::move(task));
+}
+
+std::size_t Executor::queueDepth(Priority /*priority*/) const noexcept
+{
+    return 0;
+}
+
+void Executor::postToLane(Priority /*priority*/, Task &&task) noexcept
+{
+    post(std::move(task));
+}
+
 bool Executor::isThisThread() const noexcept
 {
     return std::this_thread::get_id() == m_threadId;
 }
+
+void Executor::enableStatistics(std::chrono::microseconds slowTaskThreshold) noexcept
+{
+    if (auto *monitor = m_taskMonitor.load(std::memory_order_acquire)) {
+        monitor->setSlowTaskThreshold(slowTaskThreshold);
+        return;
+    }
+
+    auto monitor = std::make_unique<detail::TaskMonitor>(*this, slowTaskThreshold);
+    detail::TaskMonitor *expected = nullptr;
+    if (m_taskMonitor.compare_exchange_strong(expected, monitor.get())) {
+        monitor.release();
+    } else {
+        expected->setSlowTaskThreshold(slowTaskThreshold);
+    }
+}
+
+std::optional<Executor::Statistics> Executor::statistics() const noexcept
+{
+    const auto *monitor = m_taskMonitor.load(std::memory_order_acquire);
+    if (!monitor) {
+        return std::nullopt;
+    }
+
+    auto statistics = monitor->statistics();
+    for (auto priority : {Priority::High, Priority::Normal, Priority::Background}) {
+        statistics.queuedPerPriority[static_cast<std::size_t>(priority)] = queueDepth(priority);
+    }
+    return statistics;
+}
+
+void Executor::instrumentImpl(Task &task) noexcept
+{
+    m_taskMonitor.load(std::memory_order_relaxed)->wrap(task);
+}
+
+NF_BEGIN_NAMESPACE
+
+std::ostream &operator<<(std::ostream &os, const Executor::Statistics &statistics) noexcept
+{
+    const auto print = [&os](const char *name, const Executor::Statistics::Durations &durations) {
+        const auto us = [](std::chrono::nanoseconds ns) { return ns.count() / 1000.0; };
+        os << name << " " << durations.count << " tasks, mean " << us(durations.mean)
+           << "us, p50 " << us(durations.p50) << "us, p99 " << us(durations.p99) << "us, max "
+           << us(durations.max) << "us";
+    };
+
+    const auto &lanes = statistics.queuedPerPriority;
+    os << "queued " << statistics.queued << " (high " << lanes[0] << ", normal " << lanes[1]
+       << ", background " << lanes[2] << "), slow " << statistics.slowTasks << "; ";
+    print("queue wait", statistics.queueWait);
+    os << "; ";
+    print("run time", statistics.runTime);
+    return os;
+}
+
+NF_END_NAMESPACE
@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2019-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2019-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -20,6 +20,8 @@
 #include <nf/Singleton.h>
 #include <nf/Timer.h>
 #include <nf/backend/AsioExecutor.h>
+#include <nf/backend/EpollExecutor.h>
+#include <nf/backend/UringExecutor.h>
 
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/steady_timer.hpp>
@@ -75,3 +77,26 @@ std::shared_ptr<Executor> AsioFramework::makeExecutor() noexcept
 {
     return std::make_shared<backend::AsioExecutor>();
 }
+
+std::shared_ptr<Executor> EpollFramework::makeExecutor() noexcept
+{
+    return std::make_shared<backend::EpollExecutor>();
+}
+
+std::shared_ptr<Executor> UringFramework::makeExecutor() noexcept
+{
+    static const bool isSupported = [] {
+        const bool isSupported = backend::UringExecutor::isSupported();
+        if (!isSupported) {
+            nf::warn("io_uring is not supported, falling back to epoll");
+        }
+        return isSupported;
+    }();
+
+    /* UringExecutor is an EpollExecutor with a ring, so without the ring it is the epoll
+     * backend which keeps the behaviour of the executor, e.g. its lock-free task queue. */
+    if (!isSupported) {
+        return std::make_shared<backend::EpollExecutor>();
+    }
+    return std::make_shared<backend::UringExecutor>();
+}
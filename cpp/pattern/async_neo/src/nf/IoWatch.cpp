@@ -24,10 +24,11 @@ std::unique_ptr<IoWatch> IoWatch::construct(int fd, std::int16_t events, Task &&
     return Executor::thisThread()->makeIoWatch(fd, events, std::move(task));
 }
 
-IoWatch::IoWatch(int fd, std::int16_t events, Task &&task) noexcept
+IoWatch::IoWatch(Executor &executor, int fd, std::int16_t events, Task &&task) noexcept
     : m_task(std::move(task))
     , m_fd(fd)
     , m_events(events)
+    , m_executor(executor)
     , m_isActive(false)
 {
     nf::verbose("I/O watch {} created with fd={} and events={}", fmt::ptr(this), fd, events);
@@ -38,6 +39,16 @@ IoWatch::~IoWatch()
     nf::verbose("I/O watch {} destroyed", fmt::ptr(this));
 }
 
+void IoWatch::setPriority(Executor::Priority priority) noexcept
+{
+    m_priority = priority;
+}
+
+Executor::Priority IoWatch::priority() const noexcept
+{
+    return m_priority;
+}
+
 bool IoWatch::isActive() const noexcept
 {
     return m_isActive;
@@ -54,6 +65,22 @@ bool IoWatch::isWriteWatch() const noexcept
 }
 
 void IoWatch::notify() noexcept
+{
+    if (m_priority == Executor::Priority::High) {
+        dispatch();
+        return;
+    }
+
+    /* The watch stays active while its task waits in the lane, so that start() does not
+     * watch again and stop() drops the task. */
+    m_isActive = true;
+    m_executor.post(m_priority, m_laneScope.bind([this] {
+        m_isActive = false;
+        dispatch();
+    }));
+}
+
+void IoWatch::dispatch() noexcept
 {
     /* Sanity check that a type of m_events match a type accepted by poll(). This is needed
      * because we cannot use "short" as it is not safe and clang-tidy complains about it. */
@@ -96,6 +123,7 @@ void IoWatch::stop() noexcept
 {
     if (m_isActive) {
         nf::verbose("Stopping an I/O watch {}", fmt::ptr(this));
+        m_laneScope.reset();
         stopWatch();
     }
 }
@@ -63,6 +63,8 @@ namespace {
 class FallbackLogger : public backend::MemoryLogger
 {
 public:
+    FallbackLogger() noexcept;
+
     void write(const LogContext &context, LogLevel level,
                const std::string &message) noexcept override;
     void write(const LogEntry &logEntry) noexcept override;
@@ -85,6 +87,7 @@ public:
 public:
     void suspendOutput() noexcept override;
     void resumeOutput() noexcept override;
+    void flush() noexcept override;
 
 public:
     std::optional<std::shared_ptr<LogBackend>> get(const std::type_info &backendType,
@@ -127,6 +130,8 @@ public:
 public:
     bool appliesTo(const char *msgContextId, LogLevel msgLevel,
                    const char *msgFileName) const noexcept;
+    // Index of the most severe level suppressed for the whole context, see LogContext
+    int suppressedFrom(const char *contextId) const noexcept;
 
 private:
     std::vector<LogFilterRule> m_filters;
@@ -160,6 +165,7 @@ private:
     // Methods to maintain the invariant
     void setBackendManager(std::unique_ptr<LogBackendManager> &&backends);
     void resetBackendManager();
+    void updateSuppressedLevels() noexcept;
 
 private:
     std::unique_ptr<LogFilterRuleManager> m_filters = std::make_unique<LogFilterRuleManager>();
@@ -209,6 +215,13 @@ void LogBackendManager::resumeOutput() noexcept
     }
 }
 
+void LogBackendManager::flush() noexcept
+{
+    for (auto &backend : m_backends) {
+        backend->flush();
+    }
+}
+
 std::optional<std::shared_ptr<LogBackend>> LogBackendManager::get(const std::type_info &backendType,
                                                                   std::size_t index) const noexcept
 {
@@ -257,6 +270,19 @@ bool LogFilterRuleManager::appliesTo(const char *msgContextId, LogLevel msgLevel
                        });
 }
 
+int LogFilterRuleManager::suppressedFrom(const char *contextId) const noexcept
+{
+    int result = _nf_enum_LogLevel::size;
+    for (const auto &filter : m_filters) {
+        // Rules for a file cannot be evaluated without a message, they are checked on writing
+        const bool isForContext = filter.contextId.empty() || filter.contextId == contextId;
+        if (filter.fileName.empty() && isForContext) {
+            result = std::min(result, static_cast<int>(_nf_enum_LogLevel::idx(filter.maxLevel)));
+        }
+    }
+    return result;
+}
+
 std::vector<LogContext *> LoggingSubsystem::contexts() const noexcept
 {
     std::vector<LogContext *> result;
@@ -296,6 +322,7 @@ void LoggingSubsystem::initialize(std::unique_ptr<LogFilterRuleManager> &&filter
 {
     const bool initialized = isInitialized();
     m_filters = std::move(filters);
+    updateSuppressedLevels();
     setBackendManager(std::move(backends));
 
     /* The next code serves two purposes. First, it checks if the current thread is the
@@ -324,6 +351,8 @@ bool LoggingSubsystem::addContext(LogContext *context)
         return false;
     }
 
+    context->suppressedFrom = m_filters->suppressedFrom(context->id);
+
     if (m_backends) {
         m_backends->registerContext(*context);
     }
@@ -339,6 +368,7 @@ void LoggingSubsystem::terminate() noexcept
 {
     resetBackendManager();
     m_filters = std::make_unique<LogFilterRuleManager>();
+    updateSuppressedLevels();
 }
 
 void LoggingSubsystem::setBackendManager(std::unique_ptr<LogBackendManager> &&backends)
@@ -353,12 +383,25 @@ void LoggingSubsystem::resetBackendManager()
     m_backends.reset();
 }
 
+void LoggingSubsystem::updateSuppressedLevels() noexcept
+{
+    for (auto &[id, context] : m_contexts) {
+        context->suppressedFrom = m_filters->suppressedFrom(id.c_str());
+    }
+}
+
 LoggingSubsystem &instance()
 {
     static LoggingSubsystem s_subsystem;
     return s_subsystem;
 }
 
+/* Long startups must not grow the memory, only the latest messages are kept. */
+FallbackLogger::FallbackLogger() noexcept
+    : MemoryLogger(64 * 1024)
+{
+}
+
 void FallbackLogger::write(const LogContext &context, LogLevel level,
                            const std::string &message) noexcept
 {
@@ -373,12 +416,16 @@ void FallbackLogger::write(const LogEntry &logEntry) noexcept
 
 void FallbackLogger::logBufferedMessages() const noexcept
 {
-    if (m_logEntries.empty()) {
+    const auto logEntries = this->logEntries();
+    if (logEntries.empty()) {
         return;
     }
 
     nf::warn("These messages were logged before logging was initialized:");
-    for (const auto &logEntry : m_logEntries) {
+    if (const auto cntOverwritten = overwrittenCount(); cntOverwritten > 0) {
+        nf::warn(" ==> {} earlier messages were dropped", cntOverwritten);
+    }
+    for (const auto &logEntry : logEntries) {
         nf::log(ActiveLogContext, logEntry.logLevel, " ==> [{}] {}", logEntry.logContext.id,
                 logEntry.message);
     }
@@ -427,6 +474,7 @@ LogContext::LogContext(const char *id, const char *desc) noexcept
     : id(id)
     , desc(desc)
     , data(nullptr)
+    , suppressedFrom(_nf_enum_LogLevel::size)
 {
 
     const bool isInserted = instance().addContext(this);
@@ -460,6 +508,10 @@ bool LogBackend::isSuspended() const noexcept
     return false;
 }
 
+void LogBackend::flush() noexcept
+{
+}
+
 LogFilterRule LogFilterRule::suppressContext(std::string contextId, LogLevel maxLevel,
                                              std::string fileName) noexcept
 {
@@ -551,11 +603,6 @@ std::vector<std::shared_ptr<LogBackend>> Logging::logBackends() noexcept
     return {};
 }
 
-bool Logging::isEnabled(const LogContext & /*context*/, LogLevel /*level*/) noexcept
-{
-    return true;
-}
-
 void Logging::write(const LogContext &context, LogLevel level, const std::ostringstream &message,
                     const char *fileName, const char *funcName, int line) noexcept
 {
@@ -588,6 +635,13 @@ void Logging::resumeOutput() noexcept
     instance().backends()->resumeOutput();
 }
 
+void Logging::flush() noexcept
+{
+    if (instance().isInitialized()) {
+        instance().backends()->flush();
+    }
+}
+
 void detail::log(const LogContext &context, LogLevel level, fmt::string_view format,
                  fmt::format_args args, const source_location &location) noexcept
 {
@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -14,6 +14,14 @@
 #include <nf/Logging.h>
 #include <nf/RaiiToken.h>
 
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 using namespace nf;
 
 #define RWLOCK_DEBUG(__msg) RWLOCK_DEBUG_F(__msg, NULL)
@@ -26,6 +34,8 @@ namespace detail {
 struct RwLockWaiter
 {
     bool isReader{true};
+    bool isAdmitted{false};
+    std::shared_ptr<Executor> executor;
     RwLock::OnLockAcquired cb;
 };
 
@@ -34,22 +44,223 @@ std::ostream &operator<<(std::ostream &os, const RwLockWaiter &waiter) noexcept
     return os << (waiter.isReader ? "Reader" : "Writer") << "@" << &waiter;
 }
 
+/*
+ * The holders of the lock are counted in an atomic, so that a free lock is acquired and
+ * released without taking the mutex. The mutex guards the waiters only. Whoever releases the
+ * lock last checks for pending waiters, and an added waiter checks for the lock being released
+ * in the meantime. Both sides use sequentially consistent operations, so at least one of them
+ * notices the other.
+ *
+ * The state is reference-counted by hand: the lock and every token hold a reference. A token
+ * captures only raw pointers, which the std::function of the RaiiToken stores without
+ * allocating.
+ */
+class RwLockState
+{
+public:
+    using Waiter = RwLockWaiter;
+    using Waiters = std::list<std::shared_ptr<Waiter>>;
+
+public:
+    void ref() noexcept
+    {
+        m_cntRefs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void unref() noexcept
+    {
+        if (m_cntRefs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    void close() noexcept
+    {
+        std::unique_lock lock(m_mutex);
+        m_isClosed = true;
+        m_waiters.clear();
+        m_cntPending = 0;
+    }
+
+    bool tryAcquire(bool isReader) noexcept
+    {
+        auto holders = m_holders.load();
+        do {
+            if (holders == kWriter || (!isReader && holders != 0)) {
+                return false;
+            }
+        } while (!m_holders.compare_exchange_weak(holders, isReader ? holders + 1 : kWriter));
+        return true;
+    }
+
+    void release(bool isReader) noexcept
+    {
+        if (!isReader) {
+            m_holders.store(0);
+        } else if (m_holders.fetch_sub(1) != 1) {
+            return;
+        }
+
+        if (m_cntPending.load() > 0) {
+            wakeUpNext();
+        }
+    }
+
+    RaiiToken addLock(bool isReader, RwLock::OnLockAcquired &cb) noexcept
+    {
+        auto waiter = std::make_shared<Waiter>();
+        waiter->isReader = isReader;
+        waiter->executor = Executor::thisThread();
+        waiter->cb = std::move(cb);
+
+        RWLOCK_DEBUG_F("Add {}", *waiter);
+
+        std::unique_lock lock(m_mutex);
+        const auto it = m_waiters.insert(m_waiters.end(), waiter);
+        ++m_cntPending;
+        if (tryAcquire(isReader)) {
+            --m_cntPending;
+            waiter->isAdmitted = true;
+            RWLOCK_DEBUG_F("Schedule {}", *waiter);
+            waiter->executor->post(makeTask(waiter));
+        }
+        lock.unlock();
+
+        ref();
+        return RaiiToken::nonDismissible([this, it] {
+            removeLock(it);
+            unref();
+        });
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const RwLockState &state) noexcept
+    {
+        os << "RwLock(";
+        if (const auto holders = state.m_holders.load(); holders == kWriter) {
+            os << "W)";
+        } else {
+            os << holders << ")";
+        }
+        return os << "@" << &state;
+    }
+
+private:
+    static constexpr int kWriter = -1;
+
+    static Executor::Task makeTask(const std::shared_ptr<Waiter> &waiter) noexcept
+    {
+        return [cb = std::move(waiter->cb), weakWaiter = std::weak_ptr(waiter)]() mutable {
+            if (auto waiter = weakWaiter.lock()) {
+                cb();
+            }
+        };
+    }
+
+    void removeLock(Waiters::iterator it) noexcept
+    {
+        std::unique_lock lock(m_mutex);
+        if (m_isClosed) {
+            return;
+        }
+
+        const auto &waiter = *it;
+        const bool isAdmitted = waiter->isAdmitted;
+        const bool isReader = waiter->isReader;
+        RWLOCK_DEBUG_F("Remove {}", *waiter);
+        if (!isAdmitted) {
+            --m_cntPending;
+        }
+        m_waiters.erase(it);
+        lock.unlock();
+
+        if (isAdmitted) {
+            release(isReader);
+        }
+    }
+
+    void wakeUpNext() noexcept
+    {
+        std::vector<std::pair<std::shared_ptr<Executor>, std::vector<Executor::Task>>> batches;
+
+        std::unique_lock lock(m_mutex);
+        const auto isPending = [](const auto &waiter) { return !waiter->isAdmitted; };
+        const auto first = std::find_if(m_waiters.begin(), m_waiters.end(), isPending);
+        if (first == m_waiters.end()) {
+            RWLOCK_DEBUG("Exhausted");
+            return;
+        }
+
+        /* Either all pending readers or the first pending writer acquire the lock. */
+        const bool isReader = (*first)->isReader;
+        if (isReader) {
+            const auto cntReaders = std::count_if(first, m_waiters.end(), [](const auto &waiter) {
+                return !waiter->isAdmitted && waiter->isReader;
+            });
+            auto holders = m_holders.load();
+            do {
+                if (holders == kWriter) {
+                    return;
+                }
+            } while (!m_holders.compare_exchange_weak(holders,
+                                                      holders + static_cast<int>(cntReaders)));
+        } else if (!tryAcquire(false)) {
+            return;
+        }
+
+        RWLOCK_DEBUG("About to wake up more waiters");
+        for (auto it = first; it != m_waiters.end(); ++it) {
+            auto &waiter = *it;
+            if (waiter->isAdmitted || waiter->isReader != isReader) {
+                continue;
+            }
+
+            waiter->isAdmitted = true;
+            --m_cntPending;
+            RWLOCK_DEBUG_F("Schedule {}", *waiter);
+
+            /* The readers usually share one executor, so they are posted as one batch. */
+            auto batch = std::find_if(batches.begin(), batches.end(), [&](const auto &batch) {
+                return batch.first == waiter->executor;
+            });
+            if (batch == batches.end()) {
+                batch = batches.emplace(batches.end(), waiter->executor,
+                                        std::vector<Executor::Task>());
+            }
+            batch->second.push_back(makeTask(waiter));
+
+            if (!isReader) {
+                break;
+            }
+        }
+        lock.unlock();
+
+        for (auto &[executor, tasks] : batches) {
+            executor->postBatch(std::move(tasks));
+        }
+    }
+
+private:
+    std::atomic<int> m_cntRefs{1};
+    /* The number of readers holding the lock, or kWriter. */
+    std::atomic<int> m_holders{0};
+    std::atomic<int> m_cntPending{0};
+
+    std::mutex m_mutex;
+    Waiters m_waiters;
+    bool m_isClosed{false};
+};
+
 } // namespace detail
 
 std::ostream &operator<<(std::ostream &os, const RwLock &rwLock) noexcept
 {
-    os << "RwLock(";
-    if (rwLock.m_hasWriter) {
-        os << "W)";
-    } else {
-        os << rwLock.m_cntReaders << ")";
-    }
-    return os << "@" << &rwLock;
+    return os << *rwLock.m_state;
 }
 
 NF_END_NAMESPACE
 
 RwLock::RwLock() noexcept
+    : m_state(new detail::RwLockState)
 {
     RWLOCK_DEBUG("Construct");
 }
@@ -57,97 +268,42 @@ RwLock::RwLock() noexcept
 RwLock::~RwLock()
 {
     RWLOCK_DEBUG("Destroy");
-    std::unique_lock lock(m_mutex);
-    m_waiters.clear();
+    m_state->close();
+    m_state->unref();
 }
 
 RaiiToken RwLock::lockRead(OnLockAcquired cb) noexcept
 {
-    return addLock(true, cb);
+    return m_state->addLock(true, cb);
 }
 
 RaiiToken RwLock::lockWrite(OnLockAcquired cb) noexcept
 {
-    return addLock(false, cb);
-}
-
-void RwLock::wakeUp(Waiter &waiter) noexcept
-{
-    if (waiter.isReader) {
-        m_cntReaders++;
-    } else {
-        m_hasWriter = true;
-    }
-    RWLOCK_DEBUG_F("Schedule {}", waiter);
-    waiter.cb();
-    waiter.cb = nullptr;
+    return m_state->addLock(false, cb);
 }
 
-RaiiToken RwLock::addLock(bool isReader, OnLockAcquired &cb) noexcept
+std::optional<RaiiToken> RwLock::tryLockRead() noexcept
 {
-    auto waiter = std::make_shared<Waiter>();
-    waiter->isReader = isReader;
-    waiter->cb = [cb = std::move(cb), executor = Executor::thisThread(),
-                  weakWaiter = std::weak_ptr(waiter)]() mutable {
-        executor->post([cb = std::move(cb), weakWaiter = std::move(weakWaiter)]() mutable {
-            if (auto waiter = weakWaiter.lock()) {
-                cb();
-            }
-        });
-    };
-
-    RWLOCK_DEBUG_F("Add {}", *waiter);
-
-    std::unique_lock lock(m_mutex);
-    m_waiters.push_back(waiter);
-
-    if (!m_hasWriter && (isReader || m_cntReaders == 0)) {
-        wakeUp(*waiter);
+    if (!m_state->tryAcquire(true)) {
+        return std::nullopt;
     }
 
-    return RaiiToken::nonDismissible(
-        m_context.bind([this, it = std::prev(m_waiters.end())] { removeLock(it); }));
+    m_state->ref();
+    return RaiiToken::nonDismissible([state = m_state] {
+        state->release(true);
+        state->unref();
+    });
 }
 
-void RwLock::removeLock(Waiters::iterator it) noexcept
+std::optional<RaiiToken> RwLock::tryLockWrite() noexcept
 {
-    const auto *waiter = it->get();
-    const bool isWokenUp = waiter->cb == nullptr;
-    const bool isReader = waiter->isReader;
-
-    std::unique_lock lock(m_mutex);
-
-    RWLOCK_DEBUG_F("Remove {}", *waiter);
-    m_waiters.erase(it);
-
-    if (isWokenUp) {
-        if (isReader) {
-            if (--m_cntReaders == 0) {
-                wakeUpNext();
-            }
-        } else {
-            m_hasWriter = false;
-            wakeUpNext();
-        }
+    if (!m_state->tryAcquire(false)) {
+        return std::nullopt;
     }
-}
 
-void RwLock::wakeUpNext() noexcept
-{
-    if (m_waiters.empty()) {
-        RWLOCK_DEBUG("Exhausted");
-        return;
-    }
-
-    RWLOCK_DEBUG("About to wake up more waiters");
-    auto &waiter = m_waiters.front();
-    if (waiter->isReader) {
-        for (auto &waiter : m_waiters) {
-            if (waiter->isReader) {
-                wakeUp(*waiter);
-            }
-        }
-    } else {
-        wakeUp(*waiter);
-    }
+    m_state->ref();
+    return RaiiToken::nonDismissible([state = m_state] {
+        state->release(false);
+        state->unref();
+    });
 }
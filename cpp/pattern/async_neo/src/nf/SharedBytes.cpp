@@ -0,0 +1,149 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/SharedBytes.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace nf;
+
+SharedBytes::SharedBytes(ByteArray &&bytes)
+    : m_storage{std::make_shared<const ByteArray::Container>(std::move(bytes.m_data))}
+    , m_data{m_storage->data()}
+    , m_size{m_storage->size()}
+{
+    bytes.clear();
+}
+
+SharedBytes::SharedBytes(const ByteArray &bytes)
+    : SharedBytes(ByteArray{bytes})
+{
+}
+
+SharedBytes::SharedBytes(std::shared_ptr<const ByteArray::Container> storage, View view) noexcept
+    : m_storage{std::move(storage)}
+    , m_data{view.data()}
+    , m_size{view.size()}
+{
+}
+
+ByteArray SharedBytes::toByteArray() const
+{
+    return ByteArray{cbegin(), cend()};
+}
+
+const std::byte *SharedBytes::data() const noexcept
+{
+    return m_data;
+}
+
+SharedBytes::ConstIterator SharedBytes::begin() const noexcept
+{
+    return m_data;
+}
+
+SharedBytes::ConstIterator SharedBytes::end() const noexcept
+{
+    return m_data + m_size;
+}
+
+SharedBytes::ConstIterator SharedBytes::cbegin() const noexcept
+{
+    return begin();
+}
+
+SharedBytes::ConstIterator SharedBytes::cend() const noexcept
+{
+    return end();
+}
+
+std::size_t SharedBytes::size() const noexcept
+{
+    return m_size;
+}
+
+bool SharedBytes::isEmpty() const noexcept
+{
+    return m_size == 0;
+}
+
+std::byte SharedBytes::operator[](std::size_t index) const noexcept
+{
+    return m_data[index];
+}
+
+std::byte SharedBytes::at(std::size_t index) const noexcept(false)
+{
+    if (index >= m_size) {
+        throw std::out_of_range("SharedBytes index is out of range");
+    }
+    return m_data[index];
+}
+
+SharedBytes SharedBytes::mid(std::size_t index) const noexcept(false)
+{
+    return mid(index, m_size);
+}
+
+SharedBytes SharedBytes::mid(std::size_t index, std::size_t length) const noexcept(false)
+{
+    /* substr() checks the index just like ByteArray::mid() does, but copies nothing. */
+    return {m_storage, view().substr(index, length)};
+}
+
+SharedBytes SharedBytes::first(std::size_t count) const noexcept
+{
+    return {m_storage, view().substr(0, count)};
+}
+
+SharedBytes SharedBytes::last(std::size_t count) const noexcept
+{
+    const auto actualCount = std::min(count, m_size);
+    return {m_storage, view().substr(m_size - actualCount, actualCount)};
+}
+
+bool SharedBytes::startsWith(const SharedBytes &other) const noexcept
+{
+    return view().substr(0, other.m_size) == other.view();
+}
+
+bool SharedBytes::endsWith(const SharedBytes &other) const noexcept
+{
+    return m_size >= other.m_size && view().substr(m_size - other.m_size) == other.view();
+}
+
+bool SharedBytes::contains(const SharedBytes &other) const noexcept
+{
+    return view().find(other.view()) != View::npos;
+}
+
+bool SharedBytes::matches(std::size_t index, const SharedBytes &other) const noexcept
+{
+    if (index >= m_size) {
+        return false;
+    }
+    return view().substr(index, other.m_size) == other.view();
+}
+
+bool SharedBytes::operator==(const SharedBytes &other) const noexcept
+{
+    return view() == other.view();
+}
+
+bool SharedBytes::operator!=(const SharedBytes &other) const noexcept
+{
+    return view() != other.view();
+}
+
+SharedBytes::View SharedBytes::view() const noexcept
+{
+    return {m_data, m_size};
+}
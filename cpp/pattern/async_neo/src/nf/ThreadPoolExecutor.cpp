@@ -0,0 +1,572 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/ThreadPoolExecutor.h"
+
+#include <nf/Assert.h>
+#include <nf/IoWatch.h>
+#include <nf/Logging.h>
+#include <nf/RaiiToken.h>
+#include <nf/Timer.h>
+#include <nf/detail/WorkStealingDeque.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+using namespace nf;
+
+namespace {
+
+/* The pool and the index of the worker running in this thread. */
+thread_local const ThreadPoolExecutor *t_pool = nullptr; // NOLINT
+thread_local std::size_t t_workerIndex = 0;              // NOLINT
+
+/* Set if a task of this worker destroyed the pool. The worker must not touch it any more. */
+thread_local bool t_isOrphaned = false; // NOLINT
+
+/* The maximum number of tasks a worker takes at once from the tasks posted by other threads. */
+constexpr std::size_t kInjectedBatch = 16;
+
+/* The number of times an idle worker looks for tasks before it goes to sleep. */
+constexpr int kSpinRounds = 64;
+
+std::string describe(const std::exception_ptr &eptr) noexcept
+{
+    try {
+        std::rethrow_exception(eptr);
+    } catch (const std::exception &ex) {
+        return ex.what();
+    } catch (...) {
+        return "unknown exception";
+    }
+}
+
+/*
+ * Runs the tasks of a strand one after another in the pool. Only one task draining the strand
+ * is posted to the pool at a time.
+ */
+class Strand final : public Executor, public std::enable_shared_from_this<Strand>
+{
+public:
+    Strand(const std::shared_ptr<ThreadPoolExecutor> &pool,
+           std::shared_ptr<Executor> reactor) noexcept
+        : m_pool(pool)
+        , m_reactor(std::move(reactor))
+    {
+    }
+
+public:
+    void post(Task &&task) noexcept override
+    {
+        instrument(task);
+        std::unique_lock lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+        if (!std::exchange(m_isScheduled, true)) {
+            lock.unlock();
+            schedule();
+        }
+    }
+
+    void postBatch(std::vector<Task> &&tasks) noexcept override
+    {
+        if (tasks.empty()) {
+            return;
+        }
+
+        for (auto &task : tasks) {
+            instrument(task);
+        }
+
+        std::unique_lock lock(m_mutex);
+        std::move(tasks.begin(), tasks.end(), std::back_inserter(m_tasks));
+        if (!std::exchange(m_isScheduled, true)) {
+            lock.unlock();
+            schedule();
+        }
+    }
+
+    std::unique_ptr<Timer> makeTimer(Interval interval, TimerTask &&task) noexcept override
+    {
+        return m_reactor->makeTimer(interval, std::move(task));
+    }
+
+    std::unique_ptr<IoWatch> makeIoWatch(int fd, std::int16_t events,
+                                         IoWatchTask &&task) noexcept override
+    {
+        return m_reactor->makeIoWatch(fd, events, std::move(task));
+    }
+
+    bool setSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override
+    {
+        return m_reactor->setSignalHandlers(std::move(signalHandlers));
+    }
+
+    bool appendSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept override
+    {
+        return m_reactor->appendSignalHandlers(std::move(signalHandlers));
+    }
+
+    /* A strand has no event loop of its own, so it stops the pool. */
+    void stop() noexcept override
+    {
+        stop(EXIT_SUCCESS);
+    }
+
+    void stop(int exitCode) noexcept override
+    {
+        if (auto pool = m_pool.lock()) {
+            pool->stop(exitCode);
+        }
+    }
+
+    std::chrono::milliseconds now() const noexcept override
+    {
+        return m_reactor->now();
+    }
+
+private:
+    int runImpl() override
+    {
+        if (auto pool = m_pool.lock()) {
+            return pool->run();
+        }
+        return EXIT_SUCCESS;
+    }
+
+    void postImpl(Delay delay, Task &&task) noexcept override
+    {
+        if (delay == Delay::zero()) {
+            post(std::move(task));
+            return;
+        }
+
+        m_reactor->post(delay, [wSelf = weak_from_this(), task = std::move(task)]() mutable {
+            if (auto self = wSelf.lock()) {
+                self->post(std::move(task));
+            }
+        });
+    }
+
+    void discardAllPostedEvents() noexcept override
+    {
+        std::deque<Task> tasks;
+        std::unique_lock lock(m_mutex);
+        tasks.swap(m_tasks);
+        lock.unlock();
+    }
+
+    void schedule() noexcept
+    {
+        /* The strand does not keep the pool alive, otherwise its tasks queued in a stopped pool
+         * would keep both of them alive. */
+        if (auto pool = m_pool.lock()) {
+            pool->post([self = shared_from_this()] { self->drain(); });
+        }
+    }
+
+    void drain()
+    {
+        std::deque<Task> tasks;
+        std::unique_lock lock(m_mutex);
+        tasks.swap(m_tasks);
+        lock.unlock();
+
+        for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+            try {
+                (*it)();
+            } catch (...) {
+                /* The remaining tasks keep their place in front of the newer ones. */
+                lock.lock();
+                m_tasks.insert(m_tasks.begin(), std::make_move_iterator(std::next(it)),
+                               std::make_move_iterator(tasks.end()));
+                lock.unlock();
+                schedule();
+                throw;
+            }
+        }
+
+        /* Tasks posted meanwhile are drained by a new task, so that the strand does not keep a
+         * worker busy for too long. */
+        lock.lock();
+        if (m_tasks.empty()) {
+            m_isScheduled = false;
+            return;
+        }
+        lock.unlock();
+        schedule();
+    }
+
+private:
+    const std::weak_ptr<ThreadPoolExecutor> m_pool;
+    const std::shared_ptr<Executor> m_reactor;
+
+    std::mutex m_mutex;
+    std::deque<Task> m_tasks;
+    bool m_isScheduled{false};
+};
+
+} // anonymous namespace
+
+struct ThreadPoolExecutor::Worker
+{
+    detail::WorkStealingDeque<Task> tasks;
+    std::thread thread;
+    std::uint32_t seed{0};
+};
+
+std::shared_ptr<ThreadPoolExecutor>
+ThreadPoolExecutor::create(std::size_t threadCount,
+                           const std::shared_ptr<Executor> &reactor) noexcept
+{
+    return std::shared_ptr<ThreadPoolExecutor>(new ThreadPoolExecutor(threadCount, reactor));
+}
+
+ThreadPoolExecutor::ThreadPoolExecutor(std::size_t threadCount,
+                                       const std::shared_ptr<Executor> &reactor) noexcept
+    : m_reactor(reactor)
+{
+    assertThat(m_reactor != nullptr, "A thread pool requires a reactor");
+
+    if (threadCount == 0) {
+        threadCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    /* All workers must exist before any of them starts to steal. */
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->seed = static_cast<std::uint32_t>(i + 1) * 2654435761U;
+    }
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        m_workers[i]->thread = std::thread([this, i] {
+            t_pool = this;
+            t_workerIndex = i;
+            work(*m_workers[i]);
+        });
+    }
+
+    nf::info("Started a thread pool {} with {} threads", fmt::ptr(this), threadCount);
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor()
+{
+    stop();
+    for (auto &worker : m_workers) {
+        if (worker->thread.get_id() == std::this_thread::get_id()) {
+            /* A task of this worker released the last reference to the pool. */
+            t_isOrphaned = true;
+            worker->thread.detach();
+        } else {
+            worker->thread.join();
+        }
+    }
+    discardTasks();
+}
+
+void ThreadPoolExecutor::post(Task &&task) noexcept
+{
+    instrument(task);
+    auto *node = new Task(std::move(task));
+    if (t_pool == this) {
+        m_workers[t_workerIndex]->tasks.push(node);
+    } else {
+        std::unique_lock lock(m_injectedMutex);
+        m_injected.push_back(node);
+        m_injectedCount.fetch_add(1);
+    }
+    wakeUp(1);
+}
+
+void ThreadPoolExecutor::postBatch(std::vector<Task> &&tasks) noexcept
+{
+    if (tasks.empty()) {
+        return;
+    }
+
+    std::vector<Task *> nodes;
+    nodes.reserve(tasks.size());
+    for (auto &task : tasks) {
+        instrument(task);
+        nodes.push_back(new Task(std::move(task)));
+    }
+
+    if (t_pool == this) {
+        auto &worker = *m_workers[t_workerIndex];
+        for (auto *node : nodes) {
+            worker.tasks.push(node);
+        }
+    } else {
+        std::unique_lock lock(m_injectedMutex);
+        m_injected.insert(m_injected.end(), nodes.begin(), nodes.end());
+        m_injectedCount.fetch_add(nodes.size());
+    }
+    wakeUp(nodes.size());
+}
+
+std::unique_ptr<Timer> ThreadPoolExecutor::makeTimer(Interval interval, TimerTask &&task) noexcept
+{
+    return m_reactor->makeTimer(interval, std::move(task));
+}
+
+std::unique_ptr<IoWatch> ThreadPoolExecutor::makeIoWatch(int fd, std::int16_t events,
+                                                         IoWatchTask &&task) noexcept
+{
+    return m_reactor->makeIoWatch(fd, events, std::move(task));
+}
+
+bool ThreadPoolExecutor::setSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept
+{
+    return m_reactor->setSignalHandlers(std::move(signalHandlers));
+}
+
+bool ThreadPoolExecutor::appendSignalHandlers(
+    std::vector<LinuxSignalHandler> signalHandlers) noexcept
+{
+    return m_reactor->appendSignalHandlers(std::move(signalHandlers));
+}
+
+void ThreadPoolExecutor::stop() noexcept
+{
+    stop(EXIT_SUCCESS);
+}
+
+void ThreadPoolExecutor::stop(int exitCode) noexcept
+{
+    {
+        std::unique_lock lock(m_runMutex);
+        if (m_isStopping.exchange(true)) {
+            return;
+        }
+        m_exitCode = exitCode;
+    }
+    nf::info("Stopping a thread pool {}", fmt::ptr(this));
+
+    m_runCv.notify_all();
+    {
+        std::unique_lock lock(m_idleMutex);
+    }
+    m_idleCv.notify_all();
+}
+
+std::chrono::milliseconds ThreadPoolExecutor::now() const noexcept
+{
+    return m_reactor->now();
+}
+
+std::shared_ptr<Executor> ThreadPoolExecutor::makeStrand() noexcept
+{
+    return std::make_shared<Strand>(shared_from_this(), m_reactor);
+}
+
+std::size_t ThreadPoolExecutor::threadCount() const noexcept
+{
+    return m_workers.size();
+}
+
+int ThreadPoolExecutor::runImpl()
+{
+    std::unique_lock lock(m_runMutex);
+    m_isRunning = true;
+    [[maybe_unused]] auto token = RaiiToken::nonDismissible([this] { m_isRunning = false; });
+
+    m_runCv.wait(lock, [this] { return m_isStopping.load() || !m_exceptions.empty(); });
+    if (!m_exceptions.empty()) {
+        auto eptr = m_exceptions.front();
+        m_exceptions.erase(m_exceptions.begin());
+        std::rethrow_exception(eptr);
+    }
+    return m_exitCode;
+}
+
+void ThreadPoolExecutor::postImpl(Delay delay, Task &&task) noexcept
+{
+    if (delay == Delay::zero()) {
+        post(std::move(task));
+        return;
+    }
+
+    /* The reactor keeps time, the task itself runs in the pool. */
+    m_reactor->post(delay, [wSelf = weak_from_this(), task = std::move(task)]() mutable {
+        if (auto self = wSelf.lock()) {
+            self->post(std::move(task));
+        }
+    });
+}
+
+void ThreadPoolExecutor::discardAllPostedEvents() noexcept
+{
+    discardTasks();
+}
+
+void ThreadPoolExecutor::work(Worker &worker) noexcept
+{
+    while (!m_isStopping.load(std::memory_order_acquire)) {
+        auto *task = findTask(worker);
+        if (!task) {
+            /* Pairs with wakeUp(): either a poster sees this worker idle and wakes it up, or
+             * this worker sees the posted task. */
+            std::unique_lock lock(m_idleMutex);
+            m_idleCount.fetch_add(1);
+            if (!hasTasks() && !m_isStopping.load()) {
+                m_idleCv.wait(lock);
+            }
+            m_idleCount.fetch_sub(1);
+            continue;
+        }
+
+        std::exception_ptr eptr;
+        try {
+            (*task)();
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+
+        /* Either running or destroying the task may release the last reference to the pool. */
+        if (!t_isOrphaned && eptr) {
+            std::unique_lock lock(m_runMutex);
+            if (m_isRunning) {
+                m_exceptions.push_back(eptr);
+                lock.unlock();
+                m_runCv.notify_all();
+            } else {
+                nf::error("A task of thread pool {} has thrown ({}), which is dropped because "
+                          "the pool is not run",
+                          fmt::ptr(this), describe(eptr));
+            }
+        }
+        delete task;
+        if (t_isOrphaned) {
+            return;
+        }
+    }
+}
+
+ThreadPoolExecutor::Task *ThreadPoolExecutor::findTask(Worker &worker) noexcept
+{
+    if (auto *task = worker.tasks.pop()) {
+        return task;
+    }
+
+    for (int round = 0; round < kSpinRounds; ++round) {
+        if (auto *task = takeInjected(worker)) {
+            return task;
+        }
+
+        /* Start with a random victim, so that thieves do not line up behind each other. */
+        worker.seed ^= worker.seed << 13;
+        worker.seed ^= worker.seed >> 17;
+        worker.seed ^= worker.seed << 5;
+        const auto count = m_workers.size();
+        for (std::size_t i = 0, start = worker.seed % count; i < count; ++i) {
+            auto &victim = *m_workers[(start + i) % count];
+            if (&victim == &worker) {
+                continue;
+            }
+            if (auto *task = victim.tasks.steal()) {
+                return task;
+            }
+        }
+
+        if (m_isStopping.load(std::memory_order_relaxed)) {
+            break;
+        }
+        std::this_thread::yield();
+    }
+    return nullptr;
+}
+
+ThreadPoolExecutor::Task *ThreadPoolExecutor::takeInjected(Worker &worker) noexcept
+{
+    if (m_injectedCount.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    /* Take a share of the tasks at once to lock less often. The other workers steal them from
+     * this worker if it is busy. */
+    std::array<Task *, kInjectedBatch> batch{};
+    std::size_t count = 0;
+    {
+        std::unique_lock lock(m_injectedMutex);
+        const auto share = (m_injected.size() + m_workers.size() - 1) / m_workers.size();
+        count = std::min(kInjectedBatch, share);
+        for (std::size_t i = 0; i < count; ++i) {
+            batch[i] = m_injected.front();
+            m_injected.pop_front();
+        }
+        m_injectedCount.fetch_sub(count);
+    }
+    if (count == 0) {
+        return nullptr;
+    }
+
+    /* Pushed in reverse, so that the worker pops them in the order they were posted. */
+    for (auto i = count - 1; i > 0; --i) {
+        worker.tasks.push(batch[i]);
+    }
+    if (count > 1) {
+        wakeUp(1);
+    }
+    return batch[0];
+}
+
+bool ThreadPoolExecutor::hasTasks() const noexcept
+{
+    if (m_injectedCount.load() > 0) {
+        return true;
+    }
+    return std::any_of(m_workers.begin(), m_workers.end(),
+                       [](const auto &worker) { return !worker->tasks.isEmpty(); });
+}
+
+void ThreadPoolExecutor::wakeUp(std::size_t count) noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_idleCount.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    /* An idle worker either waits already or still holds the mutex, so it cannot miss it. */
+    {
+        std::unique_lock lock(m_idleMutex);
+    }
+    if (count == 1) {
+        m_idleCv.notify_one();
+    } else {
+        m_idleCv.notify_all();
+    }
+}
+
+void ThreadPoolExecutor::discardTasks() noexcept
+{
+    /* Destroying a task may post another one, so the queues are drained until they stay
+     * empty. Tasks are destroyed without holding the mutex. */
+    while (true) {
+        std::deque<Task *> injected;
+        {
+            std::unique_lock lock(m_injectedMutex);
+            injected.swap(m_injected);
+            m_injectedCount.store(0);
+        }
+
+        bool isEmpty = injected.empty();
+        for (auto *task : injected) {
+            delete task;
+        }
+        for (auto &worker : m_workers) {
+            while (auto *task = worker->tasks.steal()) {
+                isEmpty = false;
+                delete task;
+            }
+        }
+        if (isEmpty) {
+            return;
+        }
+    }
+}
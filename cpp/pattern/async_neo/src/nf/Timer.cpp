@@ -41,6 +41,16 @@ void Timer::setTask(Task &&task) noexcept
     m_task = std::move(task);
 }
 
+void Timer::setPriority(Executor::Priority priority) noexcept
+{
+    m_priority = priority;
+}
+
+Executor::Priority Timer::priority() const noexcept
+{
+    return m_priority;
+}
+
 bool Timer::isRunning() const noexcept
 {
     return m_state != State::Stopped && m_state != State::InTaskStopped;
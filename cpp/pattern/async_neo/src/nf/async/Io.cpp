@@ -0,0 +1,197 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/async/Io.h"
+
+#include <nf/Executor.h>
+#include <nf/IoWatch.h>
+#include <nf/Promise.h>
+#include <nf/backend/UringExecutor.h>
+
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <memory>
+
+using namespace nf;
+using namespace async;
+
+namespace {
+
+template <typename T>
+using IoResult = Result<T, std::error_code>;
+
+backend::UringExecutor *uringExecutor() noexcept
+{
+    return dynamic_cast<backend::UringExecutor *>(Executor::thisThread().get());
+}
+
+std::error_code lastError() noexcept
+{
+    return {errno, std::system_category()};
+}
+
+template <typename T>
+bool wouldBlock(const IoResult<T> &result) noexcept
+{
+    return !result
+        && (result.errorValue() == std::errc::resource_unavailable_try_again
+            || result.errorValue() == std::errc::interrupted);
+}
+
+/* The fallback for executors without io_uring: perform the operation right away and, if the
+ * descriptor is not ready, once it becomes ready. Trying first saves a round trip through the
+ * event loop and does not replace the watch of a concurrent receive on the same descriptor. */
+template <typename T, typename F>
+IoFuture<T> whenReady(int fd, std::int16_t events, F &&perform) noexcept
+{
+    Promise<IoResult<T>> promise;
+    auto future = promise.future();
+
+    if (auto result = perform(); !wouldBlock(result)) {
+        promise.fulfill(std::move(result));
+        return future;
+    }
+
+    /* The watch is kept alive by its own task until the operation has been performed. */
+    auto watch = std::make_shared<std::unique_ptr<IoWatch>>();
+    *watch = IoWatch::construct(
+        fd, events, [watch, promise, perform = std::forward<F>(perform)](std::int16_t) mutable {
+            auto result = perform();
+            if (wouldBlock(result)) {
+                return true;
+            }
+            promise.fulfill(std::move(result));
+            Executor::thisThread()->deleteLater(*watch);
+            return false;
+        });
+    (*watch)->start();
+
+    return future;
+}
+
+IoResult<ByteArray> toData(ssize_t result, ByteArray &&buffer) noexcept
+{
+    if (result < 0) {
+        return IoResult<ByteArray>::err(lastError());
+    }
+    buffer.resize(static_cast<std::size_t>(result));
+    return IoResult<ByteArray>::ok(std::move(buffer));
+}
+
+IoResult<std::size_t> toSize(ssize_t result) noexcept
+{
+    if (result < 0) {
+        return IoResult<std::size_t>::err(lastError());
+    }
+    return IoResult<std::size_t>::ok(static_cast<std::size_t>(result));
+}
+
+} // anonymous namespace
+
+IoFuture<ByteArray> async::read(int fd, std::size_t size) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->read(fd, size);
+    }
+
+    return whenReady<ByteArray>(fd, POLLIN, [fd, size] {
+        ByteArray buffer;
+        buffer.resize(size);
+        return toData(::read(fd, buffer.data(), size), std::move(buffer));
+    });
+}
+
+IoFuture<std::size_t> async::write(int fd, ByteArray data) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->write(fd, std::move(data));
+    }
+
+    return whenReady<std::size_t>(fd, POLLOUT, [fd, data = std::move(data)] {
+        return toSize(::write(fd, data.data(), data.size()));
+    });
+}
+
+IoFuture<ByteArray> async::recv(int fd, std::size_t size) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->recv(fd, size);
+    }
+
+    return whenReady<ByteArray>(fd, POLLIN, [fd, size] {
+        ByteArray buffer;
+        buffer.resize(size);
+        return toData(::recv(fd, buffer.data(), size, MSG_DONTWAIT), std::move(buffer));
+    });
+}
+
+IoFuture<std::size_t> async::send(int fd, ByteArray data) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->send(fd, std::move(data));
+    }
+
+    return whenReady<std::size_t>(fd, POLLOUT, [fd, data = std::move(data)] {
+        return toSize(::send(fd, data.data(), data.size(), MSG_DONTWAIT | MSG_NOSIGNAL));
+    });
+}
+
+IoFuture<int> async::accept(int fd) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->accept(fd);
+    }
+
+    return whenReady<int>(fd, POLLIN, [fd] {
+        int result = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (result < 0) {
+            return IoResult<int>::err(lastError());
+        }
+        return IoResult<int>::ok(result);
+    });
+}
+
+RaiiToken async::receive(int fd, ReceiveHandler handler) noexcept
+{
+    if (auto *executor = uringExecutor()) {
+        return executor->receive(fd, std::move(handler));
+    }
+
+    constexpr std::size_t kChunkSize = 4096;
+
+    /* The token may be reset by the handler, i.e. from the watch's own task, which must not
+     * restart the watch then. */
+    auto isStopped = std::make_shared<bool>(false);
+    auto watch = IoWatch::construct(
+        fd, POLLIN, [fd, isStopped, handler = std::move(handler)](std::int16_t) mutable {
+            ByteArray buffer;
+            buffer.resize(kChunkSize);
+            auto result =
+                toData(::recv(fd, buffer.data(), kChunkSize, MSG_DONTWAIT), std::move(buffer));
+            if (wouldBlock(result)) {
+                return true;
+            }
+
+            const bool isDone = !result || result.value().size() == 0;
+            handler(std::move(result));
+            return !isDone && !*isStopped;
+        });
+    watch->start();
+
+    return RaiiToken::nonDismissible(
+        [isStopped, watch = std::shared_ptr<IoWatch>(std::move(watch))]() mutable {
+            *isStopped = true;
+            watch->stop();
+            Executor::thisThread()->deleteLater(watch);
+        });
+}
@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2019-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2019-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -12,7 +12,8 @@
 #include "nf/backend/AsioExecutor.h"
 
 #include "AsioIoWatch.h"
-#include "AsioTimer.h"
+#include "TimerWheel.h"
+#include "WheelTimer.h"
 
 #include <nf/Logging.h>
 
@@ -58,41 +59,138 @@ void TaskWrapper::operator()() const
 
 } // anonymous namespace
 
-AsioExecutor::AsioExecutor() = default;
+AsioExecutor::AsioExecutor()
+    : m_wheelTimer(std::make_unique<boost::asio::steady_timer>(m_ios))
+    , m_timerWheel(std::make_unique<TimerWheel>(
+          now().count(), [this](std::optional<std::int64_t> tick) { armTimer(tick); }))
+{
+}
 
 AsioExecutor::~AsioExecutor() = default;
 
 void AsioExecutor::post(Task &&task) noexcept
 {
-    m_ios.post(TaskWrapper(std::move(task)));
+    postToLane(Priority::Normal, std::move(task));
+}
+
+void AsioExecutor::postToLane(Priority priority, Task &&task) noexcept
+{
+    instrument(task);
+    m_lanes.push(priority, std::move(task));
+    scheduleDrain();
+}
+
+void AsioExecutor::postBatch(std::vector<Task> &&tasks) noexcept
+{
+    if (tasks.empty()) {
+        return;
+    }
+
+    for (auto &task : tasks) {
+        instrument(task);
+    }
+    m_lanes.push(Priority::Normal, std::move(tasks));
+    scheduleDrain();
+}
+
+std::size_t AsioExecutor::queueDepth(Priority priority) const noexcept
+{
+    return m_lanes.depth(priority);
+}
+
+void AsioExecutor::scheduleDrain() noexcept
+{
+    /* A single drain handler is queued at a time, so io_service locks its queue only once
+     * for all tasks posted meanwhile. */
+    if (!m_isDrainScheduled.exchange(true, std::memory_order_acq_rel)) {
+        m_ios.post(TaskWrapper([this] { drain(); }));
+    }
+}
+
+void AsioExecutor::drain()
+{
+    /* Producers which push after this see the flag cleared and schedule another drain. The
+     * exchange also makes the tasks of producers which still saw it set visible here. */
+    m_isDrainScheduled.exchange(false, std::memory_order_acq_rel);
+
+    /* The number of tasks is limited to let the handlers of timers and I/O watches in. */
+    for (int i = 0; i < kMaxTasksPerDrain; ++i) {
+        auto node = m_lanes.pop();
+        if (!node) {
+            return;
+        }
+
+        try {
+            node->task();
+        } catch (...) {
+            /* The remaining tasks stay in the lanes, so that they are not lost if the
+             * exception handler lets the event loop continue. */
+            scheduleDrain();
+            throw;
+        }
+
+        /* Honour stop() between tasks as it is done between handlers. */
+        if (m_ios.stopped()) {
+            break;
+        }
+    }
+    scheduleDrain();
 }
 
 void AsioExecutor::postImpl(Delay delay, Task &&task) noexcept
 {
-    std::unique_lock lock(m_mutex);
-    auto timer = m_postTimers.insert(m_postTimers.end(), nullptr);
-    *timer = std::make_unique<AsioTimer>(m_ios, delay, [this, timer, task = std::move(task)] {
-        task();
+    if (delay == Delay::zero()) {
+        post(std::move(task));
+        return;
+    }
 
-        /* We cannot delete the timer object right now because it is being accessed after
-         * after this handle returns. So we tell it to delete itself when it is safe to do
-         * so and non-destructively remove the pointer from the list. */
-        timer->release()->setAutoDelete();
-        m_postTimers.erase(timer);
-        return false;
+    const auto deadline = (now() + delay).count();
+    if (isThisThread()) {
+        m_timerWheel->post(deadline, std::move(task));
+        return;
+    }
+
+    /* The timer wheel belongs to the executor's thread. The deadline is taken here, so that
+     * the time the task waits in the queue counts towards the delay. */
+    post([this, deadline, task = std::move(task)]() mutable {
+        m_timerWheel->post(deadline, std::move(task));
     });
-    (*timer)->start();
 }
 
 std::unique_ptr<Timer> AsioExecutor::makeTimer(Interval interval, TimerTask &&task) noexcept
 {
-    return std::make_unique<AsioTimer>(m_ios, interval, std::move(task));
+    return std::make_unique<WheelTimer>(*this, *m_timerWheel, interval, std::move(task));
+}
+
+void AsioExecutor::armTimer(std::optional<std::int64_t> tick) noexcept
+{
+    boost::system::error_code ec;
+    if (!tick) {
+        m_wheelTimer->cancel(ec);
+        return;
+    }
+
+    /* The wheel ticks are milliseconds of the steady clock, see now(). A pending wait is
+     * cancelled by expires_at(). */
+    m_wheelTimer->expires_at(
+        std::chrono::steady_clock::time_point(std::chrono::milliseconds(*tick)), ec);
+    if (ec) {
+        nf::fatal("Failed to arm the timer of an event loop {}: {}", fmt::ptr(this),
+                  ec.message());
+        return;
+    }
+
+    m_wheelTimer->async_wait([this](const boost::system::error_code &ec) {
+        if (ec != boost::asio::error::operation_aborted) {
+            m_timerWheel->advance(now().count());
+        }
+    });
 }
 
 std::unique_ptr<IoWatch> AsioExecutor::makeIoWatch(int fd, std::int16_t events,
                                                    IoWatchTask &&task) noexcept
 {
-    return std::make_unique<backend::AsioIoWatch>(m_ios, fd, events, std::move(task));
+    return std::make_unique<backend::AsioIoWatch>(*this, m_ios, fd, events, std::move(task));
 }
 
 int AsioExecutor::runImpl()
@@ -212,6 +310,11 @@ std::chrono::milliseconds AsioExecutor::now() const noexcept
 
 void AsioExecutor::discardAllPostedEvents() noexcept
 {
+    /* The wheel's timer is bound to the io_service, so it is recreated with the latter. */
+    m_timerWheel->discard();
+    m_wheelTimer.reset();
+    m_lanes.discard();
+
     /*
      * Destroying and recreating the io_service object seems to be the only way to flush
      * pending tasks. The io_service API has changed in boost 1.66; the changes
@@ -223,4 +326,6 @@ void AsioExecutor::discardAllPostedEvents() noexcept
     m_ios.~io_context();
 #endif
     new (&m_ios) boost::asio::io_service{};
+    m_wheelTimer = std::make_unique<boost::asio::steady_timer>(m_ios);
+    m_isDrainScheduled.store(false, std::memory_order_relaxed);
 }
@@ -14,14 +14,20 @@
 
 using namespace nf::backend;
 
-AsioIoWatch::AsioIoWatch(boost::asio::io_service &ios, int fd, std::int16_t events,
-                         Task &&task) noexcept
-    : IoWatch(fd, events, std::move(task))
+AsioIoWatch::AsioIoWatch(Executor &executor, boost::asio::io_service &ios, int fd,
+                         std::int16_t events, Task &&task) noexcept
+    : IoWatch(executor, fd, events, std::move(task))
     , m_watch(ios, fd)
 {
 }
 
-AsioIoWatch::~AsioIoWatch() = default;
+AsioIoWatch::~AsioIoWatch()
+{
+    /* The descriptor belongs to the owner of the watch, as with the other backends. The stream
+     * descriptor would close it, even if the watch is destroyed after the owner has closed it
+     * and the number has been reused. */
+    m_watch.release();
+}
 
 void AsioIoWatch::onStarted() noexcept
 {
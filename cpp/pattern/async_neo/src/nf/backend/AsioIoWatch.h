@@ -23,7 +23,8 @@ namespace backend {
 class AsioIoWatch final : public IoWatch
 {
 public:
-    AsioIoWatch(boost::asio::io_service &ios, int fd, std::int16_t events, Task &&task) noexcept;
+    AsioIoWatch(Executor &executor, boost::asio::io_service &ios, int fd, std::int16_t events,
+                Task &&task) noexcept;
     ~AsioIoWatch() override;
 
 private:
@@ -0,0 +1,323 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/backend/AsyncLogger.h"
+
+#include <algorithm>
+#include <optional>
+
+using namespace nf;
+using namespace nf::backend;
+
+namespace {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+std::atomic<std::uint64_t> s_nextLoggerId{1};
+
+/* The logger whose writer thread is the current thread, if any. */
+thread_local const AsyncLogger *t_writerOf = nullptr;
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) noexcept
+{
+    std::size_t result = 2;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+/*
+ * A single-producer/single-consumer ring of entries. The producer is the logging thread which
+ * owns the ring, the consumer is the writer thread. The consumer releases a slot only after the
+ * entry has been written, so a blocked producer never overwrites an entry being written.
+ */
+class AsyncLogger::Ring
+{
+public:
+    explicit Ring(std::size_t capacity)
+        : m_slots(capacity)
+        , m_mask(capacity - 1)
+    {
+    }
+
+    bool tryPush(const LogEntry &logEntry) noexcept
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+
+        m_slots[tail & m_mask].emplace(logEntry);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename tFunction>
+    bool drain(tFunction &&function) noexcept
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+
+        for (; head != tail; ++head) {
+            auto &slot = m_slots[head & m_mask];
+            function(*slot);
+            slot.reset();
+            m_head.store(head + 1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<std::optional<LogEntry>> m_slots;
+    const std::size_t m_mask;
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_head{0};
+    alignas(kCacheLineSize) std::atomic<std::size_t> m_tail{0};
+    /* The producer's copy of m_head, so that it does not touch the consumer's cache line on every
+     * push. */
+    std::size_t m_cachedHead = 0;
+};
+
+AsyncLogger::AsyncLogger(std::vector<std::shared_ptr<LogBackend>> backends,
+                         OverflowPolicy policy, std::size_t capacity)
+    : m_backends(std::move(backends))
+    , m_policy(policy)
+    , m_capacity(roundUpToPowerOfTwo(capacity))
+    , m_id(s_nextLoggerId++)
+    , m_writer([this] { run(); })
+{
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        std::unique_lock lock(m_m);
+        m_isStopping = true;
+    }
+    m_wakeUp.notify_one();
+    m_writer.join();
+}
+
+void AsyncLogger::registerContext(LogContext &context) noexcept
+{
+    std::unique_lock lock(m_outputM);
+    for (auto &backend : m_backends) {
+        backend->registerContext(context);
+    }
+}
+
+void AsyncLogger::write(const LogContext &context, LogLevel level,
+                        const std::string &message) noexcept
+{
+    write({context, level, message, {}});
+}
+
+void AsyncLogger::write(const LogEntry &logEntry) noexcept
+{
+    /* A backend which logs itself must not wait for its own thread. */
+    if (t_writerOf == this) {
+        output(logEntry);
+        return;
+    }
+
+    auto &ring = localRing();
+    while (!ring.tryPush(logEntry)) {
+        if (m_policy != OverflowPolicy::Block) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wakeUp();
+        std::this_thread::yield();
+    }
+    wakeUp();
+}
+
+void AsyncLogger::suspendOutput() noexcept
+{
+    std::unique_lock lock(m_outputM);
+    for (auto &backend : m_backends) {
+        backend->suspendOutput();
+    }
+}
+
+void AsyncLogger::resumeOutput() noexcept
+{
+    std::unique_lock lock(m_outputM);
+    for (auto &backend : m_backends) {
+        backend->resumeOutput();
+    }
+}
+
+bool AsyncLogger::isSuspended() const noexcept
+{
+    std::unique_lock lock(m_outputM);
+    return std::any_of(m_backends.cbegin(), m_backends.cend(),
+                       [](const auto &backend) { return backend->isSuspended(); });
+}
+
+void AsyncLogger::flush() noexcept
+{
+    if (t_writerOf == this) {
+        return;
+    }
+
+    std::unique_lock lock(m_m);
+    const auto ticket = ++m_flushRequested;
+    m_wakeUp.notify_one();
+    m_flushed.wait(lock, [this, ticket] { return m_flushDone >= ticket; });
+}
+
+std::uint64_t AsyncLogger::droppedCount() const noexcept
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+AsyncLogger::Ring &AsyncLogger::localRing()
+{
+    /* Threads rarely log to more than one logger, so a linear search is good enough. */
+    thread_local std::vector<std::pair<std::uint64_t, std::shared_ptr<Ring>>> t_rings;
+    for (const auto &[id, ring] : t_rings) {
+        if (id == m_id) {
+            return *ring;
+        }
+    }
+
+    /* Forget the rings of destroyed loggers. */
+    t_rings.erase(std::remove_if(t_rings.begin(), t_rings.end(),
+                                 [](const auto &pair) { return pair.second.use_count() == 1; }),
+                  t_rings.end());
+
+    auto ring = std::make_shared<Ring>(m_capacity);
+    {
+        std::unique_lock lock(m_m);
+        m_rings.push_back(ring);
+    }
+    return *t_rings.emplace_back(m_id, std::move(ring)).second;
+}
+
+void AsyncLogger::run() noexcept
+{
+    t_writerOf = this;
+
+    std::unique_lock lock(m_m);
+    while (true) {
+        const auto flushRequested = m_flushRequested;
+        const auto isStopping = m_isStopping;
+        auto rings = m_rings;
+        lock.unlock();
+
+        while (drain(rings)) {
+        }
+        reportDropped();
+        rings.clear();
+
+        lock.lock();
+        releaseFinishedRings();
+        m_flushDone = flushRequested;
+        m_flushed.notify_all();
+        if (isStopping) {
+            return;
+        }
+
+        /* Pairs with the fence in wakeUp(): either a producer sees that the writer is waiting,
+         * or the writer sees the entry of the producer. */
+        m_isWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_wakeUp.wait(lock, [this, flushRequested] {
+            return m_isStopping || m_flushRequested != flushRequested || hasPendingEntries();
+        });
+        m_isWaiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool AsyncLogger::drain(const std::vector<std::shared_ptr<Ring>> &rings) noexcept
+{
+    bool hasWritten = false;
+    std::unique_lock lock(m_outputM);
+    for (const auto &ring : rings) {
+        hasWritten |= ring->drain([this](const LogEntry &logEntry) { output(logEntry); });
+    }
+    return hasWritten;
+}
+
+void AsyncLogger::reportDropped() noexcept
+{
+    if (m_policy != OverflowPolicy::DropAndReport) {
+        return;
+    }
+
+    const auto dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped == m_reported) {
+        return;
+    }
+
+    const auto message =
+        fmt::format("{} log entries were dropped because of a full buffer", dropped - m_reported);
+    m_reported = dropped;
+
+    std::unique_lock lock(m_outputM);
+    output({ActiveLogContext, LogLevel::Warn, message, source_location::current()});
+}
+
+void AsyncLogger::releaseFinishedRings() noexcept
+{
+    /* A ring which only the logger refers to belongs to a thread which has exited. Its last
+     * entries have been published before the thread released the ring. */
+    const auto isFinished = [](const std::shared_ptr<Ring> &ring) {
+        if (ring.use_count() != 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ring->isEmpty();
+    };
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), isFinished), m_rings.end());
+}
+
+bool AsyncLogger::hasPendingEntries() const noexcept
+{
+    return std::any_of(m_rings.cbegin(), m_rings.cend(),
+                       [](const auto &ring) { return !ring->isEmpty(); });
+}
+
+void AsyncLogger::wakeUp() noexcept
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_isWaiting.load(std::memory_order_relaxed)
+        || !m_isWaiting.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+
+    /* Taking the mutex makes sure the writer is either before checking for pending entries or
+     * already waiting, so the notification cannot get lost. */
+    {
+        std::unique_lock lock(m_m);
+    }
+    m_wakeUp.notify_one();
+}
+
+void AsyncLogger::output(const LogEntry &logEntry) noexcept
+{
+    for (auto &backend : m_backends) {
+        backend->write(logEntry);
+    }
+}
@@ -0,0 +1,419 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/backend/EpollExecutor.h"
+
+#include "EpollIoWatch.h"
+#include "TimerWheel.h"
+#include "WheelTimer.h"
+
+#include <nf/Logging.h>
+#include <nf/Printable.h>
+#include <nf/RaiiToken.h>
+
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <pthread.h>
+
+#include <cerrno>
+
+using namespace nf;
+using namespace backend;
+using namespace detail;
+
+namespace {
+
+/* The executor whose event loop runs in this thread. */
+thread_local const EpollExecutor *t_runningExecutor = nullptr; // NOLINT
+
+bool watch(int epollFd, int operation, int fd, std::uint32_t events, void *data) noexcept
+{
+    ::epoll_event event{};
+    event.events = events;
+    event.data.ptr = data;
+    return ::epoll_ctl(epollFd, operation, fd, &event) == 0;
+}
+
+} // anonymous namespace
+
+EpollExecutor::EpollExecutor() noexcept
+    : m_epollFd(::epoll_create1(EPOLL_CLOEXEC))
+    , m_wakeupFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , m_timerFd(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+    , m_timerWheel(std::make_unique<TimerWheel>(
+          now().count(), [this](std::optional<std::int64_t> tick) { armTimer(tick); }))
+{
+    if (m_epollFd < 0 || m_wakeupFd < 0 || m_timerFd < 0) {
+        nf::fatal("Failed to create an event loop {}: {}", fmt::ptr(this), nf::strerror(errno));
+    }
+
+    /* The wake-up and the timer descriptors are told apart from the watches by their own
+     * addresses. */
+    if (!watch(m_epollFd, EPOLL_CTL_ADD, m_wakeupFd, EPOLLIN, &m_wakeupFd)
+        || !watch(m_epollFd, EPOLL_CTL_ADD, m_timerFd, EPOLLIN, &m_timerFd)) {
+        nf::fatal("Failed to watch for posted tasks: {}", nf::strerror(errno));
+    }
+
+    sigemptyset(&m_blockedSignals);
+}
+
+EpollExecutor::~EpollExecutor()
+{
+    m_signalWatch.reset();
+    resetSignals();
+    discardAllPostedEvents();
+    m_timerWheel.reset();
+    ::close(m_timerFd);
+    ::close(m_wakeupFd);
+    ::close(m_epollFd);
+}
+
+void EpollExecutor::post(Task &&task) noexcept
+{
+    postToLane(Priority::Normal, std::move(task));
+}
+
+void EpollExecutor::postToLane(Priority priority, Task &&task) noexcept
+{
+    instrument(task);
+    m_lanes.push(priority, std::move(task));
+
+    /* A running event loop drains the queue after each task and each batch of events, so
+     * a task posted from the loop itself needs no wake-up. */
+    if (t_runningExecutor != this) {
+        wakeUp();
+    }
+}
+
+void EpollExecutor::postBatch(std::vector<Task> &&tasks) noexcept
+{
+    if (tasks.empty()) {
+        return;
+    }
+
+    for (auto &task : tasks) {
+        instrument(task);
+    }
+    m_lanes.push(Priority::Normal, std::move(tasks));
+
+    if (t_runningExecutor != this) {
+        wakeUp();
+    }
+}
+
+std::size_t EpollExecutor::queueDepth(Priority priority) const noexcept
+{
+    return m_lanes.depth(priority);
+}
+
+void EpollExecutor::postImpl(Delay delay, Task &&task) noexcept
+{
+    if (delay == Delay::zero()) {
+        post(std::move(task));
+        return;
+    }
+
+    const auto deadline = (now() + delay).count();
+    if (t_runningExecutor == this) {
+        m_timerWheel->post(deadline, std::move(task));
+        return;
+    }
+
+    /* The timer wheel belongs to the executor's thread. The deadline is taken here, so that
+     * the time the task waits in the queue counts towards the delay. */
+    post([this, deadline, task = std::move(task)]() mutable {
+        m_timerWheel->post(deadline, std::move(task));
+    });
+}
+
+std::unique_ptr<Timer> EpollExecutor::makeTimer(Interval interval, TimerTask &&task) noexcept
+{
+    return std::make_unique<WheelTimer>(*this, *m_timerWheel, interval, std::move(task));
+}
+
+std::unique_ptr<IoWatch> EpollExecutor::makeIoWatch(int fd, std::int16_t events,
+                                                    IoWatchTask &&task) noexcept
+{
+    return std::make_unique<EpollIoWatch>(*this, fd, events, std::move(task));
+}
+
+bool EpollExecutor::addWatch(int fd, std::uint32_t events, EventHandler *handler) noexcept
+{
+    if (watch(m_epollFd, EPOLL_CTL_ADD, fd, events, handler)) {
+        return true;
+    }
+
+    /* Disarmed one-shot watches are not unregistered, take over such a registration. */
+    if (errno != EEXIST || !watch(m_epollFd, EPOLL_CTL_MOD, fd, events, handler)) {
+        nf::error("Failed to watch fd={}: {}", fd, nf::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool EpollExecutor::modifyWatch(int fd, std::uint32_t events, EventHandler *handler) noexcept
+{
+    if (watch(m_epollFd, EPOLL_CTL_MOD, fd, events, handler)) {
+        return true;
+    }
+
+    /* The kernel drops the registration once the descriptor is closed, the number might
+     * have been reused since. */
+    return errno == ENOENT && addWatch(fd, events, handler);
+}
+
+void EpollExecutor::removeWatch(int fd, EventHandler *handler) noexcept
+{
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr) < 0) {
+        nf::verbose("Failed to stop watching fd={}: {}", fd, nf::strerror(errno));
+    }
+
+    /* Drop the events which are already received but not yet dispatched. */
+    for (int i = m_eventIndex; i < m_eventCount; ++i) {
+        if (m_events[i].data.ptr == handler) {
+            m_events[i].data.ptr = nullptr;
+        }
+    }
+}
+
+int EpollExecutor::runImpl()
+{
+    m_exitCode = EXIT_SUCCESS;
+
+    /* Tasks might have been left in the queue by a previous run. */
+    m_hasPendingTasks = true;
+
+    nf::info("Running an event loop {}", fmt::ptr(this));
+
+    [[maybe_unused]] auto token = RaiiToken::nonDismissible(
+        [previous = std::exchange(t_runningExecutor, this)] { t_runningExecutor = previous; });
+
+    while (!m_isStopRequested.load(std::memory_order_acquire)) {
+        const int timeout = m_hasPendingTasks ? 0 : -1;
+        m_eventCount = ::epoll_wait(m_epollFd, m_events.data(), kMaxEvents, timeout);
+        if (m_eventCount < 0) {
+            m_eventCount = 0;
+            if (errno == EINTR) {
+                continue;
+            }
+            nf::fatal("Event loop {} failed to wait: {}", fmt::ptr(this), nf::strerror(errno));
+            break;
+        }
+
+        dispatchEvents();
+        m_hasPendingTasks = processTasks();
+    }
+
+    m_isStopRequested.store(false, std::memory_order_relaxed);
+    resetSignals();
+    nf::info("Event loop {} finished", fmt::ptr(this));
+
+    return m_exitCode;
+}
+
+void EpollExecutor::dispatchEvents() noexcept
+{
+    /* The whole batch is dispatched even if the loop is stopped meanwhile, because the
+     * events of one-shot watches are not reported again. */
+    for (m_eventIndex = 0; m_eventIndex < m_eventCount; ++m_eventIndex) {
+        auto *data = m_events[m_eventIndex].data.ptr;
+        if (data == &m_wakeupFd) {
+            std::uint64_t value = 0;
+            [[maybe_unused]] auto ret = ::read(m_wakeupFd, &value, sizeof(value));
+
+            /* Producers which see the flag cleared write to the eventfd again. The fence
+             * makes sure a producer which still sees the flag set has its task visible to
+             * the processTasks() which follows. */
+            m_isWakeupPending.store(false, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        } else if (data == &m_timerFd) {
+            std::uint64_t expirations = 0;
+            [[maybe_unused]] auto ret = ::read(m_timerFd, &expirations, sizeof(expirations));
+            m_timerWheel->advance(now().count());
+        } else if (data != nullptr) {
+            static_cast<EventHandler *>(data)->handleEvents(m_events[m_eventIndex].events);
+        }
+    }
+    m_eventCount = 0;
+    m_eventIndex = 0;
+}
+
+bool EpollExecutor::processTasks()
+{
+    /* The number of tasks is limited to not starve the I/O watches and timers. */
+    for (int i = 0; i < kMaxTasksPerIteration; ++i) {
+        if (m_isStopRequested.load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        auto node = m_lanes.pop();
+        if (!node) {
+            return false;
+        }
+        node->task();
+    }
+    return true;
+}
+
+void EpollExecutor::armTimer(std::optional<std::int64_t> tick) noexcept
+{
+    /* The wheel ticks are milliseconds of the steady clock, which is CLOCK_MONOTONIC. */
+    ::itimerspec spec{};
+    if (tick) {
+        spec.it_value.tv_sec = *tick / 1000;
+        spec.it_value.tv_nsec = (*tick % 1000) * 1000000;
+    }
+
+    if (::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        nf::fatal("Failed to arm the timer of an event loop {}: {}", fmt::ptr(this),
+                  nf::strerror(errno));
+    }
+}
+
+void EpollExecutor::wakeUp() noexcept
+{
+    if (m_isWakeupPending.exchange(true, std::memory_order_seq_cst)) {
+        return;
+    }
+
+    const std::uint64_t value = 1;
+    if (::write(m_wakeupFd, &value, sizeof(value)) < 0) {
+        nf::error("Failed to wake up an event loop {}: {}", fmt::ptr(this), nf::strerror(errno));
+    }
+}
+
+void EpollExecutor::stop() noexcept
+{
+    stop(EXIT_SUCCESS);
+}
+
+void EpollExecutor::stop(int exitCode) noexcept
+{
+    nf::info("Stopping an event loop {}", fmt::ptr(this));
+    m_exitCode = exitCode;
+    m_isStopRequested.store(true, std::memory_order_release);
+    wakeUp();
+}
+
+bool EpollExecutor::setSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept
+{
+    resetSignals();
+
+    if (signalHandlers.empty()) {
+        nf::info("Cleared Linux signal handling");
+        return true;
+    }
+
+    ::sigset_t signals;
+    sigemptyset(&signals);
+    for (const auto &handle : signalHandlers) {
+        sigaddset(&signals, static_cast<int>(handle.signal));
+    }
+
+    m_signalFd = ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (m_signalFd < 0) {
+        nf::error("Can not create a signal descriptor. Error: {}", nf::strerror(errno));
+        return false;
+    }
+
+    /* Signals must be blocked to be delivered via the signalfd. Remember which ones were
+     * not blocked before to unblock them again when resetting the handlers. */
+    ::sigset_t previous;
+    if (int ec = ::pthread_sigmask(SIG_BLOCK, &signals, &previous); ec != 0) {
+        nf::error("Can not block signals. Error: {}", nf::strerror(ec));
+        resetSignals();
+        return false;
+    }
+    for (const auto &handle : signalHandlers) {
+        if (sigismember(&previous, static_cast<int>(handle.signal)) == 0) {
+            sigaddset(&m_blockedSignals, static_cast<int>(handle.signal));
+        }
+    }
+
+    m_signalHandlers = std::move(signalHandlers);
+    m_signalWatch = makeIoWatch(m_signalFd, POLLIN,
+                                [this, generation = m_signalGeneration](std::int16_t) {
+                                    handleSignals();
+                                    /* Stop if the handlers have been replaced meanwhile. */
+                                    return generation == m_signalGeneration;
+                                });
+    m_signalWatch->start();
+
+    return true;
+}
+
+bool EpollExecutor::appendSignalHandlers(std::vector<LinuxSignalHandler> signalHandlers) noexcept
+{
+    signalHandlers.insert(std::end(signalHandlers), std::begin(m_signalHandlers),
+                          std::end(m_signalHandlers));
+    return setSignalHandlers(signalHandlers);
+}
+
+void EpollExecutor::handleSignals() noexcept
+{
+    ::signalfd_siginfo info{};
+    while (::read(m_signalFd, &info, sizeof(info)) == sizeof(info)) {
+        const auto signalNumber = static_cast<int>(info.ssi_signo);
+        auto linuxSignal = static_cast<LinuxSignal>(signalNumber);
+
+        if (!isValid(linuxSignal)) {
+            nf::error("Caught invalid signal {}", signalNumber);
+            continue;
+        }
+
+        nf::info("Caught linux signal {}", toString(linuxSignal));
+
+        /* Handlers may replace the handlers. */
+        const auto signalHandlers = m_signalHandlers;
+        for (const auto &handle : signalHandlers) {
+            if (linuxSignal == handle.signal) {
+                handle.cb(handle.signal);
+            }
+        }
+
+        if (m_signalFd < 0) {
+            return;
+        }
+    }
+}
+
+void EpollExecutor::resetSignals() noexcept
+{
+    ++m_signalGeneration;
+    if (m_signalWatch) {
+        /* This might be called from the watch's own task, so it cannot be deleted now. */
+        m_signalWatch->stop();
+        deleteLater(m_signalWatch);
+    }
+    if (m_signalFd >= 0) {
+        ::close(m_signalFd);
+        m_signalFd = -1;
+    }
+    ::pthread_sigmask(SIG_UNBLOCK, &m_blockedSignals, nullptr);
+    sigemptyset(&m_blockedSignals);
+    m_signalHandlers.clear();
+}
+
+std::chrono::milliseconds EpollExecutor::now() const noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+}
+
+void EpollExecutor::discardAllPostedEvents() noexcept
+{
+    m_lanes.discard();
+    /* Like in the Asio backend, this drops the pending timers as well. */
+    m_timerWheel->discard();
+    armTimer(std::nullopt);
+}
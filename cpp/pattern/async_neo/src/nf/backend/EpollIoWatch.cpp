@@ -0,0 +1,81 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "EpollIoWatch.h"
+
+#include <nf/Logging.h>
+
+#include <cstdint>
+
+using namespace nf::backend;
+
+namespace {
+
+/* The poll() and epoll() event bits are the same on Linux, so the watched events can be
+ * passed to epoll as they are. */
+static_assert(POLLIN == EPOLLIN && POLLPRI == EPOLLPRI && POLLOUT == EPOLLOUT);
+static_assert(POLLRDNORM == EPOLLRDNORM && POLLRDBAND == EPOLLRDBAND);
+static_assert(POLLWRNORM == EPOLLWRNORM && POLLWRBAND == EPOLLWRBAND);
+
+std::uint32_t toEpollEvents(std::int16_t events) noexcept
+{
+    return static_cast<std::uint16_t>(events) | EPOLLONESHOT;
+}
+
+} // anonymous namespace
+
+EpollIoWatch::EpollIoWatch(EpollExecutor &executor, int fd, std::int16_t events,
+                           Task &&task) noexcept
+    : IoWatch(executor, fd, events, std::move(task))
+    , m_executor(executor)
+{
+}
+
+EpollIoWatch::~EpollIoWatch()
+{
+    if (m_isArmed) {
+        m_executor.removeWatch(m_fd, this);
+    }
+}
+
+void EpollIoWatch::onStarted() noexcept
+{
+    /* The watch is one-shot: once an event is received, epoll disarms the descriptor but
+     * keeps it registered, so restarting the watch only needs to re-arm it. */
+    const bool isOk = m_isRegistered ? m_executor.modifyWatch(m_fd, toEpollEvents(m_events), this)
+                                     : m_executor.addWatch(m_fd, toEpollEvents(m_events), this);
+    if (!isOk) {
+        nf::fatal("Failed to start an I/O watch {}", fmt::ptr(this));
+        stop();
+        return;
+    }
+    m_isRegistered = true;
+    m_isArmed = true;
+}
+
+void EpollIoWatch::onStopped() noexcept
+{
+    /* A disarmed watch does not deliver events, there is no need to unregister it. Its
+     * registration is dropped by the kernel once the descriptor is closed. */
+    if (m_isArmed) {
+        m_executor.removeWatch(m_fd, this);
+        m_isRegistered = false;
+        m_isArmed = false;
+    }
+}
+
+void EpollIoWatch::handleEvents(std::uint32_t events) noexcept
+{
+    nf::verbose("I/O watch {} received events {}", fmt::ptr(this), events);
+
+    m_isArmed = false;
+    stopWatch();
+    notify();
+}
@@ -0,0 +1,39 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/IoWatch.h>
+#include <nf/backend/EpollExecutor.h>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+class EpollIoWatch final : public IoWatch, private EpollExecutor::EventHandler
+{
+public:
+    EpollIoWatch(EpollExecutor &executor, int fd, std::int16_t events, Task &&task) noexcept;
+    ~EpollIoWatch() override;
+
+private:
+    void onStarted() noexcept override;
+    void onStopped() noexcept override;
+    void handleEvents(std::uint32_t events) noexcept override;
+
+private:
+    EpollExecutor &m_executor;
+    bool m_isRegistered{false};
+    bool m_isArmed{false};
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
@@ -0,0 +1,266 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "IoUring.h"
+
+#include <nf/Logging.h>
+#include <nf/Printable.h>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+using namespace nf;
+using namespace backend;
+
+namespace {
+
+int setup(unsigned entries, ::io_uring_params &params) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) noexcept
+{
+    return static_cast<int>(
+        ::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int registerRing(int ringFd, unsigned opcode, const void *arg, unsigned nrArgs) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, arg, nrArgs));
+}
+
+void *map(int fd, std::size_t size, off_t offset) noexcept
+{
+    auto *memory =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+template <typename T>
+T *at(void *ring, std::uint32_t offset) noexcept
+{
+    return reinterpret_cast<T *>(static_cast<std::byte *>(ring) + offset);
+}
+
+} // anonymous namespace
+
+bool IoUring::isSupported() noexcept
+{
+    ::io_uring_params params{};
+    const int ringFd = setup(2, params);
+    if (ringFd < 0) {
+        return false;
+    }
+    ::close(ringFd);
+
+    /* Reads and writes at the current file position are needed, and completions must not be
+     * dropped when the completion queue overflows. */
+    constexpr auto kRequired = IORING_FEAT_RW_CUR_POS | IORING_FEAT_NODROP;
+    return (params.features & kRequired) == kRequired;
+}
+
+IoUring::IoUring(unsigned entries) noexcept
+{
+    /* Multishot receives post many completions per submission. */
+    ::io_uring_params params{};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = 4 * entries;
+
+    m_ringFd = setup(entries, params);
+    if (m_ringFd < 0) {
+        nf::error("Failed to set up an io_uring: {}", nf::strerror(errno));
+        return;
+    }
+
+    m_eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!mapRings(params) || m_eventFd < 0
+        || registerRing(m_ringFd, IORING_REGISTER_EVENTFD, &m_eventFd, 1) < 0) {
+        nf::error("Failed to set up an io_uring: {}", nf::strerror(errno));
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+}
+
+IoUring::~IoUring()
+{
+    if (m_bufferRing) {
+        ::munmap(m_bufferRing, m_bufferRingSize);
+    }
+    if (m_sqes) {
+        ::munmap(m_sqes, m_sqesSize);
+    }
+    if (m_cqRing && m_cqRing != m_sqRing) {
+        ::munmap(m_cqRing, m_cqRingSize);
+    }
+    if (m_sqRing) {
+        ::munmap(m_sqRing, m_sqRingSize);
+    }
+    if (m_ringFd >= 0) {
+        ::close(m_ringFd);
+    }
+    if (m_eventFd >= 0) {
+        ::close(m_eventFd);
+    }
+}
+
+bool IoUring::mapRings(const ::io_uring_params &params) noexcept
+{
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe);
+
+    /* Newer kernels map both rings with a single mmap. */
+    const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (isSingleMap) {
+        m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+    }
+
+    m_sqRing = map(m_ringFd, m_sqRingSize, IORING_OFF_SQ_RING);
+    if (!m_sqRing) {
+        return false;
+    }
+    m_cqRing = isSingleMap ? m_sqRing : map(m_ringFd, m_cqRingSize, IORING_OFF_CQ_RING);
+    if (!m_cqRing) {
+        return false;
+    }
+    m_sqesSize = params.sq_entries * sizeof(::io_uring_sqe);
+    m_sqes = static_cast<::io_uring_sqe *>(map(m_ringFd, m_sqesSize, IORING_OFF_SQES));
+    if (!m_sqes) {
+        return false;
+    }
+
+    m_sqHead = at<unsigned>(m_sqRing, params.sq_off.head);
+    m_sqTail = at<unsigned>(m_sqRing, params.sq_off.tail);
+    m_sqMask = at<unsigned>(m_sqRing, params.sq_off.ring_mask);
+    m_sqFlags = at<unsigned>(m_sqRing, params.sq_off.flags);
+    m_sqArray = at<unsigned>(m_sqRing, params.sq_off.array);
+    m_sqEntries = params.sq_entries;
+    m_sqeTail = *m_sqTail;
+
+    m_cqHead = at<unsigned>(m_cqRing, params.cq_off.head);
+    m_cqTail = at<unsigned>(m_cqRing, params.cq_off.tail);
+    m_cqMask = at<unsigned>(m_cqRing, params.cq_off.ring_mask);
+    m_cqes = at<::io_uring_cqe>(m_cqRing, params.cq_off.cqes);
+    return true;
+}
+
+bool IoUring::isValid() const noexcept
+{
+    return m_ringFd >= 0;
+}
+
+int IoUring::eventFd() const noexcept
+{
+    return m_eventFd;
+}
+
+::io_uring_sqe *IoUring::getSqe() noexcept
+{
+    const auto head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (m_sqeTail - head >= m_sqEntries) {
+        return nullptr;
+    }
+
+    const auto index = m_sqeTail & *m_sqMask;
+    ++m_sqeTail;
+    auto *sqe = &m_sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    m_sqArray[index] = index;
+    return sqe;
+}
+
+unsigned IoUring::queued() const noexcept
+{
+    return m_sqeTail - *m_sqTail;
+}
+
+bool IoUring::submit(unsigned minComplete) noexcept
+{
+    const auto toSubmit = queued();
+    if (toSubmit == 0 && minComplete == 0) {
+        return true;
+    }
+
+    /* Publish the queued entries, the kernel reads them during the call. */
+    __atomic_store_n(m_sqTail, m_sqeTail, __ATOMIC_RELEASE);
+    const unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (enter(m_ringFd, toSubmit, minComplete, flags) < 0) {
+        if (errno != EINTR) {
+            nf::error("Failed to submit to an io_uring: {}", nf::strerror(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IoUring::flushOverflow() noexcept
+{
+    if ((__atomic_load_n(m_sqFlags, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW) == 0) {
+        return false;
+    }
+    return enter(m_ringFd, 0, 0, IORING_ENTER_GETEVENTS) >= 0;
+}
+
+bool IoUring::setUpBuffers(unsigned count, std::size_t size) noexcept
+{
+    m_bufferRingSize = count * sizeof(::io_uring_buf);
+    auto *memory = ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE,
+                          MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    m_bufferRing = static_cast<::io_uring_buf_ring *>(memory);
+
+    ::io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<std::uintptr_t>(m_bufferRing);
+    reg.ring_entries = count;
+    reg.bgid = kBufferGroup;
+    if (registerRing(m_ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        nf::info("Provided buffer rings are not supported: {}", nf::strerror(errno));
+        ::munmap(m_bufferRing, m_bufferRingSize);
+        m_bufferRing = nullptr;
+        return false;
+    }
+
+    m_bufferCount = count;
+    m_bufferSize = size;
+    m_buffers.reset(new std::byte[count * size]);
+    for (unsigned id = 0; id < count; ++id) {
+        recycleBuffer(static_cast<std::uint16_t>(id));
+    }
+    return true;
+}
+
+bool IoUring::hasBuffers() const noexcept
+{
+    return m_bufferRing != nullptr;
+}
+
+const std::byte *IoUring::buffer(std::uint16_t id) const noexcept
+{
+    return m_buffers.get() + id * m_bufferSize;
+}
+
+void IoUring::recycleBuffer(std::uint16_t id) noexcept
+{
+    /* Only this side moves the tail, the kernel consumes from the head. */
+    const auto tail = m_bufferRing->tail;
+    auto &entry = m_bufferRing->bufs[tail & (m_bufferCount - 1)];
+    entry.addr = reinterpret_cast<std::uintptr_t>(buffer(id));
+    entry.len = static_cast<std::uint32_t>(m_bufferSize);
+    entry.bid = id;
+    __atomic_store_n(&m_bufferRing->tail, static_cast<std::uint16_t>(tail + 1), __ATOMIC_RELEASE);
+}
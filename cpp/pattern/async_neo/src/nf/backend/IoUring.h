@@ -0,0 +1,166 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Global.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+/**
+ * @brief A Linux io_uring instance.
+ *
+ * This is a thin wrapper around the system calls and the rings shared with the kernel, so that
+ * the framework does not depend on liburing. Entries are queued via @ref getSqe() and passed to
+ * the kernel via @ref submit(). Completions are signalled via @ref eventFd() and taken via
+ * @ref reap().
+ *
+ * The instance can optionally provide a ring of equally sized buffers to the kernel, which
+ * picks one of them for each completion of a receive with @c IOSQE_BUFFER_SELECT.
+ *
+ * This class is not thread safe.
+ */
+class IoUring : private boost::noncopyable
+{
+public:
+    /**
+     * @brief The group of the provided buffers.
+     */
+    static constexpr std::uint16_t kBufferGroup = 0;
+
+public:
+    /**
+     * @brief Check if the kernel supports all operations used by the executor.
+     */
+    static bool isSupported() noexcept;
+
+    /**
+     * @brief Set up a ring with @p entries submission queue entries.
+     *
+     * Check @ref isValid() whether it succeeded.
+     */
+    explicit IoUring(unsigned entries) noexcept;
+    ~IoUring();
+
+    bool isValid() const noexcept;
+
+    /**
+     * @brief Get the eventfd which becomes readable when completions are posted.
+     */
+    int eventFd() const noexcept;
+
+    /**
+     * @brief Get a cleared submission queue entry.
+     *
+     * Returns @c nullptr if the submission queue is full, @ref submit() the entries first then.
+     */
+    ::io_uring_sqe *getSqe() noexcept;
+
+    /**
+     * @brief Pass the queued entries to the kernel.
+     *
+     * Waits for at least @p minComplete completions. Returns @c false on errors.
+     */
+    bool submit(unsigned minComplete = 0) noexcept;
+
+    /**
+     * @brief Get the number of queued entries not yet passed to the kernel.
+     */
+    unsigned queued() const noexcept;
+
+    /**
+     * @brief Invoke @p handler for each posted completion.
+     *
+     * Completions which overflowed the completion queue are fetched from the kernel as well.
+     */
+    template <typename F>
+    void reap(F &&handler) noexcept
+    {
+        do {
+            auto head = *m_cqHead;
+            const auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                /* A copy, the handler may submit further entries. */
+                const auto cqe = m_cqes[head & *m_cqMask];
+                __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+                handler(cqe);
+            }
+        } while (flushOverflow());
+    }
+
+    /**
+     * @brief Provide @p count buffers of @p size bytes to the kernel.
+     *
+     * The @p count must be a power of two. Returns @c false if the kernel does not support
+     * provided buffer rings.
+     */
+    bool setUpBuffers(unsigned count, std::size_t size) noexcept;
+
+    bool hasBuffers() const noexcept;
+
+    /**
+     * @brief Get the provided buffer with the given @p id.
+     */
+    const std::byte *buffer(std::uint16_t id) const noexcept;
+
+    /**
+     * @brief Give the provided buffer with the given @p id back to the kernel.
+     */
+    void recycleBuffer(std::uint16_t id) noexcept;
+
+private:
+    bool mapRings(const ::io_uring_params &params) noexcept;
+    bool flushOverflow() noexcept;
+
+private:
+    int m_ringFd{-1};
+    int m_eventFd{-1};
+
+    void *m_sqRing{nullptr};
+    std::size_t m_sqRingSize{0};
+    void *m_cqRing{nullptr};
+    std::size_t m_cqRingSize{0};
+    ::io_uring_sqe *m_sqes{nullptr};
+    std::size_t m_sqesSize{0};
+
+    unsigned *m_sqHead{nullptr};
+    unsigned *m_sqTail{nullptr};
+    unsigned *m_sqMask{nullptr};
+    unsigned *m_sqFlags{nullptr};
+    unsigned *m_sqArray{nullptr};
+    unsigned m_sqEntries{0};
+    /* The entries up to here are handed out, but not yet visible to the kernel. */
+    unsigned m_sqeTail{0};
+
+    unsigned *m_cqHead{nullptr};
+    unsigned *m_cqTail{nullptr};
+    unsigned *m_cqMask{nullptr};
+    ::io_uring_cqe *m_cqes{nullptr};
+
+    ::io_uring_buf_ring *m_bufferRing{nullptr};
+    std::size_t m_bufferRingSize{0};
+    unsigned m_bufferCount{0};
+    std::size_t m_bufferSize{0};
+    std::unique_ptr<std::byte[]> m_buffers;
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
@@ -12,10 +12,43 @@
 
 #include <nf/ContainerAlgorithms.h>
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <iomanip>
 
 using namespace nf::backend;
 
+struct MemoryLogger::RecordHeader
+{
+    std::int64_t timeStamp; // Nanoseconds since the epoch.
+    const LogContext *context;
+    std::uint32_t length;
+    LogLevel level;
+};
+
+namespace {
+
+/* A ring smaller than this could not keep a record with a few characters of a message. */
+constexpr std::size_t kMinCapacity = 256;
+
+void writeAll(int fd, const void *data, std::size_t size) noexcept
+{
+    const auto *begin = static_cast<const char *>(data);
+    while (size > 0) {
+        const auto written = ::write(fd, begin, size);
+        if (written <= 0) {
+            return;
+        }
+        begin += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+} // anonymous namespace
+
 bool MemoryLogger::Entry::operator==(const Entry &rhs) const noexcept
 {
     return std::tie(id, level, message) == std::tie(rhs.id, rhs.level, rhs.message);
@@ -33,6 +66,12 @@ std::ostream &operator<<(std::ostream &os, const MemoryLogger::Entry &entry) noe
 } // namespace backend
 NF_END_NAMESPACE
 
+MemoryLogger::MemoryLogger(std::size_t capacity) noexcept
+    : m_ring(new std::byte[std::max(capacity, kMinCapacity)])
+    , m_capacity(std::max(capacity, kMinCapacity))
+{
+}
+
 void MemoryLogger::write(const LogContext &context, LogLevel level,
                          const std::string &message) noexcept
 {
@@ -42,13 +81,16 @@ void MemoryLogger::write(const LogContext &context, LogLevel level,
 void MemoryLogger::write(const LogEntry &logEntry) noexcept
 {
     std::unique_lock lock(m_m);
-    m_logEntries.push_back(logEntry);
+    if (m_ring) {
+        writeRecord(logEntry);
+    } else {
+        m_logEntries.push_back(logEntry);
+    }
 }
 
 std::vector<MemoryLogger::Entry> MemoryLogger::entries() const noexcept
 {
-    std::unique_lock lock(m_m);
-    return transformToVector(m_logEntries, [](const auto &logEntry) {
+    return transformToVector(logEntries(), [](const auto &logEntry) {
         return MemoryLogger::Entry{logEntry.logContext.id, logEntry.logLevel, logEntry.message};
     });
 }
@@ -56,11 +98,138 @@ std::vector<MemoryLogger::Entry> MemoryLogger::entries() const noexcept
 std::vector<nf::LogEntry> MemoryLogger::logEntries() const noexcept
 {
     std::unique_lock lock(m_m);
-    return m_logEntries;
+    if (!m_ring) {
+        return m_logEntries;
+    }
+
+    std::vector<LogEntry> logEntries;
+    forEachRecord([&](const RecordHeader &header, std::size_t offset) {
+        std::string message(header.length, '\0');
+        copyOut(offset, message.data(), header.length);
+        auto &logEntry = logEntries.emplace_back(*header.context, header.level, message,
+                                                 source_location{});
+        logEntry.timePoint = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(header.timeStamp)));
+    });
+    return logEntries;
 }
 
 void MemoryLogger::clear() noexcept
 {
     std::unique_lock lock(m_m);
     m_logEntries.clear();
+    m_head = 0;
+    m_size = 0;
+    m_cntOverwritten = 0;
+}
+
+std::size_t MemoryLogger::overwrittenCount() const noexcept
+{
+    std::unique_lock lock(m_m);
+    return m_cntOverwritten;
+}
+
+void MemoryLogger::dump(int fd) const noexcept
+{
+    std::unique_lock lock(m_m, std::try_to_lock);
+    if (!lock) {
+        return;
+    }
+
+    /* Only the prefix is formatted, the message is written as it is stored. */
+    std::array<char, 128> prefix;
+    const auto writeLine = [&](std::int64_t timeStamp, const char *contextId, LogLevel level,
+                               auto &&writeMessage) {
+        const auto result =
+            fmt::format_to_n(prefix.data(), prefix.size(), "{}.{:09} | {:>4} | {:>7} | ",
+                             timeStamp / 1000000000, timeStamp % 1000000000, contextId,
+                             LogBackend::toString(level));
+        writeAll(fd, prefix.data(), std::min(result.size, prefix.size()));
+        writeMessage();
+        writeAll(fd, "\n", 1);
+    };
+
+    if (m_cntOverwritten > 0) {
+        const auto result = fmt::format_to_n(prefix.data(), prefix.size(),
+                                             "{} earlier messages were overwritten\n",
+                                             m_cntOverwritten);
+        writeAll(fd, prefix.data(), std::min(result.size, prefix.size()));
+    }
+
+    if (!m_ring) {
+        for (const auto &logEntry : m_logEntries) {
+            const auto timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       logEntry.timePoint.time_since_epoch())
+                                       .count();
+            writeLine(timeStamp, logEntry.logContext.id, logEntry.logLevel, [&] {
+                writeAll(fd, logEntry.message.data(), logEntry.message.size());
+            });
+        }
+        return;
+    }
+
+    forEachRecord([&](const RecordHeader &header, std::size_t offset) {
+        writeLine(header.timeStamp, header.context->id, header.level, [&] {
+            /* The message may wrap around the end of the ring. */
+            const auto first = std::min<std::size_t>(header.length, m_capacity - offset);
+            writeAll(fd, &m_ring[offset], first);
+            writeAll(fd, &m_ring[0], header.length - first);
+        });
+    });
+}
+
+void MemoryLogger::writeRecord(const LogEntry &logEntry) noexcept
+{
+    const auto length = std::min(logEntry.message.size(), m_capacity - sizeof(RecordHeader));
+    const auto recordSize = sizeof(RecordHeader) + length;
+
+    /* Make room by dropping the oldest records. */
+    while (m_capacity - m_size < recordSize) {
+        RecordHeader oldest;
+        copyOut(m_head, &oldest, sizeof(oldest));
+        const auto oldestSize = sizeof(RecordHeader) + oldest.length;
+        m_head = (m_head + oldestSize) % m_capacity;
+        m_size -= oldestSize;
+        ++m_cntOverwritten;
+    }
+
+    RecordHeader header;
+    header.timeStamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           logEntry.timePoint.time_since_epoch())
+                           .count();
+    header.context = &logEntry.logContext;
+    header.length = static_cast<std::uint32_t>(length);
+    header.level = logEntry.logLevel;
+
+    const auto tail = (m_head + m_size) % m_capacity;
+    copyIn(tail, &header, sizeof(header));
+    copyIn((tail + sizeof(header)) % m_capacity, logEntry.message.data(), length);
+    m_size += recordSize;
+}
+
+template <typename F>
+void MemoryLogger::forEachRecord(F &&func) const noexcept
+{
+    for (std::size_t position = 0; position < m_size;) {
+        const auto offset = (m_head + position) % m_capacity;
+        RecordHeader header;
+        copyOut(offset, &header, sizeof(header));
+        func(header, (offset + sizeof(header)) % m_capacity);
+        position += sizeof(header) + header.length;
+    }
+}
+
+void MemoryLogger::copyIn(std::size_t offset, const void *data, std::size_t size) noexcept
+{
+    const auto first = std::min(size, m_capacity - offset);
+    std::memcpy(&m_ring[offset], data, first);
+    std::memcpy(&m_ring[0], static_cast<const std::byte *>(data) + first, size - first);
+}
+
+void MemoryLogger::copyOut(std::size_t offset, void *data, std::size_t size) const noexcept
+{
+    const auto first = std::min(size, m_capacity - offset);
+    std::memcpy(data, &m_ring[offset], first);
+    std::memcpy(static_cast<std::byte *>(data) + first, &m_ring[0], size - first);
 }
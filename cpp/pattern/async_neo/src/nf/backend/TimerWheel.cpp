@@ -0,0 +1,264 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace nf;
+using namespace nf::backend;
+
+namespace {
+
+class PostedTask final : public TimerWheel::Entry
+{
+public:
+    explicit PostedTask(Function<void()> &&task) noexcept
+        : m_task(std::move(task))
+    {
+    }
+
+private:
+    void expire() noexcept override
+    {
+        std::unique_ptr<PostedTask> self(this);
+        m_task();
+    }
+
+    void discard() noexcept override
+    {
+        delete this;
+    }
+
+private:
+    Function<void()> m_task;
+};
+
+int firstSetBit(std::uint64_t bits) noexcept
+{
+    return __builtin_ctzll(bits);
+}
+
+} // anonymous namespace
+
+bool TimerWheel::Entry::isScheduled() const noexcept
+{
+    return m_wheel != nullptr;
+}
+
+TimerWheel::Tick TimerWheel::Entry::expiry() const noexcept
+{
+    return m_expiry;
+}
+
+TimerWheel::Entry::~Entry()
+{
+    if (m_wheel != nullptr) {
+        m_wheel->cancel(*this);
+    }
+}
+
+void TimerWheel::Entry::discard() noexcept
+{
+}
+
+TimerWheel::TimerWheel(Tick now, Rearm &&rearm) noexcept
+    : m_current(now)
+    , m_rearm(std::move(rearm))
+{
+}
+
+TimerWheel::~TimerWheel()
+{
+    discard();
+}
+
+void TimerWheel::schedule(Entry &entry, Tick expiry) noexcept
+{
+    cancel(entry);
+    entry.m_wheel = this;
+    entry.m_expiry = std::max(expiry, m_current + 1);
+
+    if (const auto tick = insert(entry); !m_armed || tick < *m_armed) {
+        m_armed = tick;
+        m_rearm(m_armed);
+    }
+}
+
+void TimerWheel::cancel(Entry &entry) noexcept
+{
+    /* The wheel is not re-armed: if the entry was the next one, advance() finds nothing
+     * to expire and re-arms the wheel for the one after. */
+    if (entry.m_wheel == this) {
+        unlink(entry);
+    }
+}
+
+void TimerWheel::post(Tick expiry, Function<void()> &&task) noexcept
+{
+    schedule(*new PostedTask(std::move(task)), expiry);
+}
+
+std::optional<TimerWheel::Tick> TimerWheel::nextExpiry() const noexcept
+{
+    if (m_slots[kExpiringSlot].next != &m_slots[kExpiringSlot]) {
+        return m_current;
+    }
+
+    std::optional<Tick> next;
+    for (int level = 0; level < kLevels; ++level) {
+        const auto occupied = m_occupied[level];
+        if (occupied == 0) {
+            continue;
+        }
+
+        /* The slots after the current one are reached first, the current one is reached
+         * last, i.e. after a full turn of the level. */
+        const int current = static_cast<int>((m_current >> (level * kSlotBits)) & (kSlots - 1));
+        const int shift = (current + 1) & (kSlots - 1);
+        const auto rotated = shift == 0 ? occupied : (occupied >> shift) | (occupied << (kSlots - shift));
+        const int index = (shift + firstSetBit(rotated)) & (kSlots - 1);
+
+        const auto tick = slotTick(level, index);
+        next = next ? std::min(*next, tick) : tick;
+    }
+    return next;
+}
+
+void TimerWheel::advance(Tick now) noexcept
+{
+    auto &expiring = m_slots[kExpiringSlot];
+
+    for (auto next = nextExpiry(); next && *next <= now; next = nextExpiry()) {
+        m_current = *next;
+
+        /* Higher levels first: they might cascade entries into the lower level slot which
+         * is reached at the same tick. */
+        for (int level = kLevels - 1; level > 0; --level) {
+            if (m_current % levelUnit(level) == 0) {
+                cascade(level, static_cast<int>((m_current >> (level * kSlotBits)) & (kSlots - 1)));
+            }
+        }
+        cascade(0, static_cast<int>(m_current & (kSlots - 1)));
+
+        /* Expired entries may schedule or cancel any entry, including the expiring ones. */
+        while (expiring.next != &expiring) {
+            auto &entry = static_cast<Entry &>(*expiring.next);
+            unlink(entry);
+            entry.expire();
+        }
+    }
+    m_current = std::max(m_current, now);
+
+    if (auto next = nextExpiry(); next != m_armed) {
+        m_armed = next;
+        m_rearm(m_armed);
+    }
+}
+
+void TimerWheel::discard() noexcept
+{
+    /* The owner drops its wait together with the entries, so the next scheduled entry
+     * re-arms the wheel. */
+    m_armed.reset();
+
+    for (auto &slot : m_slots) {
+        while (slot.next != &slot) {
+            auto &entry = static_cast<Entry &>(*slot.next);
+            unlink(entry);
+            entry.discard();
+        }
+    }
+}
+
+TimerWheel::Tick TimerWheel::levelUnit(int level) noexcept
+{
+    return Tick(1) << (level * kSlotBits);
+}
+
+TimerWheel::Tick TimerWheel::slotTick(int level, int index) const noexcept
+{
+    /* This is the first tick after the current one, when the wheel reaches the slot. */
+    const auto period = levelUnit(level + 1);
+    auto tick = m_current - (m_current % period) + index * levelUnit(level);
+    return tick > m_current ? tick : tick + period;
+}
+
+TimerWheel::Tick TimerWheel::insert(Entry &entry) noexcept
+{
+    const auto delta = entry.m_expiry - m_current;
+
+    int slot = kExpiringSlot;
+    auto tick = m_current;
+    if (delta > 0) {
+        int level = 0;
+        while (level + 1 < kLevels && delta >= levelUnit(level + 1)) {
+            ++level;
+        }
+        const auto at = m_current + std::min(delta, kMaxDelta);
+        const int index = static_cast<int>((at >> (level * kSlotBits)) & (kSlots - 1));
+        slot = level * kSlots + index;
+        m_occupied[level] |= std::uint64_t(1) << index;
+        tick = slotTick(level, index);
+    }
+
+    auto &head = m_slots[slot];
+    Link &link = entry;
+    link.prev = head.prev;
+    link.next = &head;
+    head.prev->next = &link;
+    head.prev = &link;
+    entry.m_slot = slot;
+
+    return tick;
+}
+
+void TimerWheel::unlink(Entry &entry) noexcept
+{
+    Link &link = entry;
+    link.prev->next = link.next;
+    link.next->prev = link.prev;
+    link.prev = &link;
+    link.next = &link;
+    entry.m_wheel = nullptr;
+
+    if (const auto slot = entry.m_slot; slot != kExpiringSlot) {
+        if (auto &head = m_slots[slot]; head.next == &head) {
+            m_occupied[slot / kSlots] &= ~(std::uint64_t(1) << (slot % kSlots));
+        }
+    }
+}
+
+void TimerWheel::cascade(int level, int index) noexcept
+{
+    auto &head = m_slots[level * kSlots + index];
+    if (head.next == &head) {
+        return;
+    }
+
+    /* Detach the whole slot first as the entries may be inserted into the same slot again. */
+    Link detached;
+    detached.next = head.next;
+    detached.prev = head.prev;
+    detached.next->prev = &detached;
+    detached.prev->next = &detached;
+    head.next = &head;
+    head.prev = &head;
+    m_occupied[level] &= ~(std::uint64_t(1) << index);
+
+    while (detached.next != &detached) {
+        auto &entry = static_cast<Entry &>(*detached.next);
+        Link &link = entry;
+        link.prev->next = link.next;
+        link.next->prev = link.prev;
+        insert(entry);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Function.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+/**
+ * @brief A hierarchical timing wheel.
+ *
+ * The wheel keeps timeouts with a resolution of one tick (a millisecond as used by the
+ * executors) in four levels of 64 slots each. Scheduling and cancelling an entry are O(1).
+ * An entry which expires in more than 64^L ticks is kept at level L and moved to a lower
+ * level ("cascaded") when the wheel reaches its slot. Entries further away than the top level
+ * covers (about 4.6 hours) are cascaded through the top level repeatedly.
+ *
+ * The wheel does not wait on its own. Its owner waits until @ref nextExpiry() and calls
+ * @ref advance() then. The owner is notified via the re-arm function whenever a scheduled
+ * entry needs the wheel to be advanced earlier than before.
+ *
+ * This class is not thread safe.
+ */
+class TimerWheel : private boost::noncopyable
+{
+public:
+    using Tick = std::int64_t;
+    using Rearm = Function<void(std::optional<Tick>)>;
+
+private:
+    struct Link
+    {
+        Link *prev{this};
+        Link *next{this};
+    };
+
+public:
+    /**
+     * @brief An entry of the wheel.
+     *
+     * An entry is invoked via @ref expire() once its expiry tick is reached. It is
+     * unscheduled when it is destroyed.
+     */
+    class Entry : private Link, private boost::noncopyable
+    {
+    public:
+        bool isScheduled() const noexcept;
+        Tick expiry() const noexcept;
+
+    protected:
+        Entry() noexcept = default;
+        ~Entry();
+
+    private:
+        friend class TimerWheel;
+
+        virtual void expire() noexcept = 0;
+
+        /* Called instead of expire() when the wheel drops the entry. */
+        virtual void discard() noexcept;
+
+    private:
+        TimerWheel *m_wheel{nullptr};
+        Tick m_expiry{0};
+        int m_slot{0};
+    };
+
+public:
+    TimerWheel(Tick now, Rearm &&rearm) noexcept;
+    ~TimerWheel();
+
+    /**
+     * @brief Schedule @p entry to expire at @p expiry. A scheduled entry is rescheduled.
+     *
+     * An entry never expires earlier than the tick following the current one.
+     */
+    void schedule(Entry &entry, Tick expiry) noexcept;
+
+    /**
+     * @brief Unschedule @p entry. This is a no-op if the entry is not scheduled.
+     */
+    void cancel(Entry &entry) noexcept;
+
+    /**
+     * @brief Schedule a one-shot @p task owned by the wheel.
+     */
+    void post(Tick expiry, Function<void()> &&task) noexcept;
+
+    /**
+     * @brief Get the tick when the wheel needs to be advanced next.
+     */
+    std::optional<Tick> nextExpiry() const noexcept;
+
+    /**
+     * @brief Expire all entries which are due at @p now.
+     */
+    void advance(Tick now) noexcept;
+
+    /**
+     * @brief Drop all scheduled entries without expiring them.
+     *
+     * The wheel assumes that the owner does not wait for it any more.
+     */
+    void discard() noexcept;
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+    static constexpr int kExpiringSlot = kLevels * kSlots;
+    static constexpr Tick kMaxDelta = (Tick(1) << (kLevels * kSlotBits)) - 1;
+
+    static Tick levelUnit(int level) noexcept;
+    Tick slotTick(int level, int index) const noexcept;
+    Tick insert(Entry &entry) noexcept;
+    void unlink(Entry &entry) noexcept;
+    void cascade(int level, int index) noexcept;
+
+private:
+    Tick m_current;
+    Rearm m_rearm;
+    std::optional<Tick> m_armed;
+    std::array<Link, kExpiringSlot + 1> m_slots;
+    std::array<std::uint64_t, kLevels> m_occupied{};
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
@@ -0,0 +1,371 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/backend/UringExecutor.h"
+
+#include "IoUring.h"
+
+#include <nf/Logging.h>
+#include <nf/Promise.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+using namespace nf;
+using namespace backend;
+
+namespace {
+
+std::error_code toErrorCode(std::int32_t result) noexcept
+{
+    return {-result, std::system_category()};
+}
+
+} // anonymous namespace
+
+struct UringExecutor::Operation
+{
+    /* The kernel reads or writes the buffer until the operation completes. */
+    ByteArray buffer;
+    Function<void(std::int32_t result, std::uint32_t flags)> complete;
+};
+
+struct UringExecutor::Receiver
+{
+    int fd;
+    async::ReceiveHandler handler;
+    std::uint64_t id{0};
+    bool isDone{false};
+};
+
+bool UringExecutor::isSupported() noexcept
+{
+    return IoUring::isSupported();
+}
+
+UringExecutor::UringExecutor() noexcept
+    : m_ring(std::make_unique<IoUring>(kEntries))
+{
+    if (!m_ring->isValid()) {
+        nf::error("I/O operations of {} are not available", fmt::ptr(this));
+        return;
+    }
+    addWatch(m_ring->eventFd(), EPOLLIN, this);
+}
+
+UringExecutor::~UringExecutor()
+{
+    if (!m_ring->isValid()) {
+        return;
+    }
+    removeWatch(m_ring->eventFd(), this);
+
+    /* The kernel may still use the buffers of pending operations, so they are cancelled and
+     * waited for. Their futures are not fulfilled, like discarded tasks are not run. */
+    m_isClosing = true;
+    for (const auto &operation : m_operations) {
+        cancel(operation.first);
+    }
+    while (!m_operations.empty() && m_ring->submit(1)) {
+        m_ring->reap([this](const ::io_uring_cqe &cqe) {
+            if (!(cqe.flags & IORING_CQE_F_MORE)) {
+                m_operations.erase(cqe.user_data);
+            }
+        });
+    }
+}
+
+template <typename T, typename tPrepare, typename tFinish>
+UringExecutor::IoFuture<T> UringExecutor::start(ByteArray &&buffer, tPrepare &&prepare,
+                                                tFinish &&finish) noexcept
+{
+    Promise<Result<T, std::error_code>> promise;
+    auto future = promise.future();
+
+    auto operation = std::make_unique<Operation>();
+    operation->buffer = std::move(buffer);
+    operation->complete = [promise, finish = std::forward<tFinish>(finish),
+                           buffer = &operation->buffer](std::int32_t result, std::uint32_t) {
+        if (result < 0) {
+            promise.fulfill(Result<T, std::error_code>::err(toErrorCode(result)));
+        } else {
+            promise.fulfill(Result<T, std::error_code>::ok(finish(result, *buffer)));
+        }
+    };
+    submit(std::move(operation), std::forward<tPrepare>(prepare));
+
+    return future;
+}
+
+template <typename tPrepare>
+std::uint64_t UringExecutor::submit(std::unique_ptr<Operation> operation,
+                                    tPrepare &&prepare) noexcept
+{
+    if (!m_ring->isValid()) {
+        operation->complete(-ENOSYS, 0);
+        return 0;
+    }
+
+    auto *sqe = m_ring->getSqe();
+    if (!sqe) {
+        m_ring->submit();
+        sqe = m_ring->getSqe();
+    }
+    if (!sqe) {
+        operation->complete(-EBUSY, 0);
+        return 0;
+    }
+
+    const auto id = ++m_lastId;
+    prepare(*sqe, operation->buffer);
+    sqe->user_data = id;
+    m_operations.emplace(id, std::move(operation));
+    scheduleSubmit();
+    return id;
+}
+
+void UringExecutor::scheduleSubmit() noexcept
+{
+    /* All operations started by the tasks processed in one go are submitted together. */
+    if (m_isSubmitScheduled) {
+        return;
+    }
+    m_isSubmitScheduled = true;
+    post([this] {
+        m_isSubmitScheduled = false;
+        m_ring->submit();
+    });
+}
+
+UringExecutor::IoFuture<ByteArray> UringExecutor::read(int fd, std::size_t size) noexcept
+{
+    ByteArray buffer;
+    buffer.resize(size);
+    return start<ByteArray>(
+        std::move(buffer),
+        [fd](::io_uring_sqe &sqe, ByteArray &buffer) {
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+            sqe.len = static_cast<std::uint32_t>(buffer.size());
+            sqe.off = static_cast<std::uint64_t>(-1);
+        },
+        [](std::int32_t result, ByteArray &buffer) {
+            buffer.resize(static_cast<std::size_t>(result));
+            return std::move(buffer);
+        });
+}
+
+UringExecutor::IoFuture<std::size_t> UringExecutor::write(int fd, ByteArray data) noexcept
+{
+    return start<std::size_t>(
+        std::move(data),
+        [fd](::io_uring_sqe &sqe, ByteArray &buffer) {
+            sqe.opcode = IORING_OP_WRITE;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+            sqe.len = static_cast<std::uint32_t>(buffer.size());
+            sqe.off = static_cast<std::uint64_t>(-1);
+        },
+        [](std::int32_t result, ByteArray &) { return static_cast<std::size_t>(result); });
+}
+
+UringExecutor::IoFuture<ByteArray> UringExecutor::recv(int fd, std::size_t size) noexcept
+{
+    ByteArray buffer;
+    buffer.resize(size);
+    return start<ByteArray>(
+        std::move(buffer),
+        [fd](::io_uring_sqe &sqe, ByteArray &buffer) {
+            sqe.opcode = IORING_OP_RECV;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+            sqe.len = static_cast<std::uint32_t>(buffer.size());
+        },
+        [](std::int32_t result, ByteArray &buffer) {
+            buffer.resize(static_cast<std::size_t>(result));
+            return std::move(buffer);
+        });
+}
+
+UringExecutor::IoFuture<std::size_t> UringExecutor::send(int fd, ByteArray data) noexcept
+{
+    return start<std::size_t>(
+        std::move(data),
+        [fd](::io_uring_sqe &sqe, ByteArray &buffer) {
+            sqe.opcode = IORING_OP_SEND;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+            sqe.len = static_cast<std::uint32_t>(buffer.size());
+            sqe.msg_flags = MSG_NOSIGNAL;
+        },
+        [](std::int32_t result, ByteArray &) { return static_cast<std::size_t>(result); });
+}
+
+UringExecutor::IoFuture<int> UringExecutor::accept(int fd) noexcept
+{
+    return start<int>(
+        ByteArray(),
+        [fd](::io_uring_sqe &sqe, ByteArray &) {
+            sqe.opcode = IORING_OP_ACCEPT;
+            sqe.fd = fd;
+            sqe.accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        },
+        [](std::int32_t result, ByteArray &) { return static_cast<int>(result); });
+}
+
+RaiiToken UringExecutor::receive(int fd, async::ReceiveHandler handler) noexcept
+{
+    /* The pool of buffers is registered on the first use only. */
+    if (m_hasMultishot && !m_ring->hasBuffers() && m_ring->isValid()) {
+        m_hasMultishot = m_ring->setUpBuffers(kBufferCount, kBufferSize);
+    }
+
+    auto receiver = std::make_shared<Receiver>();
+    receiver->fd = fd;
+    receiver->handler = std::move(handler);
+    armReceiver(receiver);
+
+    return RaiiToken::nonDismissible([this, weakReceiver = std::weak_ptr(receiver)] {
+        if (auto receiver = weakReceiver.lock(); receiver && !receiver->isDone) {
+            receiver->isDone = true;
+            receiver->handler = {};
+            cancel(receiver->id);
+        }
+    });
+}
+
+void UringExecutor::armReceiver(const std::shared_ptr<Receiver> &receiver) noexcept
+{
+    const bool isMultishot = m_hasMultishot;
+    auto operation = std::make_unique<Operation>();
+    if (!isMultishot) {
+        operation->buffer.resize(kBufferSize);
+    }
+
+    operation->complete = [this, receiver, isMultishot, buffer = &operation->buffer](
+                              std::int32_t result, std::uint32_t flags) {
+        ByteArray data;
+        if (flags & IORING_CQE_F_BUFFER) {
+            const auto id = static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+            const auto *begin = m_ring->buffer(id);
+            data = ByteArray(begin, begin + result);
+            m_ring->recycleBuffer(id);
+            m_hasSelectedBuffer = true;
+        } else if (result > 0) {
+            buffer->resize(static_cast<std::size_t>(result));
+            data = std::move(*buffer);
+        }
+
+        const bool isLast = !(flags & IORING_CQE_F_MORE);
+        if (receiver->isDone) {
+            return;
+        }
+        if (isMultishot && result == -EINVAL && m_hasMultishot) {
+            nf::info("Multishot receive is not supported, receiving one by one");
+            m_hasMultishot = false;
+        }
+        /* Some kernels accept the buffer ring but never select from it. */
+        if (isMultishot && result == -ENOBUFS && m_hasMultishot && !m_hasSelectedBuffer) {
+            nf::info("Registered buffers are not used by the kernel, receiving one by one");
+            m_hasMultishot = false;
+        }
+        if ((isMultishot && result == -EINVAL) || result == -ENOBUFS) {
+            /* All buffers are given back by now, so the receive can be submitted again. */
+            if (isLast) {
+                armReceiver(receiver);
+            }
+            return;
+        }
+
+        auto handler = std::move(receiver->handler);
+        if (result <= 0) {
+            receiver->isDone = true;
+            handler(result == 0 ? Result<ByteArray, std::error_code>::ok(ByteArray())
+                                : Result<ByteArray, std::error_code>::err(toErrorCode(result)));
+            return;
+        }
+        handler(Result<ByteArray, std::error_code>::ok(std::move(data)));
+
+        /* The handler may have stopped receiving. */
+        if (!receiver->isDone) {
+            receiver->handler = std::move(handler);
+            if (isLast) {
+                armReceiver(receiver);
+            }
+        }
+    };
+
+    receiver->id = submit(std::move(operation), [&](::io_uring_sqe &sqe, ByteArray &buffer) {
+        sqe.opcode = IORING_OP_RECV;
+        sqe.fd = receiver->fd;
+        if (isMultishot) {
+            sqe.ioprio = IORING_RECV_MULTISHOT;
+            sqe.flags = IOSQE_BUFFER_SELECT;
+            sqe.buf_group = IoUring::kBufferGroup;
+        } else {
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+            sqe.len = static_cast<std::uint32_t>(buffer.size());
+        }
+    });
+}
+
+void UringExecutor::cancel(std::uint64_t id) noexcept
+{
+    if (id == 0) {
+        return;
+    }
+
+    auto *sqe = m_ring->getSqe();
+    if (!sqe) {
+        m_ring->submit();
+        sqe = m_ring->getSqe();
+    }
+    if (!sqe) {
+        nf::error("Failed to cancel an I/O operation of {}", fmt::ptr(this));
+        return;
+    }
+
+    /* The completion of the cancellation itself is ignored, 0 is never used by operations. */
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->addr = id;
+    sqe->user_data = 0;
+    if (!m_isClosing) {
+        scheduleSubmit();
+    }
+}
+
+void UringExecutor::handleEvents(std::uint32_t /*events*/) noexcept
+{
+    std::uint64_t value = 0;
+    [[maybe_unused]] auto ret = ::read(m_ring->eventFd(), &value, sizeof(value));
+
+    m_ring->reap([this](const ::io_uring_cqe &cqe) { complete(cqe.user_data, cqe.res, cqe.flags); });
+}
+
+void UringExecutor::complete(std::uint64_t id, std::int32_t result, std::uint32_t flags) noexcept
+{
+    auto it = m_operations.find(id);
+    if (it == m_operations.end()) {
+        return;
+    }
+
+    /* The map may change while the operation completes. */
+    if (flags & IORING_CQE_F_MORE) {
+        auto *operation = it->second.get();
+        operation->complete(result, flags);
+        return;
+    }
+    auto operation = std::move(it->second);
+    m_operations.erase(it);
+    operation->complete(result, flags);
+}
@@ -0,0 +1,120 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "WheelTimer.h"
+
+#include <nf/ChronoIoStream.h>
+#include <nf/Logging.h>
+
+using namespace nf::backend;
+
+WheelTimer::WheelTimer(Executor &executor, TimerWheel &wheel, Interval interval,
+                       Task &&task) noexcept
+    : Timer(interval, std::move(task))
+    , m_executor(executor)
+    , m_wheel(wheel)
+{
+    nf::verbose("Timer {} created with an interval of {}", fmt::ptr(this), interval);
+}
+
+WheelTimer::~WheelTimer() = default;
+
+void WheelTimer::start() noexcept
+{
+    if (isRunning()) {
+        nf::verbose("Restarting a timer {}", fmt::ptr(this));
+        stop();
+    }
+
+    nf::verbose("Starting a timer {}", fmt::ptr(this));
+
+    /* If the timer is started inside a timer-task, then do nothing. The timer will be
+     * rescheduled as soon the control returns to expire(). */
+    if (isInTask()) {
+        m_state = State::InTaskStarted;
+        return;
+    }
+
+    m_state = State::Started;
+    schedule();
+}
+
+void WheelTimer::stop() noexcept
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    nf::verbose("Stopping a timer {}", fmt::ptr(this));
+
+    /* If the timer is stopped inside a timer task, then do nothing. The timer will not
+     * be rescheduled when the control returns to expire(). */
+    if (isInTask()) {
+        m_state = State::InTaskStopped;
+        return;
+    }
+
+    m_state = State::Stopped;
+    m_wheel.cancel(*this);
+    m_laneScope.reset();
+}
+
+WheelTimer::Interval WheelTimer::remainingTime() const noexcept
+{
+    const auto zero = Interval::zero();
+    if (m_state == State::Stopped || !isScheduled()) {
+        return zero;
+    }
+    return std::max(zero, Interval(expiry()) - m_executor.now());
+}
+
+void WheelTimer::expire() noexcept
+{
+    nf::verbose("Timer {} triggered", fmt::ptr(this));
+
+    if (m_priority == Executor::Priority::High) {
+        runTask();
+        return;
+    }
+
+    /* The timer stays started while its task waits in the lane, stop() drops the task. */
+    m_executor.post(m_priority, m_laneScope.bind([this] { runTask(); }));
+}
+
+void WheelTimer::runTask() noexcept
+{
+    m_state = State::InTaskNeutral;
+    const bool doContinue = m_task();
+
+    /* Timer must be rescheduled if:
+     *  - task explicitly starts the timer (regardless of what it returns)
+     *  - task returns true AND does not explicitly stop the timer. */
+    if (m_state == State::InTaskStarted || (doContinue && m_state == State::InTaskNeutral)) {
+        nf::verbose("Rescheduling a timer {}", fmt::ptr(this));
+        m_state = State::Started;
+        schedule();
+        return;
+    }
+
+    nf::verbose("Timer {} has been stopped", fmt::ptr(this));
+    m_state = State::Stopped;
+}
+
+void WheelTimer::discard() noexcept
+{
+    nf::verbose("Timer {} has been discarded", fmt::ptr(this));
+    m_state = State::Stopped;
+    m_laneScope.reset();
+}
+
+void WheelTimer::schedule() noexcept
+{
+    m_wheel.schedule(*this, (m_executor.now() + m_interval).count());
+}
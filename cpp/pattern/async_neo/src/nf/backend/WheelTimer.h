@@ -0,0 +1,50 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include "TimerWheel.h"
+
+#include <nf/Executor.h>
+#include <nf/Timer.h>
+#include <nf/detail/CallbackScope.h>
+
+NF_BEGIN_NAMESPACE
+
+namespace backend {
+
+/**
+ * @brief The timer which is scheduled on the timer wheel of its executor.
+ */
+class WheelTimer final : public Timer, private TimerWheel::Entry
+{
+public:
+    WheelTimer(Executor &executor, TimerWheel &wheel, Interval interval, Task &&task) noexcept;
+    ~WheelTimer() override;
+    void start() noexcept override;
+    void stop() noexcept override;
+    Interval remainingTime() const noexcept override;
+
+private:
+    void expire() noexcept override;
+    void discard() noexcept override;
+    void schedule() noexcept;
+    void runTask() noexcept;
+
+private:
+    Executor &m_executor;
+    TimerWheel &m_wheel;
+    /* Guards the task posted to a lane of the executor. */
+    detail::CallbackScope m_laneScope;
+};
+
+} // namespace backend
+
+NF_END_NAMESPACE
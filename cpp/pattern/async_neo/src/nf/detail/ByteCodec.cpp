@@ -0,0 +1,465 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "ByteCodec.h"
+
+#include <array>
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define NF_CODEC_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace nf;
+using namespace nf::detail;
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+constexpr char kBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* Marks a character which is not a digit in the lookup tables below. */
+constexpr std::uint8_t kInvalid = 0x80;
+
+constexpr auto kHexValues = [] {
+    std::array<std::uint8_t, 256> values{};
+    for (auto &value : values) {
+        value = kInvalid;
+    }
+    for (std::uint8_t i = 0; i < 16; ++i) {
+        values[static_cast<std::uint8_t>(kHexDigits[i])] = i;
+    }
+    for (std::uint8_t i = 10; i < 16; ++i) {
+        values[static_cast<std::uint8_t>('A' + i - 10)] = i;
+    }
+    return values;
+}();
+
+constexpr auto kBase64Values = [] {
+    std::array<std::uint8_t, 256> values{};
+    for (auto &value : values) {
+        value = kInvalid;
+    }
+    for (std::uint8_t i = 0; i < 64; ++i) {
+        values[static_cast<std::uint8_t>(kBase64Alphabet[i])] = i;
+    }
+    return values;
+}();
+
+inline std::uint32_t byteAt(const std::byte *in, std::size_t index) noexcept
+{
+    return std::to_integer<std::uint32_t>(in[index]);
+}
+
+inline std::uint32_t hexValue(char ch) noexcept
+{
+    return kHexValues[static_cast<std::uint8_t>(ch)];
+}
+
+inline std::uint32_t base64Value(char ch) noexcept
+{
+    return kBase64Values[static_cast<std::uint8_t>(ch)];
+}
+
+void encodeHexScalar(const std::byte *in, std::size_t size, char *out) noexcept
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto value = byteAt(in, i);
+        out[2 * i] = kHexDigits[value >> 4];
+        out[2 * i + 1] = kHexDigits[value & 0xF];
+    }
+}
+
+std::size_t decodeHexScalar(const char *in, std::size_t size, std::byte *out) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 1 < size; i += 2) {
+        const auto hi = hexValue(in[i]);
+        const auto lo = hexValue(in[i + 1]);
+        if (((hi | lo) & kInvalid) != 0) {
+            break;
+        }
+        out[i / 2] = static_cast<std::byte>((hi << 4) | lo);
+    }
+    return i;
+}
+
+void encodeBase64Scalar(const std::byte *in, std::size_t size, char *out) noexcept
+{
+    std::size_t i = 0;
+    for (; i + 2 < size; i += 3) {
+        const auto value = (byteAt(in, i) << 16) | (byteAt(in, i + 1) << 8) | byteAt(in, i + 2);
+        *out++ = kBase64Alphabet[value >> 18];
+        *out++ = kBase64Alphabet[(value >> 12) & 0x3F];
+        *out++ = kBase64Alphabet[(value >> 6) & 0x3F];
+        *out++ = kBase64Alphabet[value & 0x3F];
+    }
+
+    if (i + 1 == size) {
+        const auto value = byteAt(in, i) << 16;
+        *out++ = kBase64Alphabet[value >> 18];
+        *out++ = kBase64Alphabet[(value >> 12) & 0x3F];
+        *out++ = '=';
+        *out++ = '=';
+    } else if (i + 2 == size) {
+        const auto value = (byteAt(in, i) << 16) | (byteAt(in, i + 1) << 8);
+        *out++ = kBase64Alphabet[value >> 18];
+        *out++ = kBase64Alphabet[(value >> 12) & 0x3F];
+        *out++ = kBase64Alphabet[(value >> 6) & 0x3F];
+        *out++ = '=';
+    }
+}
+
+std::optional<std::size_t> decodeBase64Scalar(const char *in, std::size_t size,
+                                              std::byte *out) noexcept
+{
+    /* A single character of the last quantum does not make a whole byte. */
+    if (size % 4 == 1) {
+        return std::nullopt;
+    }
+
+    std::size_t written = 0;
+    std::uint32_t value = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto sextet = base64Value(in[i]);
+        if ((sextet & kInvalid) != 0) {
+            return std::nullopt;
+        }
+        value = (value << 6) | sextet;
+        if (i % 4 == 3) {
+            out[written++] = static_cast<std::byte>(value >> 16);
+            out[written++] = static_cast<std::byte>(value >> 8);
+            out[written++] = static_cast<std::byte>(value);
+            value = 0;
+        }
+    }
+
+    if (size % 4 == 2) {
+        out[written++] = static_cast<std::byte>(value >> 4);
+    } else if (size % 4 == 3) {
+        out[written++] = static_cast<std::byte>(value >> 10);
+        out[written++] = static_cast<std::byte>(value >> 2);
+    }
+    return written;
+}
+
+#ifdef NF_CODEC_X86
+
+/*
+ * The SIMD kernels process whole blocks and leave the rest to the narrower kernel. The Base64
+ * ones follow the well-known approach of W. Muła and D. Lemire: bytes are reshuffled and
+ * shifted with multiplications, sextets are translated to characters and back with nibble
+ * lookup tables.
+ */
+
+__attribute__((target("sse4.1"))) void encodeHexSse(const std::byte *in, std::size_t size,
+                                                    char *out) noexcept
+{
+    const auto digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
+                                      'c', 'd', 'e', 'f');
+    const auto nibble = _mm_set1_epi8(0x0F);
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        const auto lo = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    encodeHexScalar(in + i, size - i, out + 2 * i);
+}
+
+__attribute__((target("sse4.1"))) std::size_t decodeHexSse(const char *in, std::size_t size,
+                                                           std::byte *out) noexcept
+{
+    const auto zero = _mm_set1_epi8('0');
+    const auto nine = _mm_set1_epi8(9);
+    const auto lowerA = _mm_set1_epi8('a');
+    const auto five = _mm_set1_epi8(5);
+    const auto ten = _mm_set1_epi8(10);
+    const auto lowerCase = _mm_set1_epi8(0x20);
+    const auto weights = _mm_set1_epi16(0x0110);
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto digit = _mm_sub_epi8(chars, zero);
+        const auto isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+        const auto letter = _mm_sub_epi8(_mm_or_si128(chars, lowerCase), lowerA);
+        const auto isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, five), letter);
+        if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+            break;
+        }
+
+        const auto values = _mm_blendv_epi8(_mm_add_epi8(letter, ten), digit, isDigit);
+        const auto words = _mm_maddubs_epi16(values, weights);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i / 2), _mm_packus_epi16(words, words));
+    }
+    return i + decodeHexScalar(in + i, size - i, out + i / 2);
+}
+
+__attribute__((target("sse4.1"))) inline __m128i toSextetsSse(__m128i bytes) noexcept
+{
+    bytes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11,
+                                                  10));
+    const auto t0 = _mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00));
+    const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const auto t2 = _mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0));
+    const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("sse4.1"))) inline __m128i toBase64CharsSse(__m128i sextets) noexcept
+{
+    const auto offsets =
+        _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    auto indices = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    indices = _mm_sub_epi8(indices, _mm_cmpgt_epi8(sextets, _mm_set1_epi8(25)));
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, indices));
+}
+
+__attribute__((target("sse4.1"))) void encodeBase64Sse(const std::byte *in, std::size_t size,
+                                                       char *out) noexcept
+{
+    /* A block loads 16 bytes but consumes only 12 of them. */
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 12) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 3 * 4),
+                         toBase64CharsSse(toSextetsSse(bytes)));
+    }
+    encodeBase64Scalar(in + i, size - i, out + i / 3 * 4);
+}
+
+__attribute__((target("sse4.1"))) std::optional<std::size_t>
+decodeBase64Sse(const char *in, std::size_t size, std::byte *out) noexcept
+{
+    const auto lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                     0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const auto lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10,
+                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const auto lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const auto slash = _mm_set1_epi8(0x2F);
+
+    /* A block writes 16 bytes but produces only 12 of them. */
+    std::size_t i = 0;
+    for (; i + 24 <= size; i += 16) {
+        auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto hiNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), slash);
+        const auto hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        const auto lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(chars, slash));
+        if (!_mm_testz_si128(lo, hi)) {
+            break;
+        }
+
+        const auto roll =
+            _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(chars, slash), hiNibbles));
+        chars = _mm_add_epi8(chars, roll);
+
+        const auto pairs = _mm_maddubs_epi16(chars, _mm_set1_epi32(0x01400140));
+        const auto triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        const auto bytes = _mm_shuffle_epi8(
+            triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 4 * 3), bytes);
+    }
+
+    const auto rest = decodeBase64Scalar(in + i, size - i, out + i / 4 * 3);
+    if (!rest) {
+        return std::nullopt;
+    }
+    return i / 4 * 3 + *rest;
+}
+
+__attribute__((target("avx2"))) void encodeHexAvx2(const std::byte *in, std::size_t size,
+                                                   char *out) noexcept
+{
+    const auto digits = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+    const auto nibble = _mm256_set1_epi8(0x0F);
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const auto hi =
+            _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        const auto lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, nibble));
+        /* Unpacking works within the lanes, so the halves are put back in order. */
+        const auto first = _mm256_unpacklo_epi8(hi, lo);
+        const auto second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    encodeHexSse(in + i, size - i, out + 2 * i);
+}
+
+__attribute__((target("avx2"))) std::size_t decodeHexAvx2(const char *in, std::size_t size,
+                                                          std::byte *out) noexcept
+{
+    const auto zero = _mm256_set1_epi8('0');
+    const auto nine = _mm256_set1_epi8(9);
+    const auto lowerA = _mm256_set1_epi8('a');
+    const auto five = _mm256_set1_epi8(5);
+    const auto ten = _mm256_set1_epi8(10);
+    const auto lowerCase = _mm256_set1_epi8(0x20);
+    const auto weights = _mm256_set1_epi16(0x0110);
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const auto digit = _mm256_sub_epi8(chars, zero);
+        const auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+        const auto letter = _mm256_sub_epi8(_mm256_or_si256(chars, lowerCase), lowerA);
+        const auto isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, five), letter);
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1) {
+            break;
+        }
+
+        const auto values = _mm256_blendv_epi8(_mm256_add_epi8(letter, ten), digit, isDigit);
+        const auto words = _mm256_maddubs_epi16(values, weights);
+        /* Packing works within the lanes, the low quadword of each lane is taken. */
+        const auto bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2),
+                         _mm256_castsi256_si128(bytes));
+    }
+    return i + decodeHexSse(in + i, size - i, out + i / 2);
+}
+
+__attribute__((target("avx2"))) void encodeBase64Avx2(const std::byte *in, std::size_t size,
+                                                      char *out) noexcept
+{
+    const auto shuffle = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const auto offsets = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0));
+
+    /* Each lane gets 12 bytes of input, so a block reads 28 bytes but consumes only 24. */
+    std::size_t i = 0;
+    for (; i + 28 <= size; i += 24) {
+        const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12));
+        auto bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+        bytes = _mm256_shuffle_epi8(bytes, shuffle);
+        const auto t0 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x0FC0FC00));
+        const auto t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const auto t2 = _mm256_and_si256(bytes, _mm256_set1_epi32(0x003F03F0));
+        const auto t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const auto sextets = _mm256_or_si256(t1, t3);
+
+        auto indices = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        indices = _mm256_sub_epi8(indices, _mm256_cmpgt_epi8(sextets, _mm256_set1_epi8(25)));
+        const auto chars = _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, indices));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i / 3 * 4), chars);
+    }
+    encodeBase64Sse(in + i, size - i, out + i / 3 * 4);
+}
+
+__attribute__((target("avx2"))) std::optional<std::size_t>
+decodeBase64Avx2(const char *in, std::size_t size, std::byte *out) noexcept
+{
+    const auto lutLo = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B,
+        0x1A));
+    const auto lutHi = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10));
+    const auto lutRoll = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const auto shuffle = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const auto slash = _mm256_set1_epi8(0x2F);
+
+    /* A block writes 32 bytes but produces only 24 of them. */
+    std::size_t i = 0;
+    for (; i + 44 <= size; i += 32) {
+        auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        const auto hiNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), slash);
+        const auto hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        const auto lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(chars, slash));
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+
+        const auto roll = _mm256_shuffle_epi8(
+            lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, slash), hiNibbles));
+        chars = _mm256_add_epi8(chars, roll);
+
+        const auto pairs = _mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140));
+        const auto triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        auto bytes = _mm256_shuffle_epi8(triples, shuffle);
+        /* The 12 bytes of each lane are put next to each other. */
+        bytes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i / 4 * 3), bytes);
+    }
+
+    const auto rest = decodeBase64Sse(in + i, size - i, out + i / 4 * 3);
+    if (!rest) {
+        return std::nullopt;
+    }
+    return i / 4 * 3 + *rest;
+}
+
+#endif
+
+struct Kernels
+{
+    void (*encodeHex)(const std::byte *, std::size_t, char *) noexcept;
+    std::size_t (*decodeHex)(const char *, std::size_t, std::byte *) noexcept;
+    void (*encodeBase64)(const std::byte *, std::size_t, char *) noexcept;
+    std::optional<std::size_t> (*decodeBase64)(const char *, std::size_t, std::byte *) noexcept;
+};
+
+Kernels selectKernels() noexcept
+{
+#ifdef NF_CODEC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {encodeHexAvx2, decodeHexAvx2, encodeBase64Avx2, decodeBase64Avx2};
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return {encodeHexSse, decodeHexSse, encodeBase64Sse, decodeBase64Sse};
+    }
+#endif
+    return {encodeHexScalar, decodeHexScalar, encodeBase64Scalar, decodeBase64Scalar};
+}
+
+const Kernels &kernels() noexcept
+{
+    static const Kernels kKernels = selectKernels();
+    return kKernels;
+}
+
+} // anonymous namespace
+
+void nf::detail::encodeHex(const std::byte *in, std::size_t size, char *out) noexcept
+{
+    kernels().encodeHex(in, size, out);
+}
+
+std::size_t nf::detail::decodeHex(const char *in, std::size_t size, std::byte *out) noexcept
+{
+    return kernels().decodeHex(in, size, out);
+}
+
+void nf::detail::encodeBase64(const std::byte *in, std::size_t size, char *out) noexcept
+{
+    kernels().encodeBase64(in, size, out);
+}
+
+std::optional<std::size_t> nf::detail::decodeBase64(const char *in, std::size_t size,
+                                                    std::byte *out) noexcept
+{
+    return kernels().decodeBase64(in, size, out);
+}
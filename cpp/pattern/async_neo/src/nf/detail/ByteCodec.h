@@ -0,0 +1,54 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Global.h>
+
+#include <cstddef>
+#include <optional>
+
+NF_BEGIN_NAMESPACE
+
+namespace detail {
+
+/*
+ * Hex and Base64 kernels of the ByteArray. Each of them has a scalar version and, on x86-64,
+ * SSE4.1 and AVX2 versions. The best version supported by the CPU is selected on the first use.
+ */
+
+/* Write 2 * size lower-case hex digits to out. */
+void encodeHex(const std::byte *in, std::size_t size, char *out) noexcept;
+
+/* Decode pairs of hex digits until the input ends or a pair contains anything else. Returns the
+ * number of characters consumed, the number of bytes written to out is a half of it. */
+std::size_t decodeHex(const char *in, std::size_t size, std::byte *out) noexcept;
+
+/* Write base64EncodedSize(size) characters of padded Base64 to out. */
+void encodeBase64(const std::byte *in, std::size_t size, char *out) noexcept;
+
+constexpr std::size_t base64EncodedSize(std::size_t size) noexcept
+{
+    return (size + 2) / 3 * 4;
+}
+
+/* Decode Base64 without padding, trailing bits which do not make a whole byte are dropped.
+ * Returns the number of bytes written to out, which must have room for base64DecodedSize(size)
+ * bytes, or nothing if the input contains a non-alphabet character or cannot be decoded. */
+std::optional<std::size_t> decodeBase64(const char *in, std::size_t size, std::byte *out) noexcept;
+
+constexpr std::size_t base64DecodedSize(std::size_t size) noexcept
+{
+    return size * 3 / 4;
+}
+
+} // namespace detail
+
+NF_END_NAMESPACE
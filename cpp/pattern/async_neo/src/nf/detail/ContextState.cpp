@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -26,12 +26,18 @@ ContextState &ContextState::from(const Context &context) noexcept
 
 void ContextState::reset(std::shared_ptr<ContextState> &state) noexcept
 {
+    /* The state is replaced rather than cleared, because tasks of the old one may still be
+     * running and their handles refer to its lists. The warmed pools go away with it. */
     auto newState = std::make_shared<ContextState>(state->m_executor);
     std::swap(state, newState);
 }
 
 ContextState::ContextState(const std::shared_ptr<Executor> &executor) noexcept
     : m_executor(executor)
+    , m_tasks(SlabAllocator<AnyFunction>(m_taskPool))
+    , m_posted(SlabAllocator<Task>(m_postedPool))
+    , m_items(SlabAllocator<Item>(m_itemPool))
+    , m_tokens(SlabAllocator<RaiiToken>(m_tokenPool))
 {
 }
 
@@ -39,15 +45,39 @@ ContextState::~ContextState() = default;
 
 void ContextState::post(Task &&task) noexcept
 {
-    auto storedTask = store(AnyFunction(std::move(task)));
-    m_executor->post([storedTask = std::move(storedTask)] { storedTask->invokeSync<Task>(); });
+    m_executor->post([postedTask = storePosted(std::move(task))] { postedTask.invoke(); });
 }
 
 void ContextState::post(Executor::Delay when, Task &&task) noexcept
 {
-    auto storedTask = store(AnyFunction(std::move(task)));
-    m_executor->post(when,
-                     [storedTask = std::move(storedTask)] { storedTask->invokeSync<Task>(); });
+    m_executor->post(when, [postedTask = storePosted(std::move(task))] { postedTask.invoke(); });
+}
+
+void ContextState::post(Executor::Priority priority, Task &&task) noexcept
+{
+    m_executor->post(priority,
+                     [postedTask = storePosted(std::move(task))] { postedTask.invoke(); });
+}
+
+void ContextState::postBatch(std::vector<Task> &&tasks) noexcept
+{
+    /* The mutex is taken only once to store the whole batch. */
+    std::vector<PostedIterator> its;
+    its.reserve(tasks.size());
+    {
+        std::unique_lock lock(m_mutex);
+        for (auto &task : tasks) {
+            its.push_back(m_posted.insert(std::end(m_posted), std::move(task)));
+        }
+    }
+
+    std::vector<Executor::Task> postedTasks;
+    postedTasks.reserve(its.size());
+    for (const auto &it : its) {
+        postedTasks.emplace_back(
+            [postedTask = PostedTask(weak_from_this(), it)] { postedTask.invoke(); });
+    }
+    m_executor->postBatch(std::move(postedTasks));
 }
 
 void ContextState::bind(Subscription &&sub) noexcept
@@ -72,7 +102,7 @@ void ContextState::bind(Item &&item) noexcept
 bool ContextState::isEmpty() const noexcept
 {
     std::unique_lock lock(m_mutex);
-    return m_tasks.empty() && m_items.empty();
+    return m_tasks.empty() && m_posted.empty() && m_items.empty();
 }
 
 bool ContextState::isThisThread() const noexcept
@@ -86,3 +116,10 @@ std::shared_ptr<ContextState::StoredTask> ContextState::store(AnyFunction &&task
     auto it = m_tasks.insert(std::end(m_tasks), std::move(task));
     return std::make_shared<StoredTask>(weak_from_this(), it);
 }
+
+ContextState::PostedTask ContextState::storePosted(Task &&task) noexcept
+{
+    std::unique_lock lock(m_mutex);
+    auto it = m_posted.insert(std::end(m_posted), std::move(task));
+    return PostedTask(weak_from_this(), it);
+}
@@ -0,0 +1,75 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/detail/MpscQueue.h"
+
+using namespace nf::detail;
+
+MpscQueue::MpscQueue() noexcept
+    : m_head(&m_stub)
+    , m_tail(&m_stub)
+{
+}
+
+void MpscQueue::push(MpscQueueNode *node) noexcept
+{
+    push(node, node);
+}
+
+void MpscQueue::push(MpscQueueNode *first, MpscQueueNode *last) noexcept
+{
+    last->m_next.store(nullptr, std::memory_order_relaxed);
+    MpscQueueNode *prev = m_head.exchange(last, std::memory_order_acq_rel);
+    /* Between the exchange above and the store below the queue is "broken": the consumer
+     * sees the previous node without a successor and pop() returns nullptr. */
+    prev->m_next.store(first, std::memory_order_release);
+}
+
+void MpscQueue::link(MpscQueueNode *node, MpscQueueNode *next) noexcept
+{
+    node->m_next.store(next, std::memory_order_relaxed);
+}
+
+MpscQueueNode *MpscQueue::pop() noexcept
+{
+    MpscQueueNode *tail = m_tail;
+    MpscQueueNode *next = tail->m_next.load(std::memory_order_acquire);
+
+    /* Skip the stub node, it is never returned to the caller. */
+    if (tail == &m_stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->m_next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+        m_tail = next;
+        return tail;
+    }
+
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        /* A producer has not linked its node yet. */
+        return nullptr;
+    }
+
+    /* The tail is the last node. Re-insert the stub behind it, so that the tail can be
+     * detached without racing with producers. */
+    push(&m_stub);
+
+    next = tail->m_next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
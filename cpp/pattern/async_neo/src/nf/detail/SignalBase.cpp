@@ -14,25 +14,33 @@
 #include <nf/Logging.h>
 #include <nf/Subscription.h>
 
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
 using namespace nf;
 using namespace nf::detail;
 
 SignalNtBase::~SignalNtBase()
 {
-    for (const auto &wListener : m_listeners) {
-        if (auto listener = wListener.lock()) {
+    const auto *snapshot = m_snapshot.load();
+    if (!snapshot) {
+        return;
+    }
+
+    for (const auto &entry : snapshot->entries) {
+        if (auto listener = entry.wListener.lock()) {
             listener->m_signal = nullptr;
             listener->decontextualize();
         }
     }
-    m_listeners.clear();
+    releaseSnapshot(snapshot);
 }
 
 Subscription SignalNtBase::bind(std::shared_ptr<ListenerNtBase> &&listener) const noexcept
 {
     std::unique_lock lock(m_mutex);
-    listener->m_it = m_listeners.insert(end(m_listeners), listener);
-    listener->m_signal = this;
+    insert(listener);
     return Subscription{std::move(listener)};
 }
 
@@ -40,16 +48,64 @@ void SignalNtBase::bind(const Context &context,
                         std::shared_ptr<ListenerNtBase> &&listener) const noexcept
 {
     std::unique_lock lock(m_mutex);
-    listener->m_it = m_listeners.insert(end(m_listeners), listener);
-    listener->m_signal = this;
+    insert(listener);
     context.bind(std::move(listener));
 }
 
+std::shared_ptr<std::atomic<std::uint64_t>> SignalNtBase::conflatedCounter() const noexcept
+{
+    std::unique_lock lock(m_mutex);
+    if (!m_conflatedCount) {
+        m_conflatedCount = std::make_shared<std::atomic<std::uint64_t>>(0);
+    }
+    return m_conflatedCount;
+}
+
+std::uint64_t SignalNtBase::loadConflatedCount() const noexcept
+{
+    std::unique_lock lock(m_mutex);
+    return m_conflatedCount ? m_conflatedCount->load(std::memory_order_relaxed) : 0;
+}
+
+void SignalNtBase::insert(const std::shared_ptr<ListenerNtBase> &listener) const noexcept
+{
+    auto snapshot = std::make_unique<Snapshot>();
+    if (const auto *current = m_snapshot.load(std::memory_order_relaxed)) {
+        snapshot->entries.reserve(current->entries.size() + 1);
+        snapshot->entries = current->entries;
+    }
+    snapshot->entries.push_back({listener.get(), listener});
+    listener->m_signal = this;
+    publish(std::move(snapshot));
+}
+
 void SignalNtBase::unbind(ListenerNtBase &listener) const noexcept
 {
     std::unique_lock lock(m_mutex);
     listener.m_signal = nullptr;
-    m_listeners.erase(listener.m_it);
+
+    const auto *current = m_snapshot.load(std::memory_order_relaxed);
+    std::unique_ptr<Snapshot> snapshot;
+    if (current->entries.size() > 1) {
+        snapshot = std::make_unique<Snapshot>();
+        snapshot->entries.reserve(current->entries.size() - 1);
+        std::copy_if(current->entries.cbegin(), current->entries.cend(),
+                     std::back_inserter(snapshot->entries),
+                     [&listener](const Entry &entry) { return entry.listener != &listener; });
+    }
+    publish(std::move(snapshot));
+}
+
+void SignalNtBase::publish(std::unique_ptr<Snapshot> &&snapshot) const noexcept
+{
+    const auto *retired = m_snapshot.exchange(snapshot.release());
+
+    /* A thread which has loaded the retired snapshot but not yet taken a reference to it is only
+     * a few instructions away from doing so. */
+    while (m_acquiring.load() != 0) {
+        std::this_thread::yield();
+    }
+    releaseSnapshot(retired);
 }
 
 ListenerNtBase::ListenerNtBase() noexcept = default;
@@ -0,0 +1,64 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/detail/SlabAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+using namespace nf::detail;
+
+SlabPool::SlabPool(std::size_t blocksPerSlab) noexcept
+    : m_blocksPerSlab(std::max<std::size_t>(blocksPerSlab, 1))
+{
+}
+
+SlabPool::~SlabPool() = default;
+
+void *SlabPool::allocate(std::size_t size)
+{
+    if (m_size == 0) {
+        /* Blocks are aligned like the global allocator does, and big enough to be linked. */
+        constexpr auto alignment = alignof(std::max_align_t);
+        m_size = size;
+        m_blockSize = (std::max(size, sizeof(FreeBlock)) + alignment - 1) / alignment * alignment;
+    }
+    if (size != m_size) {
+        return ::operator new(size);
+    }
+
+    if (!m_free) {
+        grow();
+    }
+    auto *block = m_free;
+    m_free = block->next;
+    return block;
+}
+
+void SlabPool::deallocate(void *block, std::size_t size) noexcept
+{
+    if (size != m_size) {
+        ::operator delete(block);
+        return;
+    }
+    m_free = new (block) FreeBlock{m_free};
+}
+
+void SlabPool::grow()
+{
+    /* The slab is not value-initialized, the blocks are constructed by their users. */
+    m_slabs.emplace_back(new std::byte[m_blocksPerSlab * m_blockSize]);
+    auto *slab = m_slabs.back().get();
+
+    /* Link the blocks in address order, so that they are handed out in that order. */
+    for (auto i = m_blocksPerSlab; i > 0; --i) {
+        m_free = new (slab + (i - 1) * m_blockSize) FreeBlock{m_free};
+    }
+}
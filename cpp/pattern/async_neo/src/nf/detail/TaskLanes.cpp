@@ -0,0 +1,104 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/detail/TaskLanes.h"
+
+using namespace nf;
+using namespace detail;
+
+namespace {
+
+/* Number of tasks a lane may run per round, indexed by priority. */
+constexpr std::array<unsigned, 3> kWeights{16, 4, 1};
+
+static_assert(static_cast<std::size_t>(Executor::Priority::Background) + 1 == kWeights.size());
+
+std::size_t toIndex(Executor::Priority priority) noexcept
+{
+    return static_cast<std::size_t>(priority);
+}
+
+} // anonymous namespace
+
+TaskLanes::Node::Node(Executor::Task &&task) noexcept
+    : task(std::move(task))
+{
+}
+
+TaskLanes::TaskLanes() noexcept
+    : m_credit(kWeights[0])
+{
+}
+
+TaskLanes::~TaskLanes()
+{
+    discard();
+}
+
+void TaskLanes::push(Priority priority, Executor::Task &&task) noexcept
+{
+    /* The depth is raised first, so that the consumer never takes it below zero. */
+    auto &lane = m_lanes[toIndex(priority)];
+    lane.depth.fetch_add(1, std::memory_order_relaxed);
+    lane.queue.push(new Node(std::move(task)));
+}
+
+void TaskLanes::push(Priority priority, std::vector<Executor::Task> &&tasks) noexcept
+{
+    if (tasks.empty()) {
+        return;
+    }
+
+    auto *first = new Node(std::move(tasks.front()));
+    auto *last = first;
+    for (auto it = std::next(tasks.begin()); it != tasks.end(); ++it) {
+        auto *node = new Node(std::move(*it));
+        MpscQueue::link(last, node);
+        last = node;
+    }
+
+    auto &lane = m_lanes[toIndex(priority)];
+    lane.depth.fetch_add(tasks.size(), std::memory_order_relaxed);
+    lane.queue.push(first, last);
+}
+
+std::unique_ptr<TaskLanes::Node> TaskLanes::pop() noexcept
+{
+    /* Visit every lane once, and the current one again with a fresh credit if it has used up
+     * its credit while the others are empty. */
+    for (std::size_t i = 0; i <= kLaneCount; ++i) {
+        if (m_credit > 0) {
+            auto &lane = m_lanes[m_current];
+            if (auto *node = lane.queue.pop()) {
+                --m_credit;
+                lane.depth.fetch_sub(1, std::memory_order_relaxed);
+                return std::unique_ptr<Node>(static_cast<Node *>(node));
+            }
+        }
+        m_current = (m_current + 1) % kLaneCount;
+        m_credit = kWeights[m_current];
+    }
+    return nullptr;
+}
+
+std::size_t TaskLanes::depth(Priority priority) const noexcept
+{
+    return m_lanes[toIndex(priority)].depth.load(std::memory_order_relaxed);
+}
+
+void TaskLanes::discard() noexcept
+{
+    for (auto &lane : m_lanes) {
+        while (auto *node = lane.queue.pop()) {
+            lane.depth.fetch_sub(1, std::memory_order_relaxed);
+            delete static_cast<Node *>(node);
+        }
+    }
+}
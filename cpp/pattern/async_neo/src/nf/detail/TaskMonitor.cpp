@@ -0,0 +1,226 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "nf/detail/TaskMonitor.h"
+
+#include <nf/Demangle.h>
+#include <nf/Logging.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace nf;
+using namespace nf::detail;
+
+using Durations = Executor::Statistics::Durations;
+
+namespace {
+
+thread_local const source_location *t_postSite = nullptr;
+
+} // anonymous namespace
+
+PostSite::PostSite(const source_location &location) noexcept
+    : m_previous(std::exchange(t_postSite, &location))
+{
+}
+
+PostSite::~PostSite()
+{
+    t_postSite = m_previous;
+}
+
+const source_location *PostSite::current() noexcept
+{
+    return t_postSite;
+}
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t value) noexcept
+{
+    if (value < 2 * kSubBuckets) {
+        return value;
+    }
+    const int shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + (value >> shift) - kSubBuckets;
+}
+
+std::uint64_t LatencyHistogram::highestOf(std::size_t bucket) noexcept
+{
+    if (bucket < 2 * kSubBuckets) {
+        return bucket;
+    }
+    const auto shift = bucket / kSubBuckets - 1;
+    const auto lowest = (bucket % kSubBuckets + kSubBuckets) << shift;
+    return lowest + (std::uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) noexcept
+{
+    const auto value = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+    m_counts[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+Durations LatencyHistogram::durations() const noexcept
+{
+    /* Buckets are read one by one while other threads record, so the result is only
+     * approximately consistent. The percentiles are computed from the buckets themselves. */
+    std::array<std::uint64_t, kBuckets> counts;
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    Durations result;
+    result.count = total;
+    if (total == 0) {
+        return result;
+    }
+
+    const auto percentile = [&](std::uint64_t permille) {
+        const auto rank = std::max<std::uint64_t>((total * permille + 999) / 1000, 1);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(highestOf(i));
+            }
+        }
+        return std::chrono::nanoseconds(highestOf(kBuckets - 1));
+    };
+
+    const auto max = std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+    result.mean = std::chrono::nanoseconds(m_sum.load(std::memory_order_relaxed) / total);
+    result.p50 = std::min(percentile(500), max);
+    result.p99 = std::min(percentile(990), max);
+    result.max = max;
+    return result;
+}
+
+/* Keeps the task together with its enqueue time and the location it was posted from. A task
+ * which is destroyed without being run, e.g. because the executor discards its queue, leaves the
+ * queue as well. */
+class TaskMonitor::MonitoredTask
+{
+public:
+    MonitoredTask(TaskMonitor &monitor, Executor::Task &&task,
+                  const source_location *site) noexcept
+        : m_monitor(&monitor)
+        , m_posted(Clock::now())
+        , m_task(std::move(task))
+    {
+        if (site) {
+            m_site = *site;
+        }
+    }
+
+    MonitoredTask(MonitoredTask &&other) noexcept
+        : m_monitor(std::exchange(other.m_monitor, nullptr))
+        , m_posted(other.m_posted)
+        , m_task(std::move(other.m_task))
+        , m_site(other.m_site)
+    {
+    }
+
+    ~MonitoredTask()
+    {
+        if (m_monitor) {
+            m_monitor->m_queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void operator()()
+    {
+        std::exchange(m_monitor, nullptr)->run(m_task, m_posted, m_site);
+    }
+
+private:
+    /* The executor destroys its queue before itself, so the monitor outlives all tasks. */
+    TaskMonitor *m_monitor;
+    Clock::time_point m_posted;
+    Executor::Task m_task;
+    std::optional<source_location> m_site;
+};
+
+TaskMonitor::TaskMonitor(const Executor &executor,
+                         std::chrono::microseconds slowTaskThreshold) noexcept
+    : m_executor(executor)
+    , m_slowTaskThreshold(std::chrono::nanoseconds(slowTaskThreshold).count())
+{
+}
+
+void TaskMonitor::setSlowTaskThreshold(std::chrono::microseconds slowTaskThreshold) noexcept
+{
+    m_slowTaskThreshold.store(std::chrono::nanoseconds(slowTaskThreshold).count(),
+                              std::memory_order_relaxed);
+}
+
+void TaskMonitor::wrap(Executor::Task &task) noexcept
+{
+    m_queued.fetch_add(1, std::memory_order_relaxed);
+    task = MonitoredTask(*this, std::move(task), PostSite::current());
+}
+
+void TaskMonitor::run(Executor::Task &task, Clock::time_point posted,
+                      const std::optional<source_location> &site)
+{
+    const auto started = Clock::now();
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    m_queueWait.record(started - posted);
+
+    try {
+        task();
+    } catch (...) {
+        finish(task, started, site);
+        throw;
+    }
+    finish(task, started, site);
+}
+
+void TaskMonitor::finish(const Executor::Task &task, Clock::time_point started,
+                         const std::optional<source_location> &site) noexcept
+{
+    const auto runTime = Clock::now() - started;
+    m_runTime.record(runTime);
+
+    const auto threshold = m_slowTaskThreshold.load(std::memory_order_relaxed);
+    if (runTime.count() <= threshold) {
+        return;
+    }
+
+    m_slowTasks.fetch_add(1, std::memory_order_relaxed);
+    const auto runTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(runTime).count();
+    if (site) {
+        nf::warn("Executor {} ran a task for {}us, more than {}us: posted at {}:{} ({})",
+                 fmt::ptr(&m_executor), runTimeUs, threshold / 1000, site->file_name(),
+                 site->line(), site->function_name());
+    } else {
+        /* Posted directly to the executor, the target is the task itself. */
+        nf::warn("Executor {} ran a task for {}us, more than {}us: {}", fmt::ptr(&m_executor),
+                 runTimeUs, threshold / 1000, demangle(task.targetType().name()));
+    }
+}
+
+Executor::Statistics TaskMonitor::statistics() const noexcept
+{
+    Executor::Statistics result;
+    result.queued = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(m_queued.load(std::memory_order_relaxed), 0));
+    result.slowTasks = m_slowTasks.load(std::memory_order_relaxed);
+    result.queueWait = m_queueWait.durations();
+    result.runTime = m_runTime.durations();
+    return result;
+}
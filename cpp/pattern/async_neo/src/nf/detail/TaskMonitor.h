@@ -0,0 +1,88 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <nf/Executor.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+NF_BEGIN_NAMESPACE
+
+namespace detail {
+
+/*
+ * A histogram of durations in nanoseconds with log-linear buckets, like HdrHistogram: values
+ * below 16 have their own buckets, and every following power of two is split into 8 buckets.
+ * Hence a value is reported with an error of less than 12.5%. Recording is lock-free and may
+ * happen concurrently with reading.
+ */
+class LatencyHistogram
+{
+public:
+    void record(std::chrono::nanoseconds duration) noexcept;
+    Executor::Statistics::Durations durations() const noexcept;
+
+private:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr std::size_t kBuckets = (64 - kSubBucketBits) * kSubBuckets;
+
+    static std::size_t bucketOf(std::uint64_t value) noexcept;
+    /* The highest value which falls into the bucket. */
+    static std::uint64_t highestOf(std::size_t bucket) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> m_counts{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+/* Collects the statistics of an executor, see Executor::enableStatistics(). */
+class TaskMonitor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TaskMonitor(const Executor &executor, std::chrono::microseconds slowTaskThreshold) noexcept;
+
+    void setSlowTaskThreshold(std::chrono::microseconds slowTaskThreshold) noexcept;
+
+    /* Wrap the task to record its statistics when it runs. The task must be enqueued right
+     * after that. */
+    void wrap(Executor::Task &task) noexcept;
+
+    Executor::Statistics statistics() const noexcept;
+
+private:
+    class MonitoredTask;
+
+    void run(Executor::Task &task, Clock::time_point posted,
+             const std::optional<source_location> &site);
+    void finish(const Executor::Task &task, Clock::time_point started,
+                const std::optional<source_location> &site) noexcept;
+
+private:
+    const Executor &m_executor;
+    std::atomic<std::int64_t> m_slowTaskThreshold;
+    std::atomic<std::int64_t> m_queued{0};
+    std::atomic<std::uint64_t> m_slowTasks{0};
+    LatencyHistogram m_queueWait;
+    LatencyHistogram m_runTime;
+};
+
+} // namespace detail
+
+NF_END_NAMESPACE
@@ -0,0 +1,66 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace nf::testing;
+
+namespace {
+
+std::atomic<int> g_counters{0};
+std::atomic<std::size_t> g_allocations{0};
+
+} // anonymous namespace
+
+void *operator new(std::size_t size)
+{
+    if (g_counters.load(std::memory_order_relaxed) > 0) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (auto *ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+AllocationCounter::AllocationCounter() noexcept
+{
+    g_counters.fetch_add(1);
+    restart();
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    g_counters.fetch_sub(1);
+}
+
+std::size_t AllocationCounter::count() const noexcept
+{
+    return g_allocations.load() - m_start;
+}
+
+void AllocationCounter::restart() noexcept
+{
+    m_start = g_allocations.load();
+}
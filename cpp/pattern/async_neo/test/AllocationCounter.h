@@ -0,0 +1,37 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+
+#include <cstddef>
+
+namespace nf::testing {
+
+/* Counts the allocations made by all threads while it is alive. The test binary replaces the
+ * global operator new once for all counters, and the replacement only counts while a counter
+ * is alive. */
+class AllocationCounter : boost::noncopyable
+{
+public:
+    AllocationCounter() noexcept;
+    ~AllocationCounter();
+
+public:
+    /* The number of allocations since construction or the last restart(). */
+    std::size_t count() const noexcept;
+    void restart() noexcept;
+
+private:
+    std::size_t m_start;
+};
+
+} // namespace nf::testing
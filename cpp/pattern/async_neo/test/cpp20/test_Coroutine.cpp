@@ -0,0 +1,302 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include "../AllocationCounter.h"
+
+#include <nf/async/Coroutine.h>
+
+#include <nf/Context.h>
+#include <nf/Future.h>
+#include <nf/Logging.h>
+#include <nf/Promise.h>
+#include <nf/RaiiToken.h>
+#include <nf/testing/Test.h>
+
+#include <chrono>
+#include <thread>
+
+#ifndef NF_HAS_COROUTINES
+#error "The coroutine tests are built as C++20 with coroutine support"
+#endif
+
+using namespace nf;
+using namespace nf::async;
+using namespace nf::testing;
+
+class CoroutineTest : public Test
+{
+};
+
+namespace {
+
+Task<int> addOne(const Context &, Future<int> future)
+{
+    auto value = co_await future;
+    co_return value + 1;
+}
+
+Task<void> waitFor(const Context &, Future<void> future, bool &isDone)
+{
+    co_await future;
+    isDone = true;
+}
+
+Task<int> addTwo(const Context &context, Future<int> future)
+{
+    auto value = co_await addOne(context, std::move(future));
+    co_return value + 1;
+}
+
+Task<void> waitForever(const Context &, const Promise<int> &promise, RaiiToken token,
+                       bool &isResumed)
+{
+    co_await promise.future();
+    isResumed = true;
+}
+
+Future<int> fulfillLater(const Context &context, int value)
+{
+    Promise<int> promise;
+    context.post([promise, value] { promise.fulfill(value); });
+    return promise.future();
+}
+
+Task<int> countUp(const Context &context, int steps)
+{
+    int value = 0;
+    for (int step = 0; step < steps; ++step) {
+        value = co_await fulfillLater(context, value + 1);
+    }
+    co_return value;
+}
+
+class Counter
+{
+public:
+    Counter(const Context &context, int steps)
+        : m_context{context}
+        , m_steps{steps}
+    {
+    }
+
+    void next(int value)
+    {
+        if (value == m_steps) {
+            m_result = value;
+            return;
+        }
+        fulfillLater(m_context, value + 1).then(m_context, [this](int v) { next(v); });
+    }
+
+    std::optional<int> m_result;
+
+private:
+    const Context &m_context;
+    int m_steps;
+};
+
+class Doubler
+{
+public:
+    Task<int> twice(const Context &, Future<int> future)
+    {
+        co_return co_await future * m_factor;
+    }
+
+private:
+    int m_factor = 2;
+};
+
+} // anonymous namespace
+
+TEST_F(CoroutineTest, awaitReadyFuture)
+{
+    Context context;
+    std::optional<int> result;
+
+    addOne(context, Future<int>{41}).future().then(context, [&](int value) { result = value; });
+    processEvents();
+
+    EXPECT_EQ(42, result);
+    EXPECT_TRUE(context.isEmpty());
+}
+
+TEST_F(CoroutineTest, awaitPromise)
+{
+    Context context;
+    Promise<int> promise;
+    std::optional<int> result;
+
+    addOne(context, promise.future()).future().then(context, [&](int value) { result = value; });
+    processEvents();
+    EXPECT_FALSE(result);
+
+    promise.fulfill(1);
+    processEvents();
+    EXPECT_EQ(2, result);
+    EXPECT_TRUE(context.isEmpty());
+}
+
+TEST_F(CoroutineTest, awaitVoid)
+{
+    Context context;
+    Promise<void> promise;
+    bool isDone = false;
+
+    waitFor(context, promise.future(), isDone);
+    processEvents();
+    EXPECT_FALSE(isDone);
+
+    promise.fulfill();
+    processEvents();
+    EXPECT_TRUE(isDone);
+}
+
+TEST_F(CoroutineTest, awaitTask)
+{
+    Context context;
+    Promise<int> promise;
+    std::optional<int> result;
+
+    addTwo(context, promise.future()).future().then(context, [&](int value) { result = value; });
+    promise.fulfill(40);
+    processEvents();
+
+    EXPECT_EQ(42, result);
+    EXPECT_TRUE(context.isEmpty());
+}
+
+TEST_F(CoroutineTest, awaitLambda)
+{
+    Context context;
+    std::optional<int> result;
+
+    auto coroutine = [](const Context &, int value) -> Task<int> {
+        co_return co_await Future<int>{value} * 2;
+    };
+    coroutine(context, 21).future().then(context, [&](int value) { result = value; });
+    processEvents();
+
+    EXPECT_EQ(42, result);
+}
+
+TEST_F(CoroutineTest, awaitMember)
+{
+    Context context;
+    Doubler doubler;
+    std::optional<int> result;
+
+    doubler.twice(context, Future<int>{21}).future().then(context, [&](int value) {
+        result = value;
+    });
+    processEvents();
+
+    EXPECT_EQ(42, result);
+}
+
+/* The coroutine shall be resumed on the executor of its context, not by the fulfilling thread. */
+TEST_F(CoroutineTest, resumedOnContextThread)
+{
+    Context context;
+    Promise<int> promise;
+    std::thread::id resumedOn;
+
+    auto coroutine = [&](const Context &, Future<int> future) -> Task<void> {
+        co_await future;
+        resumedOn = std::this_thread::get_id();
+    };
+    coroutine(context, promise.future());
+
+    std::thread([promise] { promise.fulfill(1); }).join();
+    EXPECT_EQ(std::thread::id{}, resumedOn);
+
+    processEvents();
+    EXPECT_EQ(std::this_thread::get_id(), resumedOn);
+}
+
+/* Resetting the context shall destroy the suspended coroutine. */
+TEST_F(CoroutineTest, contextReset)
+{
+    Context context;
+    Promise<int> promise;
+    bool isDestroyed = false;
+    bool isResumed = false;
+
+    waitForever(context, promise,
+                RaiiToken::nonDismissible([&] { isDestroyed = true; }), isResumed);
+    processEvents();
+    EXPECT_FALSE(isDestroyed);
+
+    context.reset();
+    EXPECT_TRUE(isDestroyed);
+
+    promise.fulfill(1);
+    processEvents();
+    EXPECT_FALSE(isResumed);
+}
+
+/* A promise destroyed without being fulfilled shall destroy the coroutine awaiting it. */
+TEST_F(CoroutineTest, brokenPromise)
+{
+    Context context;
+    std::optional<Promise<int>> promise{std::in_place};
+    bool isDestroyed = false;
+    bool isResumed = false;
+
+    waitForever(context, *promise,
+                RaiiToken::nonDismissible([&] { isDestroyed = true; }), isResumed);
+    processEvents();
+    EXPECT_FALSE(isDestroyed);
+
+    promise.reset();
+    EXPECT_TRUE(isDestroyed);
+    EXPECT_FALSE(isResumed);
+    EXPECT_TRUE(context.isEmpty());
+}
+
+/* Awaiting a future does not allocate, unlike attaching a continuation to it. This does not
+ * assert on the timing, it is logged to compare the implementations. */
+TEST_F(CoroutineTest, allocationsPerStep_benchmark)
+{
+    constexpr int kSteps = 10000;
+
+    Context context;
+    std::optional<int> result;
+
+    AllocationCounter allocations;
+    auto start = std::chrono::steady_clock::now();
+    countUp(context, kSteps).future().then(context, [&](int value) { result = value; });
+    while (!result) {
+        processEvents();
+    }
+    const auto coroutineUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+    const auto coroutineAllocations = allocations.count();
+    EXPECT_EQ(kSteps, result);
+
+    Counter counter{context, kSteps};
+    allocations.restart();
+    start = std::chrono::steady_clock::now();
+    counter.next(0);
+    while (!counter.m_result) {
+        processEvents();
+    }
+    const auto chainUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    const auto chainAllocations = allocations.count();
+    EXPECT_EQ(kSteps, counter.m_result);
+
+    EXPECT_LT(coroutineAllocations, chainAllocations);
+    nf::info("{} steps: coroutine {} allocations in {}us, continuations {} allocations in {}us",
+             kSteps, coroutineAllocations, coroutineUs, chainAllocations, chainUs);
+}
+
@@ -14,6 +14,7 @@
 #include <nf/Context.h>
 #include <nf/Executor.h>
 #include <nf/Future.h>
+#include <nf/Logging.h>
 #include <nf/Result.h>
 #include <nf/async/Execute.h>
 #include <nf/testing/Test.h>
@@ -21,6 +22,7 @@
 
 #include <boost/hana/functional/overload.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <optional>
 #include <string>
@@ -353,6 +355,18 @@ TEST_F(FuturePromise, objectLifetime)
         context.reset();
         EXPECT_THAT(p.use_count(), 1);
     }
+    // Continuation's lambda deleted immediately when context is reset, returned future held
+    {
+        nf::Context context;
+        auto p = std::make_shared<int>(0);
+
+        Promise<void> promise;
+        auto future = promise.future().then(context, [p] { return 5; });
+        EXPECT_THAT(p.use_count(), 2);
+
+        context.reset();
+        EXPECT_THAT(p.use_count(), 1);
+    }
     // Continuation's lambda deleted immediately when context is reset, nested future
     {
         nf::Context context;
@@ -445,6 +459,40 @@ TEST_F(FuturePromise, threading)
     ASSERT_EQ(50, result);
 }
 
+TEST_F(FuturePromise, longChain_throughput)
+{
+    constexpr int kChains = 100;
+    constexpr int kSteps = 1000;
+
+    Context context;
+    int cntFinished = 0;
+
+    /* This does not assert on the timing, it is logged to compare the implementations. */
+    const auto start = std::chrono::steady_clock::now();
+    for (int chain = 0; chain < kChains; ++chain) {
+        Promise<int> promise;
+        auto future = promise.future().then(context, [](int value) { return value + 1; });
+        for (int step = 1; step < kSteps; ++step) {
+            future = future.then(context, [](int value) { return value + 1; });
+        }
+        future.then(context, [&](int value) {
+            EXPECT_EQ(kSteps, value);
+            ++cntFinished;
+        });
+
+        promise.fulfill(0);
+        processEvents();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(kChains, cntFinished);
+    EXPECT_TRUE(context.isEmpty());
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    nf::info("{} chains of {} steps in {}us ({} steps/ms)", kChains, kSteps, us,
+             us > 0 ? kChains * kSteps * 1000LL / us : 0);
+}
+
 TEST_F(FuturePromise, valueType)
 {
     static_assert(std::is_same_v<int, Future<int>::ValueType>);
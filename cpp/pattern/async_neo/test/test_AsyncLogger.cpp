@@ -0,0 +1,304 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include <nf/Logging.h>
+#include <nf/backend/AsyncLogger.h>
+#include <nf/backend/MemoryLogger.h>
+#include <nf/testing/Test.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace nf;
+using namespace nf::backend;
+using namespace nf::testing;
+
+using OverflowPolicy = AsyncLogger::OverflowPolicy;
+
+namespace {
+
+/* A backend which blocks in write() until it is released. */
+class GateLogger : public MemoryLogger
+{
+public:
+    using MemoryLogger::write;
+
+    void write(const LogEntry &logEntry) noexcept override
+    {
+        std::unique_lock lock(m_gateM);
+        ++m_entered;
+        m_changed.notify_all();
+        m_changed.wait(lock, [this] { return m_isOpen; });
+        lock.unlock();
+        MemoryLogger::write(logEntry);
+    }
+
+    void waitEntered(int count)
+    {
+        std::unique_lock lock(m_gateM);
+        m_changed.wait(lock, [this, count] { return m_entered >= count; });
+    }
+
+    void open()
+    {
+        std::unique_lock lock(m_gateM);
+        m_isOpen = true;
+        m_changed.notify_all();
+    }
+
+private:
+    std::mutex m_gateM;
+    std::condition_variable m_changed;
+    int m_entered = 0;
+    bool m_isOpen = false;
+};
+
+/* A backend which takes a fixed time for every entry, like a saturated output. */
+class SlowLogger : public LogBackend
+{
+public:
+    explicit SlowLogger(std::chrono::nanoseconds delay)
+        : m_delay(delay)
+    {
+    }
+
+    void write(const LogContext &context, LogLevel level,
+               const std::string &message) noexcept override
+    {
+        write({context, level, message, {}});
+    }
+
+    void write(const LogEntry & /*logEntry*/) noexcept override
+    {
+        const auto until = std::chrono::steady_clock::now() + m_delay;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+private:
+    std::chrono::nanoseconds m_delay;
+};
+
+LogEntry makeEntry(std::string_view message)
+{
+    return {ActiveLogContext, LogLevel::Info, message, {}};
+}
+
+std::vector<std::string> messages(const MemoryLogger &logger)
+{
+    std::vector<std::string> result;
+    for (const auto &logEntry : logger.logEntries()) {
+        result.push_back(logEntry.message);
+    }
+    return result;
+}
+
+} // namespace
+
+class AsyncLoggerTest : public Test
+{
+};
+
+TEST_F(AsyncLoggerTest, write_flush)
+{
+    auto memory = std::make_shared<MemoryLogger>();
+    AsyncLogger logger({memory});
+
+    logger.write(makeEntry("one"));
+    logger.write(makeEntry("two"));
+    logger.flush();
+
+    EXPECT_EQ((std::vector<std::string>{"one", "two"}), messages(*memory));
+    EXPECT_EQ(0, logger.droppedCount());
+}
+
+TEST_F(AsyncLoggerTest, destruction_writesPending)
+{
+    auto memory = std::make_shared<MemoryLogger>();
+    {
+        AsyncLogger logger({memory}, OverflowPolicy::Block, 4);
+        for (int i = 0; i < 100; ++i) {
+            logger.write(makeEntry(std::to_string(i)));
+        }
+    }
+
+    EXPECT_EQ(100, memory->logEntries().size());
+}
+
+/* Entries of each thread keep their order. */
+TEST_F(AsyncLoggerTest, write_manyThreads)
+{
+    constexpr int kThreads = 4;
+    constexpr int kEntries = 1000;
+
+    auto memory = std::make_shared<MemoryLogger>();
+    AsyncLogger logger({memory}, OverflowPolicy::Block, 16);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < kEntries; ++i) {
+                logger.write(makeEntry(fmt::format("{} {}", t, i)));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    logger.flush();
+
+    std::vector<int> next(kThreads, 0);
+    for (const auto &message : messages(*memory)) {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(2, std::sscanf(message.c_str(), "%d %d", &t, &i));
+        EXPECT_EQ(next[t]++, i);
+    }
+    EXPECT_EQ(std::vector<int>(kThreads, kEntries), next);
+}
+
+TEST_F(AsyncLoggerTest, overflow_drop)
+{
+    auto gate = std::make_shared<GateLogger>();
+    AsyncLogger logger({gate}, OverflowPolicy::Drop, 4);
+
+    logger.write(makeEntry("first"));
+    gate->waitEntered(1);
+
+    /* The entry being written still occupies its slot, so only 3 more fit. */
+    for (int i = 0; i < 10; ++i) {
+        logger.write(makeEntry(std::to_string(i)));
+    }
+    EXPECT_EQ(7, logger.droppedCount());
+
+    gate->open();
+    logger.flush();
+    EXPECT_EQ((std::vector<std::string>{"first", "0", "1", "2"}), messages(*gate));
+}
+
+TEST_F(AsyncLoggerTest, overflow_dropAndReport)
+{
+    auto gate = std::make_shared<GateLogger>();
+    AsyncLogger logger({gate}, OverflowPolicy::DropAndReport, 2);
+
+    logger.write(makeEntry("first"));
+    gate->waitEntered(1);
+    for (int i = 0; i < 5; ++i) {
+        logger.write(makeEntry(std::to_string(i)));
+    }
+
+    gate->open();
+    logger.flush();
+
+    const auto logEntries = gate->logEntries();
+    ASSERT_EQ(3, logEntries.size());
+    EXPECT_EQ("0", logEntries[1].message);
+    EXPECT_EQ(LogLevel::Warn, logEntries[2].logLevel);
+    EXPECT_EQ("4 log entries were dropped because of a full buffer", logEntries[2].message);
+}
+
+TEST_F(AsyncLoggerTest, overflow_block)
+{
+    auto memory = std::make_shared<MemoryLogger>();
+    AsyncLogger logger({memory}, OverflowPolicy::Block, 2);
+
+    for (int i = 0; i < 1000; ++i) {
+        logger.write(makeEntry(std::to_string(i)));
+    }
+    logger.flush();
+
+    EXPECT_EQ(1000, memory->logEntries().size());
+    EXPECT_EQ(0, logger.droppedCount());
+}
+
+TEST_F(AsyncLoggerTest, suspendAndResume_forwarded)
+{
+    class SuspendableMemoryLogger : public MemoryLogger
+    {
+    public:
+        void suspendOutput() noexcept override
+        {
+            m_isSuspended = true;
+        }
+        void resumeOutput() noexcept override
+        {
+            m_isSuspended = false;
+        }
+        bool isSuspended() const noexcept override
+        {
+            return m_isSuspended;
+        }
+
+    private:
+        bool m_isSuspended = false;
+    };
+
+    AsyncLogger logger({std::make_shared<SuspendableMemoryLogger>()});
+    EXPECT_FALSE(logger.isSuspended());
+    logger.suspendOutput();
+    EXPECT_TRUE(logger.isSuspended());
+    logger.resumeOutput();
+    EXPECT_FALSE(logger.isSuspended());
+}
+
+TEST_F(AsyncLoggerTest, loggingFlush)
+{
+    auto memory = std::make_shared<MemoryLogger>();
+    Logging::initialize({std::make_shared<AsyncLogger>(
+        std::vector<std::shared_ptr<LogBackend>>{memory})});
+
+    nf::info("Hello {}", "async");
+    Logging::flush();
+    ASSERT_FALSE(memory->logEntries().empty());
+    EXPECT_EQ("Hello async", memory->logEntries().back().message);
+
+    Logging::terminate();
+}
+
+/* Compares the time spent in a log call with a sink taking 20us per entry, written directly and
+ * through the AsyncLogger. */
+TEST_F(AsyncLoggerTest, DISABLED_latency_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kEntries = 20000;
+    constexpr auto kSinkDelay = std::chrono::microseconds(20);
+
+    const auto measure = [](LogBackend &backend) {
+        std::vector<Clock::duration> latencies;
+        latencies.reserve(kEntries);
+        const auto logEntry = makeEntry("A message of a typical length, 42 and 3.14");
+        for (int i = 0; i < kEntries; ++i) {
+            const auto start = Clock::now();
+            backend.write(logEntry);
+            latencies.push_back(Clock::now() - start);
+        }
+        std::sort(latencies.begin(), latencies.end());
+        return latencies;
+    };
+
+    const auto report = [](std::string_view name, const std::vector<Clock::duration> &latencies) {
+        const auto at = [&latencies](double percentile) {
+            const auto index = static_cast<std::size_t>(percentile * (latencies.size() - 1));
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(latencies[index]).count();
+        };
+        nf::info("{}: p50 {}ns, p99 {}ns, p999 {}ns", name, at(0.5), at(0.99), at(0.999));
+    };
+
+    SlowLogger direct{kSinkDelay};
+    report("direct", measure(direct));
+
+    AsyncLogger async({std::make_shared<SlowLogger>(kSinkDelay)}, OverflowPolicy::Drop);
+    report("async", measure(async));
+    nf::info("async: {} of {} entries dropped", async.droppedCount(), kEntries);
+}
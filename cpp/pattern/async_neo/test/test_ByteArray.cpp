@@ -10,9 +10,12 @@
  */
 
 #include <nf/ByteArray.h>
+#include <nf/Logging.h>
 #include <nf/testing/Test.h>
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <cstring>
 #include <iterator>
 #include <vector>
@@ -1280,3 +1283,107 @@ TEST_F(ByteArrayTest, fromBase64_trailingNullBytes)
         EXPECT_EQ(*resultArr, input);
     }
 }
+
+TEST_F(ByteArrayTest, toHex)
+{
+    EXPECT_EQ("", ByteArray{}.toHex());
+    EXPECT_EQ("00", (0x00_hex).toHex());
+    EXPECT_EQ("0a2b3c4f9812", (0x0A'2B'3C'4F'98'12_hex).toHex());
+    EXPECT_EQ(asciiByteArray(), ByteArray::fromHex(asciiByteArray().toHex()).value());
+}
+
+/* The sizes cross the block boundaries of all codec kernels. */
+TEST_F(ByteArrayTest, codecs_roundTrip)
+{
+    ByteArray input;
+    for (std::size_t size = 0; size < 200; ++size) {
+        const auto hex = input.toHex();
+        ASSERT_EQ(2 * size, hex.size());
+        EXPECT_EQ(input, ByteArray::fromHex(hex).value());
+
+        auto upperHex = hex;
+        std::transform(upperHex.begin(), upperHex.end(), upperHex.begin(),
+                       [](char ch) { return static_cast<char>(std::toupper(ch)); });
+        EXPECT_EQ(input, ByteArray::fromHex(upperHex).value());
+
+        EXPECT_EQ(input, ByteArray::fromBase64(input.toBase64()).value());
+
+        input.push_back(static_cast<std::byte>(size * 37 + 11));
+    }
+}
+
+TEST_F(ByteArrayTest, fromHex_longWithSeparators)
+{
+    const auto input = asciiByteArray();
+    const auto hex = input.toHex();
+
+    std::string separated;
+    for (std::size_t i = 0; i < hex.size(); i += 2) {
+        separated.append(hex, i, 2).append(i % 40 == 0 ? " " : "");
+    }
+    EXPECT_EQ(input, ByteArray::fromHex(separated).value());
+    EXPECT_FALSE(ByteArray::fromHex(separated + "0").hasValue());
+
+    auto invalid = hex;
+    invalid[hex.size() - 3] = 'g';
+    EXPECT_FALSE(ByteArray::fromHex(invalid).hasValue());
+}
+
+TEST_F(ByteArrayTest, fromBase64_longWithIllegalCharacter)
+{
+    const auto base64 = asciiByteArray().toBase64();
+
+    for (const auto index : {std::size_t{0}, std::size_t{100}, base64.size() - 5}) {
+        auto invalid = base64;
+        invalid[index] = '*';
+        EXPECT_FALSE(ByteArray::fromBase64(invalid).hasValue());
+    }
+}
+
+TEST_F(ByteArrayTest, DISABLED_codecs_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kTotalBytes = 64 << 20;
+
+    const auto gbPerSecond = [](std::size_t bytes, Clock::duration elapsed) {
+        const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        return static_cast<double>(bytes) / ns;
+    };
+
+    for (const std::size_t size : {64, 4 << 10, 1 << 20}) {
+        ByteArray input;
+        for (std::size_t i = 0; i < size; ++i) {
+            input.push_back(static_cast<std::byte>(i * 37 + 11));
+        }
+        const auto rounds = kTotalBytes / size;
+        const auto hex = input.toHex();
+        const auto base64 = input.toBase64();
+
+        std::size_t checksum = 0;
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < rounds; ++i) {
+            checksum += input.toHex().size();
+        }
+        const auto hexEncoded = Clock::now();
+        for (std::size_t i = 0; i < rounds; ++i) {
+            checksum += ByteArray::fromHex(hex)->size();
+        }
+        const auto hexDecoded = Clock::now();
+        for (std::size_t i = 0; i < rounds; ++i) {
+            checksum += input.toBase64().size();
+        }
+        const auto base64Encoded = Clock::now();
+        for (std::size_t i = 0; i < rounds; ++i) {
+            checksum += ByteArray::fromBase64(base64)->size();
+        }
+        const auto base64Decoded = Clock::now();
+        EXPECT_EQ(rounds * (4 * size + base64.size()), checksum);
+
+        nf::info("{} bytes: toHex {:.2f} GB/s, fromHex {:.2f} GB/s, toBase64 {:.2f} GB/s, "
+                 "fromBase64 {:.2f} GB/s",
+                 size, gbPerSecond(kTotalBytes, hexEncoded - start),
+                 gbPerSecond(kTotalBytes, hexDecoded - hexEncoded),
+                 gbPerSecond(kTotalBytes, base64Encoded - hexDecoded),
+                 gbPerSecond(kTotalBytes, base64Decoded - base64Encoded));
+    }
+}
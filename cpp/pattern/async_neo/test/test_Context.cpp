@@ -1,7 +1,7 @@
 /*
  * BMW Neo Framework
  *
- * Copyright (C) 2021-2022 BMW Car IT GmbH. All rights reserved.
+ * Copyright (C) 2021-2023 BMW Car IT GmbH. All rights reserved.
  * Contact: http://www.bmw-carit.de/
  *
  * Contributors:
@@ -11,12 +11,18 @@
 
 #include <nf/Context.h>
 #include <nf/Executor.h>
+#include <nf/Logging.h>
 #include <nf/RaiiToken.h>
+#include <nf/backend/MemoryLogger.h>
 #include <nf/testing/Test.h>
 #include <nf/testing/TestExecutor.h>
 #include <nf/testing/TestTracers.h>
 
+#include <algorithm>
 #include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace nf;
 using namespace nf::testing;
@@ -84,6 +90,104 @@ TEST_F(ContextTest, post_contextDestroyed)
     EXPECT_FALSE(isInvoked);
 }
 
+TEST_F(ContextTest, postBatch_runsInOrder)
+{
+    std::vector<int> order;
+    std::vector<Context::Task> tasks;
+    for (int i = 0; i < 3; ++i) {
+        tasks.emplace_back([&, i] { order.push_back(i); });
+    }
+
+    Context ctx;
+    ctx.post([&] { order.push_back(-1); });
+    ctx.postBatch(std::move(tasks));
+    ctx.post([&] { order.push_back(3); });
+
+    EXPECT_FALSE(ctx.isEmpty());
+    processEvents();
+    EXPECT_EQ((std::vector{-1, 0, 1, 2, 3}), order);
+    EXPECT_TRUE(ctx.isEmpty());
+}
+
+/* Tasks posted to Context in a batch shall NOT be executed if Context is reset. */
+TEST_F(ContextTest, postBatch_contextReset)
+{
+    bool isInvoked{false};
+
+    bool isTokenDestroyed{false};
+    auto token = RaiiToken::nonDismissible([&] { isTokenDestroyed = true; });
+
+    std::vector<Context::Task> tasks;
+    tasks.emplace_back([&] { isInvoked = true; });
+    tasks.emplace_back([&, token = std::move(token)] { isInvoked = true; });
+
+    Context ctx;
+    ctx.postBatch(std::move(tasks));
+    ctx.reset();
+    EXPECT_TRUE(isTokenDestroyed);
+
+    processEvents();
+    EXPECT_FALSE(isInvoked);
+}
+
+/* A slow task posted through a context is reported with the location of the post. */
+TEST_F(ContextTest, statistics_slowTaskNamesPostSite)
+{
+    auto log = std::make_shared<backend::MemoryLogger>();
+    Logging::initialize({log});
+    Executor::thisThread()->enableStatistics(1ms);
+
+    Context ctx;
+    const auto line = __LINE__ + 1;
+    ctx.post([] { std::this_thread::sleep_for(3ms); });
+    processEvents();
+    Logging::terminate();
+
+    const auto site = std::string(__FILE__) + ":" + std::to_string(line);
+    const auto entries = log->logEntries();
+    EXPECT_TRUE(std::any_of(entries.begin(), entries.end(), [&](const auto &entry) {
+        return entry.message.find("posted at " + site) != std::string::npos;
+    }));
+}
+
+/* Measures posting through a context, and posting followed by a reset. Without resets the
+ * context recycles the nodes of its lists after the first round. A reset replaces the state
+ * together with its pools, so every round after a reset allocates the nodes again. */
+TEST_F(ContextTest, DISABLED_postAndReset_benchmark)
+{
+    constexpr int kRounds = 100;
+    constexpr int kTasks = 1000;
+
+    Context ctx;
+    int cntInvoked = 0;
+    const auto measure = [&](bool doReset) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < kRounds; ++round) {
+            for (int i = 0; i < kTasks; ++i) {
+                ctx.post([&] { ++cntInvoked; });
+            }
+            if (doReset) {
+                ctx.reset();
+            }
+            processEvents();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+            / (kRounds * kTasks);
+    };
+
+    const auto postNs = measure(false);
+    EXPECT_EQ(kRounds * kTasks, cntInvoked);
+    EXPECT_TRUE(ctx.isEmpty());
+
+    const auto resetNs = measure(true);
+    EXPECT_EQ(kRounds * kTasks, cntInvoked);
+    EXPECT_TRUE(ctx.isEmpty());
+
+    nf::info("Context: {}ns per posted and run task, {}ns per posted and reset task", postNs,
+             resetNs);
+}
+
 TEST_F(ContextTest, bindLambda_ok)
 {
     auto ctx = std::make_shared<Context>();
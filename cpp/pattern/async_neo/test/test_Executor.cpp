@@ -0,0 +1,627 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include <nf/Executor.h>
+#include <nf/Framework.h>
+#include <nf/IoWatch.h>
+#include <nf/Logging.h>
+#include <nf/Timer.h>
+#include <nf/testing/Test.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace nf;
+using namespace nf::testing;
+using namespace std::chrono_literals;
+
+/*
+ * These tests run against every executor backend. The throughput and latency tests do not
+ * assert on the numbers, they log them to compare the backends on the target.
+ */
+template <typename tFramework>
+class ExecutorTest : public Test
+{
+public:
+    ExecutorTest() noexcept
+        : Test(NoFramework{})
+    {
+        Framework::initialize(std::make_unique<tFramework>());
+    }
+};
+
+using Backends = ::testing::Types<AsioFramework, EpollFramework>;
+TYPED_TEST_SUITE(ExecutorTest, Backends, );
+
+TYPED_TEST(ExecutorTest, postedTasks_runInOrder)
+{
+    const auto &executor = Executor::thisThread();
+    std::vector<int> order;
+
+    executor->post([&] { order.push_back(1); });
+    executor->post([&] {
+        order.push_back(2);
+        executor->post([&] {
+            order.push_back(4);
+            executor->stop();
+        });
+    });
+    executor->post([&] { order.push_back(3); });
+
+    EXPECT_EQ(EXIT_SUCCESS, executor->run());
+    EXPECT_EQ((std::vector{1, 2, 3, 4}), order);
+}
+
+TYPED_TEST(ExecutorTest, postBatch_runsInOrder)
+{
+    const auto &executor = Executor::thisThread();
+    std::vector<int> order;
+
+    std::vector<Executor::Task> tasks;
+    for (int i = 1; i <= 3; ++i) {
+        tasks.emplace_back([&, i] { order.push_back(i); });
+    }
+
+    executor->post([&] { order.push_back(0); });
+    executor->postBatch(std::move(tasks));
+    executor->postBatch({});
+    executor->post([&] {
+        order.push_back(4);
+        executor->stop();
+    });
+
+    executor->run();
+    EXPECT_EQ((std::vector{0, 1, 2, 3, 4}), order);
+}
+
+TYPED_TEST(ExecutorTest, postBatch_stopInBatch)
+{
+    const auto &executor = Executor::thisThread();
+    std::vector<int> order;
+
+    std::vector<Executor::Task> tasks;
+    tasks.emplace_back([&] {
+        order.push_back(1);
+        executor->stop();
+    });
+    tasks.emplace_back([&] {
+        order.push_back(2);
+        executor->stop();
+    });
+    executor->postBatch(std::move(tasks));
+    executor->post([&] {
+        order.push_back(3);
+        executor->stop();
+    });
+
+    /* The rest of the batch still runs before the task posted after it. */
+    executor->run();
+    EXPECT_EQ((std::vector{1}), order);
+    executor->run();
+    EXPECT_EQ((std::vector{1, 2}), order);
+    executor->run();
+    EXPECT_EQ((std::vector{1, 2, 3}), order);
+}
+
+/* Every round of the lanes runs up to 16 high, 4 normal and 1 background task. */
+TYPED_TEST(ExecutorTest, priority_weightedLanes)
+{
+    constexpr int kTasks = 40;
+
+    const auto &executor = Executor::thisThread();
+    std::vector<Executor::Priority> order;
+
+    for (auto priority :
+         {Executor::Priority::Background, Executor::Priority::Normal, Executor::Priority::High}) {
+        for (int i = 0; i < kTasks; ++i) {
+            executor->post(priority, [&, priority] { order.push_back(priority); });
+        }
+        EXPECT_EQ(kTasks, executor->queueDepth(priority));
+    }
+    executor->post(Executor::Priority::Background, [&] { executor->stop(); });
+    executor->run();
+
+    ASSERT_EQ(3 * kTasks, order.size());
+    const auto count = [&](Executor::Priority priority, int n) {
+        return std::count(order.begin(), order.begin() + n, priority);
+    };
+    EXPECT_EQ(16, count(Executor::Priority::High, 16));
+    EXPECT_EQ(4, count(Executor::Priority::Normal, 20));
+    EXPECT_EQ(1, count(Executor::Priority::Background, 21));
+    EXPECT_EQ(0, executor->queueDepth(Executor::Priority::High));
+    EXPECT_EQ(0, executor->queueDepth(Executor::Priority::Background));
+}
+
+TYPED_TEST(ExecutorTest, priority_backgroundNotStarved)
+{
+    const auto &executor = Executor::thisThread();
+    bool isBackgroundRun = false;
+    int cntHigh = 0;
+
+    /* The high lane is never empty. */
+    std::function<void()> repost = [&] {
+        ++cntHigh;
+        if (!isBackgroundRun) {
+            executor->post(Executor::Priority::High, [&] { repost(); });
+        }
+    };
+    executor->post(Executor::Priority::High, [&] { repost(); });
+    executor->post(Executor::Priority::High, [&] { repost(); });
+    executor->post(Executor::Priority::Background, [&] {
+        isBackgroundRun = true;
+        executor->stop();
+    });
+
+    executor->run();
+    EXPECT_TRUE(isBackgroundRun);
+    EXPECT_LE(cntHigh, 32);
+}
+
+TYPED_TEST(ExecutorTest, stop_returnsExitCode)
+{
+    const auto &executor = Executor::thisThread();
+    executor->post([&] { executor->stop(42); });
+    EXPECT_EQ(42, executor->run());
+}
+
+TYPED_TEST(ExecutorTest, stop_fromAnotherThread)
+{
+    const auto &executor = Executor::thisThread();
+    std::thread thread([&] {
+        std::this_thread::sleep_for(10ms);
+        executor->stop(7);
+    });
+
+    EXPECT_EQ(7, executor->run());
+    thread.join();
+}
+
+TYPED_TEST(ExecutorTest, crossThreadPost_throughput)
+{
+    constexpr int kProducers = 4;
+    constexpr int kTasksPerProducer = 50000;
+
+    const auto &executor = Executor::thisThread();
+    std::array<int, kProducers> lastValues{};
+    int cntExecuted = 0;
+    bool isOrdered = true;
+
+    std::vector<std::thread> producers;
+    const auto start = std::chrono::steady_clock::now();
+    for (int producer = 0; producer < kProducers; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 1; i <= kTasksPerProducer; ++i) {
+                executor->post([&, producer, i] {
+                    isOrdered = isOrdered && lastValues[producer] + 1 == i;
+                    lastValues[producer] = i;
+                    if (++cntExecuted == kProducers * kTasksPerProducer) {
+                        executor->stop();
+                    }
+                });
+            }
+        });
+    }
+
+    executor->run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(kProducers * kTasksPerProducer, cntExecuted);
+    EXPECT_TRUE(isOrdered);
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    nf::info("{}: {} tasks from {} threads in {}us ({} tasks/ms)",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(), cntExecuted,
+             kProducers, us, us > 0 ? cntExecuted * 1000LL / us : 0);
+}
+
+TYPED_TEST(ExecutorTest, crossThreadPost_wakeupLatency)
+{
+    constexpr int kRounds = 200;
+
+    const auto &executor = Executor::thisThread();
+    std::vector<std::chrono::steady_clock::duration> latencies;
+    latencies.reserve(kRounds);
+
+    std::thread producer([&] {
+        for (int i = 0; i < kRounds; ++i) {
+            /* Give the event loop time to go idle. */
+            std::this_thread::sleep_for(200us);
+            executor->post([&, posted = std::chrono::steady_clock::now()] {
+                latencies.push_back(std::chrono::steady_clock::now() - posted);
+            });
+        }
+        executor->post([&] { executor->stop(); });
+    });
+
+    executor->run();
+    producer.join();
+
+    ASSERT_EQ(static_cast<std::size_t>(kRounds), latencies.size());
+    std::sort(latencies.begin(), latencies.end());
+    nf::info("{}: wake-up latency median {}us, p99 {}us",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(),
+             std::chrono::duration_cast<std::chrono::microseconds>(latencies[kRounds / 2]).count(),
+             std::chrono::duration_cast<std::chrono::microseconds>(latencies[kRounds * 99 / 100])
+                 .count());
+}
+
+TYPED_TEST(ExecutorTest, statistics_disabledByDefault)
+{
+    EXPECT_FALSE(Executor::thisThread()->statistics());
+}
+
+TYPED_TEST(ExecutorTest, statistics_countTasks)
+{
+    const auto &executor = Executor::thisThread();
+    executor->enableStatistics();
+
+    executor->post([] {});
+    executor->post([] { std::this_thread::sleep_for(2ms); });
+    std::vector<Executor::Task> tasks;
+    tasks.emplace_back([] {});
+    tasks.emplace_back([&] { executor->stop(); });
+    executor->postBatch(std::move(tasks));
+    EXPECT_EQ(4, executor->statistics()->queued);
+    EXPECT_EQ(4, executor->statistics()->queuedPerPriority[1]);
+
+    executor->run();
+
+    const auto statistics = executor->statistics().value();
+    EXPECT_EQ(0, statistics.queued);
+    EXPECT_EQ(0, statistics.slowTasks);
+    EXPECT_EQ(4, statistics.queueWait.count);
+    EXPECT_EQ(4, statistics.runTime.count);
+    EXPECT_GE(statistics.runTime.max, 2ms);
+    EXPECT_LE(statistics.runTime.p50, statistics.runTime.p99);
+    EXPECT_LE(statistics.runTime.p99, statistics.runTime.max);
+    EXPECT_GE(statistics.queueWait.max, 2ms);
+}
+
+TYPED_TEST(ExecutorTest, statistics_slowTask)
+{
+    const auto &executor = Executor::thisThread();
+    executor->enableStatistics(1ms);
+
+    executor->post([] { std::this_thread::sleep_for(3ms); });
+    executor->post([] {});
+    executor->post([&] { executor->stop(); });
+    executor->run();
+
+    EXPECT_EQ(1, executor->statistics()->slowTasks);
+}
+
+/* Compares the cost of posting and running a task with and without statistics. */
+TYPED_TEST(ExecutorTest, DISABLED_statistics_benchmark)
+{
+    constexpr int kTasks = 100000;
+
+    const auto measure = [](const std::shared_ptr<Executor> &executor) {
+        int cntExecuted = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kTasks; ++i) {
+            executor->post([&] {
+                if (++cntExecuted == kTasks) {
+                    executor->stop();
+                }
+            });
+        }
+        executor->run();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count()
+               / kTasks;
+    };
+
+    const auto &executor = Executor::thisThread();
+    const auto disabled = measure(executor);
+    executor->enableStatistics();
+    const auto enabled = measure(executor);
+
+    nf::info("{}: {}ns per task without statistics, {}ns with statistics",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(), disabled,
+             enabled);
+    nf::info("{}", executor->statistics().value());
+}
+
+TYPED_TEST(ExecutorTest, delayedPost_waitsForDelay)
+{
+    const auto &executor = Executor::thisThread();
+    std::vector<int> order;
+
+    const auto start = executor->now();
+    executor->post(30ms, [&] {
+        order.push_back(2);
+        executor->stop();
+    });
+    executor->post(10ms, [&] { order.push_back(1); });
+
+    executor->run();
+    EXPECT_GE(executor->now() - start, 30ms);
+    EXPECT_EQ((std::vector{1, 2}), order);
+}
+
+TYPED_TEST(ExecutorTest, timer_periodic)
+{
+    const auto &executor = Executor::thisThread();
+    int cntInvoked = 0;
+
+    auto timer = executor->makeTimer(5ms, [&] {
+        if (++cntInvoked == 3) {
+            executor->stop();
+            return false;
+        }
+        return true;
+    });
+    timer->start();
+    EXPECT_TRUE(timer->isRunning());
+    EXPECT_LE(timer->remainingTime(), 5ms);
+
+    executor->run();
+    EXPECT_EQ(3, cntInvoked);
+    EXPECT_FALSE(timer->isRunning());
+}
+
+TYPED_TEST(ExecutorTest, timer_stopped)
+{
+    const auto &executor = Executor::thisThread();
+    bool isInvoked = false;
+
+    auto timer = executor->makeTimer(5ms, [&] { return isInvoked = true; });
+    timer->start();
+    timer->stop();
+    EXPECT_EQ(0ms, timer->remainingTime());
+
+    executor->post(20ms, [&] { executor->stop(); });
+    executor->run();
+    EXPECT_FALSE(isInvoked);
+}
+
+TYPED_TEST(ExecutorTest, timer_restartedInTask)
+{
+    const auto &executor = Executor::thisThread();
+    std::unique_ptr<Timer> timer;
+    int cntInvoked = 0;
+
+    timer = executor->makeTimer(2ms, [&] {
+        if (++cntInvoked == 1) {
+            /* This wins over the return value. */
+            timer->start();
+            return false;
+        }
+        executor->stop();
+        return false;
+    });
+    timer->start();
+
+    executor->run();
+    EXPECT_EQ(2, cntInvoked);
+    EXPECT_FALSE(timer->isRunning());
+}
+
+TYPED_TEST(ExecutorTest, timer_backgroundPriority)
+{
+    const auto &executor = Executor::thisThread();
+    int cntTriggered = 0;
+
+    auto timer = executor->makeTimer(1ms, [&] {
+        if (++cntTriggered == 3) {
+            executor->stop();
+        }
+        return true;
+    });
+    timer->setPriority(Executor::Priority::Background);
+    timer->start();
+
+    executor->run();
+    EXPECT_EQ(3, cntTriggered);
+    EXPECT_TRUE(timer->isRunning());
+}
+
+TYPED_TEST(ExecutorTest, timer_stoppedWhileInLane)
+{
+    const auto &executor = Executor::thisThread();
+    bool isTriggered = false;
+
+    auto timer = executor->makeTimer(1ms, [&] {
+        isTriggered = true;
+        return false;
+    });
+    timer->setPriority(Executor::Priority::Background);
+    auto stopper = executor->makeTimer(1ms, [&] {
+        timer->stop();
+        return false;
+    });
+    timer->start();
+    stopper->start();
+
+    /* Both timers expire at once, the stopper runs ahead of the lanes. */
+    executor->post([] { std::this_thread::sleep_for(5ms); });
+    executor->post(10ms, [&] { executor->stop(); });
+
+    executor->run();
+    EXPECT_FALSE(isTriggered);
+    EXPECT_FALSE(timer->isRunning());
+}
+
+TYPED_TEST(ExecutorTest, timer_longInterval)
+{
+    const auto &executor = Executor::thisThread();
+    bool isInvoked = false;
+
+    /* This is beyond the top level of the timer wheel. */
+    auto timer = executor->makeTimer(10h, [&] { return isInvoked = true; });
+    timer->start();
+    EXPECT_GT(timer->remainingTime(), 9h);
+
+    executor->post(5ms, [&] { executor->stop(); });
+    executor->run();
+    EXPECT_FALSE(isInvoked);
+    EXPECT_TRUE(timer->isRunning());
+}
+
+TYPED_TEST(ExecutorTest, DISABLED_manyTimers_benchmark)
+{
+    constexpr int kTimers = 100000;
+    constexpr int kMaxIntervalMs = 100;
+
+    const auto &executor = Executor::thisThread();
+    std::vector<std::unique_ptr<Timer>> timers;
+    timers.reserve(kTimers);
+    int cntInvoked = 0;
+
+    for (int i = 0; i < kTimers; ++i) {
+        timers.push_back(executor->makeTimer(std::chrono::milliseconds(1 + i % kMaxIntervalMs),
+                                             [&] {
+                                                 if (++cntInvoked == kTimers / 2) {
+                                                     executor->stop();
+                                                 }
+                                                 return false;
+                                             }));
+    }
+
+    /* Every other timer is cancelled, which is the common fate of a request deadline. */
+    const auto startedAt = std::chrono::steady_clock::now();
+    for (auto &timer : timers) {
+        timer->start();
+    }
+    const auto cancelledAt = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < timers.size(); i += 2) {
+        timers[i]->stop();
+    }
+    const auto finishedAt = std::chrono::steady_clock::now();
+
+    executor->run();
+    const auto firedAt = std::chrono::steady_clock::now();
+    EXPECT_EQ(kTimers / 2, cntInvoked);
+
+    const auto us = [](auto duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    };
+    nf::info("{}: {} timers started in {}us, {} stopped in {}us, the rest fired after {}us",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(), kTimers,
+             us(cancelledAt - startedAt), kTimers / 2, us(finishedAt - cancelledAt),
+             us(firedAt - finishedAt));
+}
+
+TYPED_TEST(ExecutorTest, DISABLED_manyDelayedPosts_benchmark)
+{
+    constexpr int kTasks = 100000;
+    constexpr int kMaxDelayMs = 100;
+
+    const auto &executor = Executor::thisThread();
+    int cntExecuted = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (int i = 0; i < kTasks; ++i) {
+            executor->post(std::chrono::milliseconds(1 + i % kMaxDelayMs), [&] {
+                if (++cntExecuted == kTasks) {
+                    executor->stop();
+                }
+            });
+        }
+    });
+
+    executor->run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+    EXPECT_EQ(kTasks, cntExecuted);
+
+    nf::info("{}: {} delayed tasks executed in {}us",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(), kTasks,
+             std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+TYPED_TEST(ExecutorTest, ioWatch_readable)
+{
+    const auto &executor = Executor::thisThread();
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, ::pipe(fds.data()));
+
+    std::vector<char> received;
+    auto watch = executor->makeIoWatch(fds[0], POLLIN, [&](std::int16_t events) {
+        EXPECT_NE(0, events & POLLIN);
+        char c = 0;
+        EXPECT_EQ(1, ::read(fds[0], &c, 1));
+        received.push_back(c);
+        if (received.size() == 2) {
+            executor->stop();
+        }
+        return true;
+    });
+    watch->start();
+
+    std::thread writer([&] {
+        EXPECT_EQ(1, ::write(fds[1], "a", 1));
+        std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(1, ::write(fds[1], "b", 1));
+    });
+
+    executor->run();
+    writer.join();
+    watch.reset();
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    EXPECT_EQ((std::vector{'a', 'b'}), received);
+}
+
+TYPED_TEST(ExecutorTest, ioWatch_backgroundPriority)
+{
+    const auto &executor = Executor::thisThread();
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, ::pipe(fds.data()));
+    ASSERT_EQ(1, ::write(fds[1], "a", 1));
+
+    std::vector<char> received;
+    auto watch = executor->makeIoWatch(fds[0], POLLIN, [&](std::int16_t /*events*/) {
+        char c = 0;
+        EXPECT_EQ(1, ::read(fds[0], &c, 1));
+        received.push_back(c);
+        executor->stop();
+        return false;
+    });
+    watch->setPriority(Executor::Priority::Background);
+    watch->start();
+
+    executor->run();
+    EXPECT_FALSE(watch->isActive());
+    watch.reset();
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    EXPECT_EQ((std::vector{'a'}), received);
+}
+
+TYPED_TEST(ExecutorTest, signalHandler_invoked)
+{
+    const auto &executor = Executor::thisThread();
+    std::vector<LinuxSignal> received;
+
+    ASSERT_TRUE(executor->setSignalHandlers({{LinuxSignal::SigUsr1, [&](const LinuxSignal &signal) {
+                                                 received.push_back(signal);
+                                                 executor->stop();
+                                             }}}));
+    executor->post([] { std::raise(SIGUSR1); });
+
+    executor->run();
+    EXPECT_EQ((std::vector{LinuxSignal::SigUsr1}), received);
+    EXPECT_TRUE(executor->setSignalHandlers({}));
+}
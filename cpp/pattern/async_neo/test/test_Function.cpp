@@ -8,10 +8,19 @@
  *     Antons Jeļkins <antons.jelkins@bmw.de>
  */
 
+#include "AllocationCounter.h"
+
+#include <nf/Executor.h>
 #include <nf/Function.h>
+#include <nf/Logging.h>
 #include <nf/testing/Test.h>
 #include <nf/testing/TestTracers.h>
 
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+
 using namespace nf;
 using namespace nf::testing;
 
@@ -118,7 +127,8 @@ TEST_F(FunctionTest, nonCopyableLambda)
 
     movedF(10);
     EXPECT_EQ(0, sb->cntCopied);
-    EXPECT_GE(2, sb->cntMoved);
+    // The lambda is small enough to be stored inline, so it moves along with the function
+    EXPECT_GE(3, sb->cntMoved);
     EXPECT_EQ(210, receivedValue);
 }
 
@@ -223,3 +233,187 @@ TEST_F(FunctionTest, throwFromFunction)
 
     EXPECT_EQ(5, thrownI);
 }
+
+namespace {
+
+/* Records the address of the target when it is invoked. This is used to check if the target
+ * is stored inside the function object or on the heap. */
+template <std::size_t Padding>
+struct AddressProbe
+{
+    const void **address;
+    std::array<char, Padding> padding{};
+
+    void operator()() const
+    {
+        *address = this;
+    }
+};
+
+struct ThrowingMoveProbe
+{
+    const void **address;
+
+    explicit ThrowingMoveProbe(const void **address)
+        : address(address)
+    {
+    }
+
+    ThrowingMoveProbe(const ThrowingMoveProbe &) = default;
+    ThrowingMoveProbe(ThrowingMoveProbe &&other) noexcept(false)
+        : address(other.address)
+    {
+    }
+
+    void operator()() const
+    {
+        *address = this;
+    }
+};
+
+struct DestructionCounter
+{
+    std::shared_ptr<int> counter;
+
+    explicit DestructionCounter(std::shared_ptr<int> counter)
+        : counter(std::move(counter))
+    {
+    }
+
+    DestructionCounter(DestructionCounter &&) noexcept = default;
+
+    ~DestructionCounter()
+    {
+        if (counter) {
+            ++*counter;
+        }
+    }
+
+    void operator()() const
+    {
+    }
+};
+
+template <typename tFunction>
+bool isStoredInside(const tFunction &f, const void *address)
+{
+    const auto *begin = reinterpret_cast<const char *>(&f);
+    const auto *target = static_cast<const char *>(address);
+    return std::less_equal<>()(begin, target) && std::less<>()(target, begin + sizeof(f));
+}
+
+} // anonymous namespace
+
+TEST_F(FunctionTest, smallTarget_storedInline)
+{
+    const void *address = nullptr;
+    Function<void()> f = AddressProbe<1>{&address};
+
+    f();
+    EXPECT_TRUE(isStoredInside(f, address));
+
+    auto movedF = std::move(f);
+    movedF();
+    EXPECT_TRUE(isStoredInside(movedF, address));
+}
+
+TEST_F(FunctionTest, bigTarget_storedOnHeap)
+{
+    const void *address = nullptr;
+    Function<void()> f = AddressProbe<sizeof(Function<void()>)>{&address};
+
+    f();
+    EXPECT_FALSE(isStoredInside(f, address));
+
+    const void *previousAddress = address;
+    auto movedF = std::move(f);
+    movedF();
+    EXPECT_EQ(previousAddress, address);
+}
+
+TEST_F(FunctionTest, throwingMoveTarget_storedOnHeap)
+{
+    const void *address = nullptr;
+    Function<void()> f = ThrowingMoveProbe{&address};
+
+    f();
+    EXPECT_FALSE(isStoredInside(f, address));
+}
+
+TEST_F(FunctionTest, inlineTarget_destroyedOnce)
+{
+    auto counter = std::make_shared<int>(0);
+
+    {
+        Function<void() noexcept> f = DestructionCounter{counter};
+        auto movedF = std::move(f);
+        Function<void() noexcept> assignedF;
+        assignedF = std::move(movedF);
+        assignedF();
+        EXPECT_EQ(0, *counter);
+    }
+
+    EXPECT_EQ(1, *counter);
+}
+
+TEST_F(FunctionTest, assignment_replacesInlineTarget)
+{
+    auto counter = std::make_shared<int>(0);
+
+    Function<void()> f = DestructionCounter{counter};
+    f = [] {};
+
+    EXPECT_EQ(1, *counter);
+    EXPECT_TRUE(f);
+}
+
+namespace {
+
+struct PostResult
+{
+    double allocationsPerPost;
+    long long postsPerSecond;
+};
+
+/* Posts tasks capturing a counter and the given padding to the executor of this thread and runs
+ * them. */
+template <std::size_t Padding>
+PostResult postTasks(int count)
+{
+    const auto &executor = Executor::thisThread();
+    int invoked = 0;
+    std::array<char, Padding> padding{};
+
+    const AllocationCounter allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        executor->post([&invoked, padding] { invoked += 1 + padding[0]; });
+    }
+    processEvents();
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    EXPECT_EQ(count, invoked);
+
+    return {static_cast<double>(allocations.count()) / count,
+            count * 1000000LL / (us > 0 ? us : 1)};
+}
+
+} // anonymous namespace
+
+/* A posted task with a small capture is stored inline, so posting it allocates less than posting
+ * one that does not fit, which is how every task was posted before. The rates are logged to
+ * compare the two. */
+TEST_F(FunctionTest, postedTask_benchmark)
+{
+    constexpr int kPosts = 100000;
+
+    const auto inlineResult = postTasks<8>(kPosts);
+    const auto heapResult = postTasks<sizeof(Function<void()>)>(kPosts);
+
+    EXPECT_LT(inlineResult.allocationsPerPost, heapResult.allocationsPerPost);
+    nf::info("{} posts: inline target {} allocations/post, {} posts/s; heap target {} "
+             "allocations/post, {} posts/s",
+             kPosts, inlineResult.allocationsPerPost, inlineResult.postsPerSecond,
+             heapResult.allocationsPerPost, heapResult.postsPerSecond);
+}
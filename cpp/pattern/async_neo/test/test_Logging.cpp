@@ -12,8 +12,14 @@
 
 #include <nf/Logging.h>
 #include <nf/backend/MemoryLogger.h>
+#include <nf/backend/StdoutLogger.h>
 #include <nf/testing/Test.h>
 
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+
 using ::testing::_; // NOLINT
 using ::testing::ContainsRegex;
 using ::testing::InSequence;
@@ -496,3 +502,208 @@ TEST_F(FallbackLogTest, logBackends)
     EXPECT_TRUE(std::dynamic_pointer_cast<MockLogBackend>(list[0]));
     EXPECT_TRUE(std::dynamic_pointer_cast<nf::backend::MemoryLogger>(list[1]));
 }
+
+TEST_F(FallbackLogTest, isEnabled_followsFilters)
+{
+    const auto &context1 = NF_LOG_GET_CONTEXT(nf_log_test1);
+    const auto &context2 = NF_LOG_GET_CONTEXT(nf_log_test2);
+    EXPECT_TRUE(nf::Logging::isEnabled(context1, nf::LogLevel::Verbose));
+
+    using rule = nf::LogFilterRule;
+    nf::Logging::initialize({std::make_shared<nf::backend::MemoryLogger>()},
+                            {rule::suppressContext(context2.id, nf::LogLevel::Info),
+                             rule::suppressLevelsUpTo(nf::LogLevel::Verbose),
+                             rule::suppressFile("test_Logging.cpp")});
+
+    EXPECT_TRUE(nf::Logging::isEnabled(context1, nf::LogLevel::Debug));
+    EXPECT_FALSE(nf::Logging::isEnabled(context1, nf::LogLevel::Verbose));
+    EXPECT_TRUE(nf::Logging::isEnabled(context2, nf::LogLevel::Warn));
+    EXPECT_FALSE(nf::Logging::isEnabled(context2, nf::LogLevel::Info));
+
+    nf::Logging::terminate();
+    EXPECT_TRUE(nf::Logging::isEnabled(context2, nf::LogLevel::Verbose));
+}
+
+TEST_F(LogTest, lazy_logged)
+{
+    const auto &context = NF_LOG_GET_CONTEXT(nf_log_test1);
+    nf::log(context, nf::LogLevel::Warn, [] { return "Hello, 1"; });
+    info([] { return fmt::format("Hello, {}", 2); });
+    nf::debug(NF_LOG_GET_CONTEXT(nf_log_test2), [] { return 3; });
+
+    std::vector<nf::LogEntry> expected = {
+        {context, nf::LogLevel::Warn, "Hello, 1", {}},
+        {context, nf::LogLevel::Info, "Hello, 2", {}},
+        {NF_LOG_GET_CONTEXT(nf_log_test2), nf::LogLevel::Debug, "3", {}}};
+    EXPECT_EQ(expected, m_log->logEntries());
+}
+
+TEST_F(FallbackLogTest, lazy_notEvaluatedIfSuppressed)
+{
+    auto log = std::make_shared<nf::backend::MemoryLogger>();
+    nf::Logging::initialize({log}, {nf::LogFilterRule::suppressLevelsUpTo(nf::LogLevel::Debug)});
+
+    int evaluated = 0;
+    const auto message = [&evaluated] {
+        ++evaluated;
+        return "message";
+    };
+    debug(message);
+    verbose(message);
+    info(message);
+
+    EXPECT_EQ(1, evaluated);
+    ASSERT_EQ(1, log->logEntries().size());
+    EXPECT_EQ(nf::LogLevel::Info, log->logEntries().front().logLevel);
+}
+
+TEST_F(FallbackLogTest, DISABLED_suppressed_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kCalls = 1000000;
+
+    nf::Logging::initialize({std::make_shared<nf::backend::StdoutLogger>()},
+                            {nf::LogFilterRule::suppressLevelsUpTo(nf::LogLevel::Debug)});
+
+    const auto nsPerCall = [](Clock::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / kCalls;
+    };
+
+    const auto start = Clock::now();
+    for (int i = 0; i < kCalls; ++i) {
+        debug("Value {}", i);
+    }
+    const auto eagerDone = Clock::now();
+    for (int i = 0; i < kCalls; ++i) {
+        debug([i] { return fmt::format("Value {}", i); });
+    }
+    const auto lazyDone = Clock::now();
+
+    nf::info("Suppressed debug message: {:.1f}ns per call, {:.1f}ns per lazy call",
+             nsPerCall(eagerDone - start), nsPerCall(lazyDone - eagerDone));
+}
+
+namespace {
+
+std::vector<std::string> messages(const nf::backend::MemoryLogger &log)
+{
+    std::vector<std::string> messages;
+    for (const auto &logEntry : log.logEntries()) {
+        messages.push_back(logEntry.message);
+    }
+    return messages;
+}
+
+} // anonymous namespace
+
+TEST(MemoryLoggerTest, ring_keepsLatest)
+{
+    nf::backend::MemoryLogger log(1024);
+    constexpr int kEntries = 100;
+    for (int i = 0; i < kEntries; ++i) {
+        log.write({ActiveLogContext, nf::LogLevel::Info, fmt::format("Message {}", i), {}});
+    }
+
+    const auto kept = messages(log);
+    ASSERT_FALSE(kept.empty());
+    EXPECT_EQ(kEntries, kept.size() + log.overwrittenCount());
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+        EXPECT_EQ(fmt::format("Message {}", kEntries - kept.size() + i), kept[i]);
+    }
+
+    const auto logEntries = log.logEntries();
+    EXPECT_EQ(&ActiveLogContext, &logEntries.back().logContext);
+    EXPECT_EQ(nf::LogLevel::Info, logEntries.back().logLevel);
+}
+
+TEST(MemoryLoggerTest, ring_keepsTimeStamp)
+{
+    nf::backend::MemoryLogger log(1024);
+    nf::LogEntry logEntry(ActiveLogContext, nf::LogLevel::Warn, "Message", {});
+    logEntry.timePoint -= std::chrono::hours(1);
+    log.write(logEntry);
+
+    const auto logEntries = log.logEntries();
+    ASSERT_EQ(1, logEntries.size());
+    EXPECT_EQ(logEntry.timePoint, logEntries[0].timePoint);
+    EXPECT_EQ(nf::LogLevel::Warn, logEntries[0].logLevel);
+}
+
+TEST(MemoryLoggerTest, ring_truncatesLongMessage)
+{
+    nf::backend::MemoryLogger log(512);
+    log.write({ActiveLogContext, nf::LogLevel::Info, "Short", {}});
+    log.write({ActiveLogContext, nf::LogLevel::Info, std::string(1000, 'x'), {}});
+
+    const auto kept = messages(log);
+    ASSERT_EQ(1, kept.size());
+    EXPECT_LT(kept[0].size(), 512);
+    EXPECT_EQ(std::string(kept[0].size(), 'x'), kept[0]);
+    EXPECT_EQ(1, log.overwrittenCount());
+}
+
+TEST(MemoryLoggerTest, ring_clear)
+{
+    nf::backend::MemoryLogger log(256);
+    for (int i = 0; i < 100; ++i) {
+        log.write({ActiveLogContext, nf::LogLevel::Info, "Message", {}});
+    }
+    ASSERT_GT(log.overwrittenCount(), 0);
+
+    log.clear();
+    EXPECT_TRUE(log.logEntries().empty());
+    EXPECT_EQ(0, log.overwrittenCount());
+
+    log.write({ActiveLogContext, nf::LogLevel::Info, "After", {}});
+    EXPECT_EQ(std::vector<std::string>{"After"}, messages(log));
+}
+
+TEST(MemoryLoggerTest, dump)
+{
+    nf::backend::MemoryLogger log(256);
+    for (int i = 0; i < 20; ++i) {
+        log.write({ActiveLogContext, nf::LogLevel::Error, fmt::format("Message {}", i), {}});
+    }
+
+    std::array<int, 2> fds{};
+    ASSERT_EQ(0, ::pipe(fds.data()));
+    log.dump(fds[1]);
+    ::close(fds[1]);
+
+    std::string output;
+    std::array<char, 256> buffer{};
+    for (ssize_t size; (size = ::read(fds[0], buffer.data(), buffer.size())) > 0;) {
+        output.append(buffer.data(), static_cast<std::size_t>(size));
+    }
+    ::close(fds[0]);
+
+    EXPECT_THAT(output, ContainsRegex(fmt::format("^{} earlier messages were overwritten\n",
+                                                  log.overwrittenCount())));
+    EXPECT_THAT(output, ContainsRegex(R"(\| CTX1 \|   Error \| Message 19
+$)"));
+}
+
+TEST(MemoryLoggerTest, DISABLED_ring_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kEntries = 200000;
+
+    const auto nsPerEntry = [](nf::backend::MemoryLogger &log) {
+        const nf::LogEntry logEntry(ActiveLogContext, nf::LogLevel::Info,
+                                    "A message of a typical length logged during startup", {});
+        const auto start = Clock::now();
+        for (int i = 0; i < kEntries; ++i) {
+            log.write(logEntry);
+        }
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kEntries;
+    };
+
+    nf::backend::MemoryLogger unbounded;
+    nf::backend::MemoryLogger ring(64 * 1024);
+    const auto unboundedNs = nsPerEntry(unbounded);
+    const auto ringNs = nsPerEntry(ring);
+
+    nf::info("Memory log entry: {:.1f}ns unbounded, {:.1f}ns in a 64KiB ring ({} kept, {} "
+             "overwritten)",
+             unboundedNs, ringNs, ring.logEntries().size(), ring.overwrittenCount());
+}
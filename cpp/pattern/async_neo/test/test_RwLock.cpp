@@ -9,11 +9,17 @@
  */
 
 #include <nf/Framework.h>
+#include <nf/Logging.h>
 #include <nf/RwLock.h>
 #include <nf/Thread.h>
 #include <nf/testing/Test.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace nf;
 using namespace nf::testing;
@@ -168,3 +174,164 @@ TEST_F(RwLockThreadTest, callbackInvokedInThread)
     EXPECT_TRUE(isInvoked);
     EXPECT_NE(std::this_thread::get_id(), threadId);
 }
+
+TEST_F(RwLockTest, tryLockRead)
+{
+    RwLock lock;
+
+    auto read1 = lock.tryLockRead();
+    auto read2 = lock.tryLockRead();
+    EXPECT_TRUE(read1);
+    EXPECT_TRUE(read2);
+    EXPECT_FALSE(lock.tryLockWrite());
+
+    read1.reset();
+    EXPECT_FALSE(lock.tryLockWrite());
+
+    read2.reset();
+    EXPECT_TRUE(lock.tryLockWrite());
+}
+
+TEST_F(RwLockTest, tryLockWrite)
+{
+    RwLock lock;
+
+    auto write = lock.tryLockWrite();
+    EXPECT_TRUE(write);
+    EXPECT_FALSE(lock.tryLockWrite());
+    EXPECT_FALSE(lock.tryLockRead());
+
+    write.reset();
+    EXPECT_TRUE(lock.tryLockRead());
+}
+
+TEST_F(RwLockTest, tryLockAndLock)
+{
+    RwLock lock;
+
+    bool isWriteInvoked = false;
+    auto write = lock.lockWrite([&] { isWriteInvoked = true; });
+    EXPECT_FALSE(lock.tryLockRead());
+
+    processEvents();
+    EXPECT_TRUE(isWriteInvoked);
+
+    write.reset();
+    EXPECT_TRUE(lock.tryLockRead());
+}
+
+/* All readers waiting for a write-lock acquire the lock together when it is released. */
+TEST_F(RwLockTest, tryLockWrite_wakesUpReaders)
+{
+    RwLock lock;
+
+    auto write = lock.tryLockWrite();
+    ASSERT_TRUE(write);
+
+    int cntReadInvoked = 0;
+    bool isWriteInvoked = false;
+    std::vector<RaiiToken> reads;
+    for (int i = 0; i < 3; ++i) {
+        reads.push_back(lock.lockRead([&] { cntReadInvoked++; }));
+    }
+    auto write2 = lock.lockWrite([&] { isWriteInvoked = true; });
+
+    processEvents();
+    EXPECT_EQ(0, cntReadInvoked);
+
+    write.reset();
+    processEvents();
+    EXPECT_EQ(3, cntReadInvoked);
+    EXPECT_FALSE(isWriteInvoked);
+
+    reads.clear();
+    processEvents();
+    EXPECT_TRUE(isWriteInvoked);
+}
+
+TEST_F(RwLockTest, tokenOutlivesLock)
+{
+    auto lock = std::make_unique<RwLock>();
+
+    auto read = lock->tryLockRead();
+    bool isWriteInvoked = false;
+    auto write = lock->lockWrite([&] { isWriteInvoked = true; });
+
+    lock.reset();
+    read.reset();
+    write.reset();
+    processEvents();
+    EXPECT_FALSE(isWriteInvoked);
+}
+
+TEST_F(RwLockThreadTest, tryLock_exclusive)
+{
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 20000;
+
+    RwLock lock;
+    std::atomic<int> cntReaders{0};
+    std::atomic<int> cntWriters{0};
+    std::atomic<bool> isViolated{false};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < kIterations; ++j) {
+                if ((i + j) % 4 == 0) {
+                    if (auto write = lock.tryLockWrite()) {
+                        if (++cntWriters != 1 || cntReaders > 0) {
+                            isViolated = true;
+                        }
+                        --cntWriters;
+                    }
+                } else if (auto read = lock.tryLockRead()) {
+                    ++cntReaders;
+                    if (cntWriters > 0) {
+                        isViolated = true;
+                    }
+                    --cntReaders;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(isViolated);
+    EXPECT_TRUE(lock.tryLockWrite());
+}
+
+/* Compares reads through the event loop with reads of a free lock. */
+TEST_F(RwLockTest, DISABLED_read_benchmark)
+{
+    constexpr int kReads = 10000;
+
+    RwLock lock;
+    int cntInvoked = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kReads; ++i) {
+        auto read = lock.lockRead([&] { cntInvoked++; });
+        processEvents();
+    }
+    const auto asyncNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count()
+        / kReads;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kReads; ++i) {
+        if (auto read = lock.tryLockRead()) {
+            cntInvoked++;
+        }
+    }
+    const auto tryNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count()
+        / kReads;
+
+    EXPECT_EQ(2 * kReads, cntInvoked);
+    nf::info("RwLock: {}ns per lockRead(), {}ns per tryLockRead()", asyncNs, tryNs);
+}
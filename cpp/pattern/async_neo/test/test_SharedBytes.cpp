@@ -0,0 +1,158 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include <nf/SharedBytes.h>
+#include <nf/testing/Test.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using namespace nf;
+using namespace nf::testing;
+using namespace bytearray_literals;
+
+class SharedBytesTest : public Test
+{
+};
+
+TEST_F(SharedBytesTest, default_isEmpty)
+{
+    SharedBytes bytes;
+    EXPECT_TRUE(bytes.isEmpty());
+    EXPECT_EQ(0, bytes.size());
+    EXPECT_EQ(bytes.cbegin(), bytes.cend());
+}
+
+/* A big payload shall be taken over without copying it. */
+TEST_F(SharedBytesTest, fromByteArray_noCopy)
+{
+    ByteArray arr;
+    arr.resize(1 << 20, std::byte{0xAB});
+    const auto *payload = arr.data();
+
+    SharedBytes bytes{std::move(arr)};
+    EXPECT_EQ(payload, bytes.data());
+    EXPECT_EQ(1 << 20, bytes.size());
+    EXPECT_TRUE(arr.isEmpty());
+}
+
+TEST_F(SharedBytesTest, fromConstByteArray_copy)
+{
+    const auto arr = 0x00'11'22_hex;
+
+    SharedBytes bytes{arr};
+    EXPECT_NE(arr.data(), bytes.data());
+    EXPECT_EQ(arr, bytes.toByteArray());
+}
+
+TEST_F(SharedBytesTest, copy_sharesStorage)
+{
+    SharedBytes bytes{0x00'11'22'33_hex};
+    auto copy = bytes;
+
+    EXPECT_EQ(bytes.data(), copy.data());
+    EXPECT_EQ(bytes, copy);
+}
+
+TEST_F(SharedBytesTest, mid_sharesStorage)
+{
+    SharedBytes bytes{0x00'11'22'33'44_hex};
+
+    auto mid = bytes.mid(1, 3);
+    EXPECT_EQ(bytes.data() + 1, mid.data());
+    EXPECT_EQ(SharedBytes{0x11'22'33_hex}, mid);
+
+    EXPECT_EQ(SharedBytes{0x33'44_hex}, bytes.mid(3));
+    EXPECT_EQ(SharedBytes{0x33'44_hex}, bytes.mid(3, 10));
+    EXPECT_TRUE(bytes.mid(5).isEmpty());
+    EXPECT_THROW((void)bytes.mid(6), std::out_of_range);
+}
+
+TEST_F(SharedBytesTest, mid_outlivesOriginal)
+{
+    std::optional<SharedBytes> bytes{std::in_place, 0x00'11'22'33_hex};
+    auto mid = bytes->mid(2);
+    bytes.reset();
+
+    EXPECT_EQ(SharedBytes{0x22'33_hex}, mid);
+}
+
+TEST_F(SharedBytesTest, firstAndLast)
+{
+    SharedBytes bytes{0x00'11'22_hex};
+
+    EXPECT_EQ(SharedBytes{0x00'11_hex}, bytes.first(2));
+    EXPECT_EQ(SharedBytes{0x11'22_hex}, bytes.last(2));
+    EXPECT_EQ(bytes, bytes.first(10));
+    EXPECT_EQ(bytes, bytes.last(10));
+    EXPECT_EQ(bytes.data() + 1, bytes.last(2).data());
+}
+
+TEST_F(SharedBytesTest, matching)
+{
+    SharedBytes bytes{0x00'11'22'33_hex};
+
+    EXPECT_TRUE(bytes.startsWith(SharedBytes{0x00'11_hex}));
+    EXPECT_FALSE(bytes.startsWith(SharedBytes{0x11_hex}));
+    EXPECT_TRUE(bytes.startsWith(SharedBytes{}));
+    EXPECT_TRUE(bytes.endsWith(SharedBytes{0x22'33_hex}));
+    EXPECT_FALSE(bytes.endsWith(SharedBytes{0x00'11'22'33'44_hex}));
+    EXPECT_TRUE(bytes.contains(SharedBytes{0x11'22_hex}));
+    EXPECT_FALSE(bytes.contains(SharedBytes{0x22'11_hex}));
+    EXPECT_TRUE(bytes.matches(2, SharedBytes{0x22'33_hex}));
+    EXPECT_FALSE(bytes.matches(2, SharedBytes{0x22'33'44_hex}));
+    EXPECT_FALSE(bytes.matches(4, SharedBytes{0x00_hex}));
+    EXPECT_NE(bytes, bytes.first(3));
+}
+
+TEST_F(SharedBytesTest, access)
+{
+    SharedBytes bytes{0x00'11'22_hex};
+
+    EXPECT_EQ(std::byte{0x11}, bytes[1]);
+    EXPECT_EQ(std::byte{0x22}, bytes.at(2));
+    EXPECT_THROW((void)bytes.at(3), std::out_of_range);
+    EXPECT_EQ(std::byte{0x22}, bytes.mid(1).at(1));
+}
+
+TEST_F(SharedBytesTest, reinterpret)
+{
+    SharedBytes bytes{0xAA'00'01'BC_hex};
+
+    auto expected = std::uint16_t{};
+    std::memcpy(&expected, bytes.data() + 1, sizeof(expected));
+    EXPECT_EQ(expected, bytes.reinterpret<std::uint16_t>(1));
+    EXPECT_EQ(expected, bytes.mid(1).reinterpret<std::uint16_t>(0));
+    EXPECT_FALSE(bytes.reinterpret<std::uint32_t>(1));
+}
+
+TEST_F(SharedBytesTest, toByteArray_isIndependent)
+{
+    SharedBytes bytes{0x00'11_hex};
+
+    auto arr = bytes.toByteArray();
+    arr[0] = std::byte{0xFF};
+    EXPECT_EQ(std::byte{0x00}, bytes[0]);
+}
+
+TEST_F(SharedBytesTest, sharedAcrossThreads)
+{
+    ByteArray arr;
+    arr.resize(1 << 16, std::byte{0x42});
+    SharedBytes bytes{std::move(arr)};
+
+    std::thread thread([copy = bytes.mid(1)] {
+        EXPECT_EQ((1 << 16) - 1, copy.size());
+        EXPECT_EQ(std::byte{0x42}, copy[0]);
+    });
+    bytes = SharedBytes{};
+    thread.join();
+}
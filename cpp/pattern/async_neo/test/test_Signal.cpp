@@ -9,13 +9,22 @@
  *     Alexey Timofeyev <alexey.timofeyev@partner.bmw.de>
  */
 
+#include <nf/Attribute.h>
 #include <nf/Context.h>
+#include <nf/Logging.h>
 #include <nf/Signal.h>
+#include <nf/Thread.h>
 #include <nf/testing/Test.h>
 #include <nf/testing/TestExecutor.h>
 #include <nf/testing/TestTracers.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 using namespace nf;
 using namespace nf::testing;
@@ -59,8 +68,10 @@ TYPED_TEST_P(TypedSignalTest, indirectSignalCopyArgumentsOnlyOnce)
 
     processEvents();
 
+    /* The posted task keeps the arguments inline, so each move of the task by the executor moves
+     * them too. The Asio executor moves it four times. */
     EXPECT_EQ(1, t->cntCopied);
-    EXPECT_EQ(1, t->cntMoved);
+    EXPECT_LE(t->cntMoved, 4);
     EXPECT_EQ("hello", receivedValue);
 }
 
@@ -427,3 +438,323 @@ TEST_F(SignalTest, aggregateInitialization)
     /* See https://stackoverflow.com/q/56745324/2508253. */
     const Signal<int> sig{};
 }
+
+TEST_F(SignalTest, destroySignalDuringNotify)
+{
+    int receivedValue = 0;
+    auto sig = std::make_unique<Signal<int>>();
+
+    auto sub0 = sig->subscribe([&](int /*value*/) { sig.reset(); });
+    auto sub1 = sig->subscribe([&](int value) { receivedValue = value; });
+
+    sig->notify(42);
+    EXPECT_EQ(nullptr, sig);
+    EXPECT_EQ(42, receivedValue);
+}
+
+/* The conflating listener counts the notification it skips after the signal is gone. */
+TEST_F(SignalTest, destroySignalDuringNotify_conflated)
+{
+    std::vector<int> receivedValues;
+    auto sig = std::make_unique<Signal<int>>();
+
+    auto sub0 = sig->subscribe([&](int value) {
+        if (value == 2) {
+            sig.reset();
+        }
+    });
+    auto sub1 = sig->subscribeConflated(Executor::mainThread(),
+                                        [&](int value) { receivedValues.push_back(value); });
+
+    sig->notify(1);
+    sig->notify(2);
+    EXPECT_EQ(nullptr, sig);
+
+    processEvents();
+    EXPECT_EQ((std::vector{2}), receivedValues);
+}
+
+TEST_F(SignalTest, coalesced_copiesArgumentsOnce)
+{
+    CopyTracer t("hello");
+    std::vector<std::string> receivedValues;
+
+    const Signal<CopyTracer> sig{SignalDelivery::Coalesced};
+    const Context ctx;
+    auto sub = sig.subscribe(Executor::mainThread(),
+                             [&](const CopyTracer &t) { receivedValues.push_back(t->value); });
+    sig.subscribe(ctx, [&](const CopyTracer &t) { receivedValues.push_back(t->value); });
+
+    sig.notify(t);
+    EXPECT_TRUE(receivedValues.empty());
+
+    processEvents();
+    EXPECT_EQ((std::vector<std::string>{"hello", "hello"}), receivedValues);
+    EXPECT_EQ(1, t->cntCopied);
+    EXPECT_EQ(0, t->cntMoved);
+}
+
+TEST_F(SignalTest, coalesced_keepsOrder)
+{
+    std::vector<std::string> received;
+
+    const Signal<int> sig{SignalDelivery::Coalesced};
+    const Context ctx;
+    auto subA = sig.subscribe(Executor::mainThread(),
+                              [&](int value) { received.push_back(fmt::format("a{}", value)); });
+    sig.subscribe(ctx, [&](int value) { received.push_back(fmt::format("b{}", value)); });
+    auto subC = sig.subscribe([&](int value) { received.push_back(fmt::format("c{}", value)); });
+
+    sig.notify(1);
+    sig.notify(2);
+    processEvents();
+
+    EXPECT_EQ((std::vector<std::string>{"c1", "c2", "a1", "b1", "a2", "b2"}), received);
+}
+
+TEST_F(SignalTest, coalesced_unsubscribeAfterNotify)
+{
+    int receivedValues[] = {0, 0};
+
+    const Signal<int> sig{SignalDelivery::Coalesced};
+    auto sub0 = sig.subscribe(Executor::mainThread(), [&](int value) {
+        receivedValues[0] = value;
+    });
+    auto sub1 = sig.subscribe(Executor::mainThread(), [&](int value) {
+        receivedValues[1] = value;
+    });
+
+    sig.notify(42);
+    sub1.reset();
+
+    processEvents();
+    EXPECT_EQ(42, receivedValues[0]);
+    EXPECT_EQ(0, receivedValues[1]);
+}
+
+/* A listener which needs its own copy of the arguments is still notified by its own task. */
+TEST_F(SignalTest, coalesced_ownArguments)
+{
+    std::string receivedValue;
+
+    const Signal<std::string> sig{SignalDelivery::Coalesced};
+    auto sub = sig.subscribe(Executor::mainThread(),
+                             [&](std::string &&value) { receivedValue = std::move(value); });
+
+    sig.notify("hello");
+    processEvents();
+    EXPECT_EQ("hello", receivedValue);
+}
+
+TEST_F(SignalTest, conflated_deliversLatest)
+{
+    std::vector<int> receivedValues;
+    const Signal<int> sig;
+
+    auto sub = sig.subscribeConflated(Executor::mainThread(),
+                                      [&](int value) { receivedValues.push_back(value); });
+
+    sig.notify(1);
+    sig.notify(2);
+    sig.notify(3);
+    processEvents();
+    EXPECT_EQ(std::vector<int>{3}, receivedValues);
+    EXPECT_EQ(2, sig.conflatedCount());
+
+    sig.notify(4);
+    processEvents();
+    EXPECT_EQ((std::vector<int>{3, 4}), receivedValues);
+    EXPECT_EQ(2, sig.conflatedCount());
+}
+
+TEST_F(SignalTest, conflated_context)
+{
+    std::vector<std::string> receivedValues;
+    const Signal<std::string> sig;
+
+    {
+        const Context ctx;
+        sig.subscribeConflated(ctx, [&](const std::string &value) {
+            receivedValues.push_back(value);
+        });
+
+        sig.notify("one");
+        sig.notify("two");
+        processEvents();
+        EXPECT_EQ(std::vector<std::string>{"two"}, receivedValues);
+        EXPECT_EQ(1, sig.conflatedCount());
+
+        sig.notify("three");
+    }
+
+    processEvents();
+    EXPECT_EQ(std::vector<std::string>{"two"}, receivedValues);
+}
+
+TEST_F(SignalTest, conflated_unsubscribeAfterNotify)
+{
+    int receivedValue = 0;
+    const Signal<int> sig;
+
+    auto sub = sig.subscribeConflated(Executor::mainThread(),
+                                      [&](int value) { receivedValue = value; });
+    sig.notify(42);
+    sub.reset();
+
+    processEvents();
+    EXPECT_EQ(0, receivedValue);
+}
+
+TEST_F(SignalTest, conflated_attribute)
+{
+    std::vector<int> receivedValues;
+    Attribute<int> attribute;
+
+    const Context ctx;
+    attribute.changed.subscribeConflated(ctx, [&](int value) { receivedValues.push_back(value); });
+
+    for (int i = 1; i <= 100; ++i) {
+        attribute.set(i);
+    }
+    processEvents();
+
+    EXPECT_EQ(std::vector<int>{100}, receivedValues);
+    EXPECT_EQ(99, attribute.changed.conflatedCount());
+}
+
+/* Listeners come and go while other threads notify. */
+TEST_F(SignalTest, notify_concurrentSubscriptions)
+{
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 10000;
+
+    const Signal<int> sig;
+    std::atomic<int> received{0};
+    auto permanent = sig.subscribe([&](int value) { received += value; });
+
+    std::atomic<bool> isDone{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            while (!isDone) {
+                sig.notify(1);
+            }
+        });
+    }
+
+    for (int i = 0; i < kIterations; ++i) {
+        auto transient = sig.subscribe([](int /*value*/) {});
+        transient.reset();
+    }
+    isDone = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    const auto before = received.load();
+    sig.notify(1);
+    EXPECT_EQ(before + 1, received);
+}
+
+/* Measures notifications of a signal with a typical number of direct listeners. */
+TEST_F(SignalTest, DISABLED_notify_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kListeners = 20;
+    constexpr int kNotifications = 1000000;
+
+    const Signal<int> sig;
+    int sum = 0;
+    std::vector<Subscription> subscriptions;
+    for (int i = 0; i < kListeners; ++i) {
+        subscriptions.push_back(sig.subscribe([&sum](int value) { sum += value; }));
+    }
+
+    const auto start = Clock::now();
+    for (int i = 0; i < kNotifications; ++i) {
+        sig.notify(1);
+    }
+    const auto elapsed = Clock::now() - start;
+
+    EXPECT_EQ(kListeners * kNotifications, sum);
+    nf::info("Notifying {} listeners: {:.1f}ns per notification", kListeners,
+             std::chrono::duration<double, std::nano>(elapsed).count() / kNotifications);
+}
+
+/* Measures notifications of a signal with many asynchronous listeners on one executor. */
+TEST_F(SignalTest, DISABLED_coalesced_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kListeners = 20;
+    constexpr int kNotifications = 20000;
+
+    const auto measure = [](SignalDelivery delivery) {
+        const Signal<std::string> sig{delivery};
+        std::size_t sum = 0;
+        std::vector<Subscription> subscriptions;
+        for (int i = 0; i < kListeners; ++i) {
+            subscriptions.push_back(sig.subscribe(
+                Executor::mainThread(), [&sum](const std::string &value) { sum += value.size(); }));
+        }
+
+        const std::string value = "A value longer than the small string buffer";
+        const auto start = Clock::now();
+        for (int i = 0; i < kNotifications; ++i) {
+            sig.notify(value);
+        }
+        processEvents();
+        const auto elapsed = Clock::now() - start;
+
+        EXPECT_EQ(value.size() * kListeners * kNotifications, sum);
+        return std::chrono::duration<double, std::nano>(elapsed).count() / kNotifications;
+    };
+
+    const auto perListener = measure(SignalDelivery::PerListener);
+    const auto coalesced = measure(SignalDelivery::Coalesced);
+    nf::info("Notifying {} queued listeners: {:.0f}ns per listener, {:.0f}ns coalesced",
+             kListeners, perListener, coalesced);
+}
+
+/* Measures a producer which outruns a consumer on another thread. */
+TEST_F(SignalTest, DISABLED_conflated_benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int kNotifications = 10000;
+
+    const auto measure = [](bool isConflated) {
+        const Signal<int> sig;
+        std::atomic<int> received{0};
+        std::atomic<int> latest{0};
+        const auto consume = [&](int value) {
+            ++received;
+            latest = value;
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        };
+
+        Thread consumer;
+        std::promise<std::shared_ptr<Executor>> executorPromise;
+        consumer.post([&] { executorPromise.set_value(Executor::thisThread()); });
+        const auto executor = executorPromise.get_future().get();
+        auto sub = isConflated ? sig.subscribeConflated(executor, consume)
+                               : sig.subscribe(executor, consume);
+
+        const auto start = Clock::now();
+        for (int i = 1; i <= kNotifications; ++i) {
+            sig.notify(i);
+        }
+        while (latest != kNotifications) {
+            std::this_thread::yield();
+        }
+        const auto elapsed = Clock::now() - start;
+
+        consumer.syncJoin();
+        return std::make_pair(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+                              received.load());
+    };
+
+    const auto [queuedTime, queued] = measure(false);
+    const auto [conflatedTime, conflated] = measure(true);
+    nf::info("Last of {} notifications delivered after {}ms with {} invocations, conflated after "
+             "{}ms with {} invocations",
+             kNotifications, queuedTime.count(), queued, conflatedTime.count(), conflated);
+}
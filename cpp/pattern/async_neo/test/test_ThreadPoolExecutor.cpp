@@ -0,0 +1,284 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include <nf/Context.h>
+#include <nf/Logging.h>
+#include <nf/ThreadPoolExecutor.h>
+#include <nf/async/Execute.h>
+#include <nf/testing/Test.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace nf;
+using namespace nf::testing;
+using namespace std::chrono_literals;
+
+class ThreadPoolExecutorTest : public Test
+{
+};
+
+TEST_F(ThreadPoolExecutorTest, post_runsAllTasks)
+{
+    constexpr int kTasks = 10000;
+
+    auto pool = ThreadPoolExecutor::create(4);
+    EXPECT_EQ(4, pool->threadCount());
+
+    std::atomic<int> cntExecuted{0};
+    std::promise<void> done;
+    for (int i = 0; i < kTasks; ++i) {
+        pool->post([&] {
+            if (++cntExecuted == kTasks) {
+                done.set_value();
+            }
+        });
+    }
+
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+}
+
+TEST_F(ThreadPoolExecutorTest, postBatch_runsAllTasks)
+{
+    constexpr int kTasks = 100;
+
+    auto pool = ThreadPoolExecutor::create(2);
+    std::atomic<int> cntExecuted{0};
+    std::promise<void> done;
+
+    std::vector<Executor::Task> tasks;
+    for (int i = 0; i < kTasks; ++i) {
+        tasks.emplace_back([&] {
+            if (++cntExecuted == kTasks) {
+                done.set_value();
+            }
+        });
+    }
+    pool->postBatch(std::move(tasks));
+
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+}
+
+/* Tasks posted by a worker land in its own deque, the idle workers steal them. */
+TEST_F(ThreadPoolExecutorTest, post_fromWorker_stolen)
+{
+    constexpr int kTasks = 32;
+
+    auto pool = ThreadPoolExecutor::create(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    std::atomic<int> cntExecuted{0};
+    std::promise<void> done;
+
+    pool->post([&] {
+        for (int i = 0; i < kTasks; ++i) {
+            pool->post([&] {
+                std::this_thread::sleep_for(2ms);
+                {
+                    std::unique_lock lock(mutex);
+                    threadIds.insert(std::this_thread::get_id());
+                }
+                if (++cntExecuted == kTasks) {
+                    done.set_value();
+                }
+            });
+        }
+    });
+
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+    std::unique_lock lock(mutex);
+    EXPECT_GT(threadIds.size(), 1);
+}
+
+TEST_F(ThreadPoolExecutorTest, strand_serializesInOrder)
+{
+    constexpr int kStrands = 4;
+    constexpr int kTasks = 5000;
+
+    auto pool = ThreadPoolExecutor::create(4);
+    std::atomic<int> cntFinished{0};
+    std::promise<void> done;
+
+    struct State
+    {
+        std::shared_ptr<Executor> strand;
+        std::atomic<bool> isInside{false};
+        bool isSerialized = true;
+        std::vector<int> order;
+    };
+    std::vector<State> states(kStrands);
+
+    for (auto &state : states) {
+        state.strand = pool->makeStrand();
+    }
+    for (int i = 0; i < kTasks; ++i) {
+        for (auto &state : states) {
+            state.strand->post([&, i] {
+                if (state.isInside.exchange(true)) {
+                    state.isSerialized = false;
+                }
+                state.order.push_back(i);
+                state.isInside = false;
+
+                if (i == kTasks - 1 && ++cntFinished == kStrands) {
+                    done.set_value();
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(5s));
+    for (const auto &state : states) {
+        EXPECT_TRUE(state.isSerialized);
+        ASSERT_EQ(static_cast<std::size_t>(kTasks), state.order.size());
+        EXPECT_TRUE(std::is_sorted(state.order.begin(), state.order.end()));
+    }
+}
+
+TEST_F(ThreadPoolExecutorTest, context_execute)
+{
+    auto pool = ThreadPoolExecutor::create(2);
+    Context context(pool->makeStrand());
+    std::promise<int> result;
+
+    async::execute(*pool, [] { return 21; }).then(context, [&](int value) {
+        context.post([&, value] { result.set_value(value * 2); });
+    });
+
+    auto future = result.get_future();
+    ASSERT_EQ(std::future_status::ready, future.wait_for(5s));
+    EXPECT_EQ(42, future.get());
+}
+
+TEST_F(ThreadPoolExecutorTest, delayedPost_runsInPool)
+{
+    const auto &executor = Executor::thisThread();
+    auto pool = ThreadPoolExecutor::create(2, executor);
+    std::thread::id threadId;
+
+    const auto start = pool->now();
+    pool->post(20ms, [&] {
+        threadId = std::this_thread::get_id();
+        executor->post([&] { executor->stop(); });
+    });
+    executor->run();
+
+    EXPECT_GE(pool->now() - start, 20ms);
+    EXPECT_NE(std::this_thread::get_id(), threadId);
+}
+
+TEST_F(ThreadPoolExecutorTest, run_rethrowsException)
+{
+    auto pool = ThreadPoolExecutor::create(2);
+
+    std::thread poster([&] {
+        /* Give run() time to start waiting. */
+        std::this_thread::sleep_for(50ms);
+        pool->post([] { throw std::runtime_error("task failed"); });
+    });
+
+    EXPECT_THROW(pool->run(), std::runtime_error);
+    poster.join();
+}
+
+TEST_F(ThreadPoolExecutorTest, stop_returnsExitCode)
+{
+    auto pool = ThreadPoolExecutor::create(2);
+    pool->post([&] { pool->stop(7); });
+    EXPECT_EQ(7, pool->run());
+}
+
+TEST_F(ThreadPoolExecutorTest, destroyedByOwnTask)
+{
+    struct LastOwner
+    {
+        LastOwner(std::shared_ptr<ThreadPoolExecutor> pool, std::promise<void> &destroyed)
+            : pool(std::move(pool))
+            , destroyed(&destroyed)
+        {
+        }
+
+        std::shared_ptr<ThreadPoolExecutor> pool;
+        std::promise<void> *destroyed;
+
+        ~LastOwner()
+        {
+            pool.reset();
+            destroyed->set_value();
+        }
+    };
+
+    std::promise<void> destroyed;
+    std::promise<void> released;
+    auto pool = ThreadPoolExecutor::create(2);
+
+    /* The task finishes only after the test has released its reference. */
+    pool->post([owner = std::make_shared<LastOwner>(pool, destroyed),
+                isReleased = released.get_future().share()] { isReleased.wait(); });
+    pool.reset();
+    released.set_value();
+
+    EXPECT_EQ(std::future_status::ready, destroyed.get_future().wait_for(5s));
+}
+
+/* Compares a fork-join workload on one worker and on one worker per CPU. */
+TEST_F(ThreadPoolExecutorTest, DISABLED_forkJoin_benchmark)
+{
+    constexpr int kLeaves = 4096;
+    constexpr int kWorkPerLeave = 20000;
+
+    const auto measure = [](std::size_t threadCount) {
+        auto pool = ThreadPoolExecutor::create(threadCount);
+        std::atomic<int> cntLeaves{0};
+        std::atomic<std::uint64_t> sink{0};
+        std::promise<void> done;
+
+        /* Every task splits its range in two until it reaches a single leave. */
+        std::function<void(int, int)> split = [&](int begin, int end) {
+            if (end - begin > 1) {
+                const auto middle = begin + (end - begin) / 2;
+                pool->post([&, begin, middle] { split(begin, middle); });
+                pool->post([&, middle, end] { split(middle, end); });
+                return;
+            }
+
+            std::uint64_t value = begin;
+            for (int i = 0; i < kWorkPerLeave; ++i) {
+                value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+            }
+            sink += value;
+            if (++cntLeaves == kLeaves) {
+                done.set_value();
+            }
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        pool->post([&] { split(0, kLeaves); });
+        done.get_future().wait();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        /* Join the workers before the state of the tasks goes away. */
+        pool.reset();
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    };
+
+    const auto threadCount = std::max(1U, std::thread::hardware_concurrency());
+    const auto single = measure(1);
+    const auto parallel = measure(threadCount);
+    nf::info("fork-join of {} leaves: {}us on 1 thread, {}us on {} threads ({:.1f}x)", kLeaves,
+             single, parallel, threadCount,
+             parallel > 0 ? static_cast<double>(single) / parallel : 0.0);
+}
@@ -0,0 +1,320 @@
+/*
+ * BMW Neo Framework
+ *
+ * Copyright (C) 2023 BMW Car IT GmbH. All rights reserved.
+ * Contact: http://www.bmw-carit.de/
+ *
+ * Contributors:
+ *     Antons Jeļkins <antons.jelkins@bmw.de>
+ */
+
+#include <nf/Context.h>
+#include <nf/Executor.h>
+#include <nf/Framework.h>
+#include <nf/Logging.h>
+#include <nf/async/Io.h>
+#include <nf/testing/Test.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <vector>
+
+using namespace nf;
+using namespace nf::testing;
+
+namespace {
+
+using IoResult = Result<ByteArray, std::error_code>;
+
+/*
+ * The I/O functions are tested with io_uring, with the epoll fallback and with the default asio
+ * backend. The benchmark does not assert on the numbers, it logs them to compare the backends on
+ * the target.
+ */
+template <typename tFramework>
+class AsyncIoTest : public Test
+{
+public:
+    AsyncIoTest() noexcept
+        : Test(NoFramework{})
+    {
+        Framework::initialize(std::make_unique<tFramework>());
+    }
+
+    ~AsyncIoTest() override
+    {
+        for (const int fd : m_fds) {
+            ::close(fd);
+        }
+    }
+
+    std::array<int, 2> makePipe()
+    {
+        std::array<int, 2> fds{};
+        EXPECT_EQ(0, ::pipe2(fds.data(), O_NONBLOCK | O_CLOEXEC));
+        m_fds.insert(m_fds.end(), fds.begin(), fds.end());
+        return fds;
+    }
+
+    std::array<int, 2> makeSocketPair()
+    {
+        std::array<int, 2> fds{};
+        EXPECT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0,
+                                  fds.data()));
+        m_fds.insert(m_fds.end(), fds.begin(), fds.end());
+        return fds;
+    }
+
+    int makeListener(sockaddr_in &address)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        m_fds.push_back(fd);
+
+        address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        EXPECT_EQ(0, ::bind(fd, reinterpret_cast<sockaddr *>(&address), length));
+        EXPECT_EQ(0, ::listen(fd, 4));
+        EXPECT_EQ(0, ::getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length));
+        return fd;
+    }
+
+    void closeFd(int fd)
+    {
+        ::close(fd);
+        m_fds.erase(std::find(m_fds.begin(), m_fds.end(), fd));
+    }
+
+    void adopt(int fd)
+    {
+        m_fds.push_back(fd);
+    }
+
+private:
+    std::vector<int> m_fds;
+};
+
+using Backends = ::testing::Types<UringFramework, EpollFramework, AsioFramework>;
+TYPED_TEST_SUITE(AsyncIoTest, Backends, );
+
+} // anonymous namespace
+
+TYPED_TEST(AsyncIoTest, readWrite_pipe)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makePipe();
+    nf::Context context;
+    std::optional<std::size_t> cntWritten;
+    std::optional<IoResult> read;
+
+    async::write(fds[1], ByteArray::fromString("hello"))
+        .then(context, [&](Result<std::size_t, std::error_code> result) {
+            cntWritten = result.value();
+        });
+    async::read(fds[0], 16).then(context, [&](IoResult result) {
+        read = std::move(result);
+        executor->stop();
+    });
+    executor->run();
+
+    EXPECT_EQ(5u, cntWritten);
+    ASSERT_TRUE(read);
+    ASSERT_TRUE(*read);
+    EXPECT_EQ(ByteArray::fromString("hello"), read->value());
+}
+
+TYPED_TEST(AsyncIoTest, read_endOfFile)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makePipe();
+    this->closeFd(fds[1]);
+    nf::Context context;
+    std::optional<IoResult> read;
+
+    async::read(fds[0], 16).then(context, [&](IoResult result) {
+        read = std::move(result);
+        executor->stop();
+    });
+    executor->run();
+
+    ASSERT_TRUE(read);
+    ASSERT_TRUE(*read);
+    EXPECT_TRUE(read->value().isEmpty());
+}
+
+TYPED_TEST(AsyncIoTest, sendRecv_socketPair)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makeSocketPair();
+    nf::Context context;
+    std::optional<IoResult> received;
+
+    /* The receive is started first, so it completes only when data arrives. */
+    async::recv(fds[1], 16).then(context, [&](IoResult result) {
+        received = std::move(result);
+        executor->stop();
+    });
+    async::send(fds[0], ByteArray::fromString("ping"));
+    executor->run();
+
+    ASSERT_TRUE(received);
+    ASSERT_TRUE(*received);
+    EXPECT_EQ(ByteArray::fromString("ping"), received->value());
+}
+
+TYPED_TEST(AsyncIoTest, send_error)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makeSocketPair();
+    this->closeFd(fds[1]);
+    nf::Context context;
+    std::optional<Result<std::size_t, std::error_code>> sent;
+
+    async::send(fds[0], ByteArray::fromString("ping"))
+        .then(context, [&](Result<std::size_t, std::error_code> result) {
+            sent = std::move(result);
+            executor->stop();
+        });
+    executor->run();
+
+    ASSERT_TRUE(sent);
+    ASSERT_FALSE(*sent);
+    EXPECT_EQ(std::errc::broken_pipe, sent->errorValue());
+}
+
+TYPED_TEST(AsyncIoTest, accept_loopback)
+{
+    const auto &executor = Executor::thisThread();
+    sockaddr_in address{};
+    const int listener = this->makeListener(address);
+    nf::Context context;
+    std::optional<Result<int, std::error_code>> accepted;
+
+    async::accept(listener).then(context, [&](Result<int, std::error_code> result) {
+        accepted = std::move(result);
+        executor->stop();
+    });
+
+    const int client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    this->adopt(client);
+    ASSERT_EQ(0, ::connect(client, reinterpret_cast<sockaddr *>(&address), sizeof(address)));
+    executor->run();
+
+    ASSERT_TRUE(accepted);
+    ASSERT_TRUE(*accepted);
+    EXPECT_GE(accepted->value(), 0);
+    this->adopt(accepted->value());
+    EXPECT_NE(0, ::fcntl(accepted->value(), F_GETFL) & O_NONBLOCK);
+}
+
+TYPED_TEST(AsyncIoTest, receive_untilClosed)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makeSocketPair();
+    std::vector<IoResult> chunks;
+
+    auto token = async::receive(fds[1], [&](IoResult result) {
+        const bool isClosed = !result || result.value().isEmpty();
+        chunks.push_back(std::move(result));
+        if (isClosed) {
+            executor->stop();
+        }
+    });
+
+    int cntSent = 0;
+    std::function<void()> sendNext = [&] {
+        if (++cntSent > 3) {
+            this->closeFd(fds[0]);
+            return;
+        }
+        ::send(fds[0], "chunk", 5, MSG_NOSIGNAL);
+        /* Each chunk is sent after the previous one has been received. */
+        executor->post([&] { executor->post(sendNext); });
+    };
+    executor->post(sendNext);
+    executor->run();
+
+    std::size_t cntBytes = 0;
+    for (const auto &chunk : chunks) {
+        ASSERT_TRUE(chunk);
+        cntBytes += chunk.value().size();
+    }
+    EXPECT_EQ(15u, cntBytes);
+    ASSERT_FALSE(chunks.empty());
+    EXPECT_TRUE(chunks.back().value().isEmpty());
+}
+
+TYPED_TEST(AsyncIoTest, receive_stoppedByToken)
+{
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makeSocketPair();
+    int cntReceived = 0;
+
+    RaiiToken token;
+    token = async::receive(fds[1], [&](IoResult result) {
+        EXPECT_TRUE(result);
+        ++cntReceived;
+        token.reset();
+        ::send(fds[0], "more", 4, MSG_NOSIGNAL);
+        executor->post(Executor::Delay(50), [&] { executor->stop(); });
+    });
+    ::send(fds[0], "data", 4, MSG_NOSIGNAL);
+    executor->run();
+
+    EXPECT_EQ(1, cntReceived);
+}
+
+TYPED_TEST(AsyncIoTest, DISABLED_echo_benchmark)
+{
+    constexpr int kRoundTrips = 20000;
+    constexpr std::size_t kMessageSize = 64;
+
+    const auto &executor = Executor::thisThread();
+    const auto fds = this->makeSocketPair();
+    ByteArray message;
+    message.resize(kMessageSize, std::byte{0x2a});
+    int cntRoundTrips = 0;
+
+    /* The server echoes everything back, the client sends the next message after the echo. */
+    auto server = async::receive(fds[1], [&](IoResult result) {
+        if (result && !result.value().isEmpty()) {
+            async::send(fds[1], std::move(result).value());
+        }
+    });
+    std::size_t cntPending = kMessageSize;
+    auto client = async::receive(fds[0], [&](IoResult result) {
+        ASSERT_TRUE(result);
+        cntPending -= std::min(cntPending, result.value().size());
+        if (cntPending > 0) {
+            return;
+        }
+        if (++cntRoundTrips == kRoundTrips) {
+            executor->stop();
+            return;
+        }
+        cntPending = kMessageSize;
+        async::send(fds[0], message);
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    async::send(fds[0], message);
+    executor->run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(kRoundTrips, cntRoundTrips);
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    nf::info("{}: {} round trips of {} bytes in {}us ({}ns per round trip)",
+             ::testing::UnitTest::GetInstance()->current_test_info()->type_param(), cntRoundTrips,
+             kMessageSize, us, us * 1000 / kRoundTrips);
+}
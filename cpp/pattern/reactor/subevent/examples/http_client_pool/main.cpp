@@ -0,0 +1,197 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+
+#include <subevent/subevent.hpp>
+#include <subevent/subevent_http.hpp>
+
+SEV_USING_NS
+
+//---------------------------------------------------------------------------//
+// Benchmark
+//---------------------------------------------------------------------------//
+
+// Sends the same requests to a local HttpServer, once over a new connection
+// per request and once through an HttpClientPool.
+
+static const uint16_t PORT = 9001;
+static const size_t REQUEST_COUNT = 10000;
+static const size_t CONCURRENCY = 8;
+
+class Benchmark
+{
+public:
+    Benchmark(NetApplication* app, const std::string& url)
+        : mApp(app), mUrl(url)
+    {
+        mPool = HttpClientPool::newInstance(app);
+        mPool->getOption().maxConnections = CONCURRENCY;
+        mPool->getOption().maxIdleConnections = CONCURRENCY;
+
+        mRequest.setMethod(HttpMethod::Get);
+
+        // request and response are small writes
+        mOption.sockOption.setTcpNoDelay(true);
+    }
+
+    void run(bool pooled, const std::function<void()>& doneHandler)
+    {
+        mPooled = pooled;
+        mDoneHandler = doneHandler;
+        mSentCount = 0;
+        mReceivedCount = 0;
+        mErrorCount = 0;
+        mStart = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < CONCURRENCY; ++i)
+        {
+            sendNext();
+        }
+    }
+
+private:
+    void sendNext()
+    {
+        if (mSentCount == REQUEST_COUNT)
+        {
+            return;
+        }
+
+        ++mSentCount;
+
+        HttpResponseHandler handler =
+            SEV_BIND_2(this, Benchmark::onResponse);
+
+        if (mPooled)
+        {
+            mPool->request(mUrl, mRequest, handler, mOption);
+        }
+        else
+        {
+            HttpClientPtr http = HttpClient::newInstance(mApp);
+            http->getRequest() = mRequest;
+            http->getRequest().getHeader().set(
+                HttpHeaderField::Connection, "close");
+            http->request(mUrl, handler, mOption);
+        }
+    }
+
+    void onResponse(const HttpClientPtr& /* http */, int32_t errorCode)
+    {
+        if (errorCode != 0)
+        {
+            ++mErrorCount;
+        }
+
+        if (++mReceivedCount < REQUEST_COUNT)
+        {
+            sendNext();
+            return;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - mStart;
+        auto usec = std::chrono::duration_cast<
+            std::chrono::microseconds>(elapsed).count();
+
+        std::cout << (mPooled ? "pooled" : "new connection") << ": "
+            << REQUEST_COUNT << " requests in " << usec / 1000 << "ms ("
+            << REQUEST_COUNT * 1000000 / usec << " requests/s, "
+            << mErrorCount << " errors)" << std::endl;
+
+        mApp->post(mDoneHandler);
+    }
+
+    NetApplication* mApp;
+    std::string mUrl;
+    HttpClientPoolPtr mPool;
+    HttpRequest mRequest;
+    HttpClient::RequestOption mOption;
+
+    bool mPooled;
+    std::function<void()> mDoneHandler;
+    size_t mSentCount;
+    size_t mReceivedCount;
+    size_t mErrorCount;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+//---------------------------------------------------------------------------//
+// Main
+//---------------------------------------------------------------------------//
+
+SEV_IMPL_GLOBAL
+
+// usage: http_client_pool [certificate.pem private_key.pem]
+//
+// With a certificate the benchmark runs over https, where the pool also
+// saves the TLS handshakes.
+
+int main(int argc, char** argv)
+{
+    SslContextPtr sslCtx;
+
+    if (argc == 3)
+    {
+        sslCtx = SslContext::newInstance(SSLv23_server_method());
+
+        if (!sslCtx->setCertificateFile(argv[1]) ||
+            !sslCtx->setPrivateKeyFile(argv[2]))
+        {
+            std::cerr << "invalid certificate" << std::endl;
+            return 1;
+        }
+    }
+
+    // server
+    NetThread serverThread;
+    HttpServerPtr server;
+    Semaphore opened;
+
+    serverThread.start();
+    serverThread.post([&]() {
+
+        server = HttpServer::newInstance(&serverThread);
+        server->getSocketOption().setReuseAddress(true);
+        server->getSocketOption().setTcpNoDelay(true);
+        server->open(IpEndPoint(PORT), sslCtx);
+
+        // keeps the connection open
+        server->setRequestHandler(
+            "/", [](const HttpChannelPtr& channel) {
+
+            channel->sendHttpResponse(
+                HttpStatusCode::Ok, "OK",
+                "<html><body>OK</body></html>");
+        });
+
+        opened.post();
+    });
+
+    opened.wait();
+
+    // client
+    NetApplication app;
+    std::string url = (sslCtx != nullptr) ? "https" : "http";
+    url += "://127.0.0.1:" + std::to_string(PORT) + "/";
+
+    Benchmark benchmark(&app, url);
+
+    app.post([&]() {
+        benchmark.run(false, [&]() {
+            benchmark.run(true, [&]() {
+                app.stop();
+            });
+        });
+    });
+
+    int result = app.run();
+
+    serverThread.post([&]() {
+        server->close();
+        server.reset();
+    });
+    serverThread.stop();
+    serverThread.wait();
+
+    return result;
+}
@@ -0,0 +1,261 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include <subevent/subevent.hpp>
+#include <subevent/subevent_http.hpp>
+
+SEV_USING_NS
+
+//---------------------------------------------------------------------------//
+// Allocation counter
+//---------------------------------------------------------------------------//
+
+// Counts the allocations of the server threads. The client runs on the
+// main thread, which is not counted.
+
+static std::atomic<size_t> gAllocationCount(0);
+static SEV_TLS bool gIsClientThread = false;
+
+void* operator new(size_t size)
+{
+    if (!gIsClientThread)
+    {
+        gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+// GCC does not see that operator new above pairs with free()
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+//---------------------------------------------------------------------------//
+// MyThread
+//---------------------------------------------------------------------------//
+
+// The same worker as in http_server_multi_thread, except that the
+// connection is kept open after the response.
+class MyThread : public HttpChannelThread
+{
+public:
+    MyThread(Thread* parent)
+        : HttpChannelThread(parent)
+    {
+        setRequestHandler("/", SEV_BIND_1(this, MyThread::onMyHandler));
+    }
+
+protected:
+    uint16_t getMaxChannels() const override
+    {
+        return 100;
+    }
+
+    void onMyHandler(const HttpChannelPtr& channel)
+    {
+        HttpUrl url(channel->getRequest().getPath());
+        HttpParams params(url.getQuery());
+
+        HttpResponse res;
+        res.setStatusCode(HttpStatusCode::Ok);
+        res.setMessage("OK");
+        res.setBody(
+            "<html><body>"
+                "Path: " + url.getPath() + "<br>"
+                "Parameters: " + params.compose() + "<br>"
+            "</body></html>");
+
+        channel->sendHttpResponse(res);
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Benchmark
+//---------------------------------------------------------------------------//
+
+// Sends requests to an HttpServerThread with worker threads, once over a
+// new connection per request and once over keep-alive connections, and
+// reports the requests per second and the server allocations per request.
+
+static const uint16_t PORT = 9004;
+static const size_t WORKER_COUNT = 4;
+static const size_t REQUEST_COUNT = 20000;
+static const size_t CONCURRENCY = 8;
+
+class Benchmark
+{
+public:
+    Benchmark(NetApplication* app, const std::string& url)
+        : mApp(app), mUrl(url)
+    {
+        mPool = HttpClientPool::newInstance(app);
+        mPool->getOption().maxConnections = CONCURRENCY;
+        mPool->getOption().maxIdleConnections = CONCURRENCY;
+
+        mRequest.setMethod(HttpMethod::Get);
+        mRequest.getHeader().set(HttpHeaderField::UserAgent, "benchmark");
+        mRequest.getHeader().set(HttpHeaderField::Accept, "text/html");
+
+        // request and response are small writes
+        mOption.sockOption.setTcpNoDelay(true);
+    }
+
+    void run(bool keepAlive, const std::function<void()>& doneHandler)
+    {
+        mKeepAlive = keepAlive;
+        mDoneHandler = doneHandler;
+        mSentCount = 0;
+        mReceivedCount = 0;
+        mErrorCount = 0;
+        mAllocationCount = gAllocationCount.load();
+        mStart = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < CONCURRENCY; ++i)
+        {
+            sendNext();
+        }
+    }
+
+private:
+    void sendNext()
+    {
+        if (mSentCount == REQUEST_COUNT)
+        {
+            return;
+        }
+
+        ++mSentCount;
+
+        HttpResponseHandler handler =
+            SEV_BIND_2(this, Benchmark::onResponse);
+
+        if (mKeepAlive)
+        {
+            mPool->request(mUrl, mRequest, handler, mOption);
+        }
+        else
+        {
+            HttpClientPtr http = HttpClient::newInstance(mApp);
+            http->getRequest() = mRequest;
+            http->getRequest().getHeader().set(
+                HttpHeaderField::Connection, "close");
+            http->request(mUrl, handler, mOption);
+        }
+    }
+
+    void onResponse(const HttpClientPtr& /* http */, int32_t errorCode)
+    {
+        if (errorCode != 0)
+        {
+            ++mErrorCount;
+        }
+
+        if (++mReceivedCount < REQUEST_COUNT)
+        {
+            sendNext();
+            return;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - mStart;
+        auto usec = std::chrono::duration_cast<
+            std::chrono::microseconds>(elapsed).count();
+        size_t allocations = gAllocationCount.load() - mAllocationCount;
+
+        std::cout << (mKeepAlive ? "keep-alive" : "new connection") << ": "
+            << REQUEST_COUNT << " requests in " << usec / 1000 << "ms ("
+            << REQUEST_COUNT * 1000000 / usec << " requests/s, "
+            << static_cast<double>(allocations) / REQUEST_COUNT
+            << " allocations/request, " << mErrorCount << " errors)"
+            << std::endl;
+
+        mApp->post(mDoneHandler);
+    }
+
+    NetApplication* mApp;
+    std::string mUrl;
+    HttpClientPoolPtr mPool;
+    HttpRequest mRequest;
+    HttpClient::RequestOption mOption;
+
+    bool mKeepAlive;
+    std::function<void()> mDoneHandler;
+    size_t mSentCount;
+    size_t mReceivedCount;
+    size_t mErrorCount;
+    size_t mAllocationCount;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+//---------------------------------------------------------------------------//
+// Main
+//---------------------------------------------------------------------------//
+
+SEV_IMPL_GLOBAL
+
+int main(int, char**)
+{
+    gIsClientThread = true;
+
+    // server
+    HttpServerThread server;
+    bool opened = false;
+    Semaphore openDone;
+
+    server.start();
+    server.post([&]() {
+
+        server.getTcpServer()->getSocketOption().setReuseAddress(true);
+        server.createThread<MyThread>(WORKER_COUNT);
+
+        opened = server.open(IpEndPoint(PORT));
+
+        openDone.post();
+    });
+
+    openDone.wait();
+
+    if (!opened)
+    {
+        std::cerr << "open error" << std::endl;
+        return 1;
+    }
+
+    // client
+    NetApplication app;
+    Benchmark benchmark(
+        &app, "http://127.0.0.1:" + std::to_string(PORT) + "/path?key=value");
+
+    app.post([&]() {
+        benchmark.run(false, [&]() {
+            benchmark.run(true, [&]() {
+                app.stop();
+            });
+        });
+    });
+
+    int result = app.run();
+
+    server.post([&]() {
+        server.close();
+    });
+    server.stop();
+    server.wait();
+
+    return result;
+}
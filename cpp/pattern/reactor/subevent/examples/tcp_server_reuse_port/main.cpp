@@ -0,0 +1,209 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+
+#include <subevent/subevent.hpp>
+
+SEV_USING_NS
+
+//---------------------------------------------------------------------------//
+// MyThread
+//---------------------------------------------------------------------------//
+
+// Answers each connection with one byte and closes it.
+class MyThread : public TcpChannelThread
+{
+public:
+    MyThread(Thread* parent)
+        : TcpChannelThread(parent) {}
+
+protected:
+    uint16_t getMaxChannels() const override
+    {
+        return 1000;
+    }
+
+    void onAccept(
+        const TcpChannelPtr& channel) override
+    {
+        channel->send("x", 1);
+        channel->close();
+    }
+};
+
+//---------------------------------------------------------------------------//
+// Benchmark
+//---------------------------------------------------------------------------//
+
+// Opens and closes connections to a TcpServerThread, once with the
+// channels handed to the workers and once with SO_REUSEPORT acceptors.
+
+static const size_t WORKER_COUNT = 4;
+static const size_t CONNECTION_COUNT = 10000;
+static const size_t CONCURRENCY = 32;
+
+class Benchmark
+{
+public:
+    Benchmark(NetApplication* app)
+        : mApp(app)
+    {
+    }
+
+    void run(uint16_t port, const std::string& name,
+        const std::function<void()>& doneHandler)
+    {
+        mEndPoint = IpEndPoint("127.0.0.1", port);
+        mName = name;
+        mDoneHandler = doneHandler;
+        mStartedCount = 0;
+        mFinishedCount = 0;
+        mErrorCount = 0;
+        mStart = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < CONCURRENCY; ++i)
+        {
+            connectNext();
+        }
+    }
+
+private:
+    void connectNext()
+    {
+        if (mStartedCount == CONNECTION_COUNT)
+        {
+            return;
+        }
+
+        ++mStartedCount;
+
+        TcpClientPtr client = TcpClient::newInstance(mApp);
+
+        client->setReceiveHandler([this](const TcpChannelPtr& channel) {
+
+            channel->receiveAll();
+            channel->close();
+
+            onFinished(true);
+        });
+
+        client->connect(mEndPoint,
+            [this](const TcpClientPtr& channel, int errorCode) {
+
+            if (errorCode != 0)
+            {
+                channel->close();
+                onFinished(false);
+            }
+        });
+    }
+
+    void onFinished(bool succeeded)
+    {
+        if (!succeeded)
+        {
+            ++mErrorCount;
+        }
+
+        if (++mFinishedCount < CONNECTION_COUNT)
+        {
+            connectNext();
+            return;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - mStart;
+        auto usec = std::chrono::duration_cast<
+            std::chrono::microseconds>(elapsed).count();
+
+        std::cout << mName << ": "
+            << CONNECTION_COUNT << " connections in " << usec / 1000
+            << "ms (" << CONNECTION_COUNT * 1000000 / usec
+            << " connections/s, " << mErrorCount << " errors)"
+            << std::endl;
+
+        mApp->post(mDoneHandler);
+    }
+
+    NetApplication* mApp;
+    IpEndPoint mEndPoint;
+    std::string mName;
+
+    std::function<void()> mDoneHandler;
+    size_t mStartedCount;
+    size_t mFinishedCount;
+    size_t mErrorCount;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+//---------------------------------------------------------------------------//
+// Main
+//---------------------------------------------------------------------------//
+
+SEV_IMPL_GLOBAL
+
+static bool openServer(TcpServerThread& server,
+    TcpServerWorker::AcceptMode acceptMode, uint16_t port)
+{
+    bool result = false;
+    Semaphore opened;
+
+    server.start();
+    server.post([&]() {
+
+        server.getTcpServer()->getSocketOption().setReuseAddress(true);
+        server.setAcceptMode(acceptMode);
+        server.createThread<MyThread>(WORKER_COUNT);
+
+        result = server.open(IpEndPoint(port));
+
+        opened.post();
+    });
+
+    opened.wait();
+
+    return result;
+}
+
+static void closeServer(TcpServerThread& server)
+{
+    server.post([&]() {
+        server.close();
+    });
+    server.stop();
+    server.wait();
+}
+
+int main(int, char**)
+{
+    // server
+    TcpServerThread dispatchServer;
+    TcpServerThread reusePortServer;
+
+    if (!openServer(dispatchServer,
+            TcpServerWorker::AcceptMode::Dispatch, 9002) ||
+        !openServer(reusePortServer,
+            TcpServerWorker::AcceptMode::ReusePort, 9003))
+    {
+        std::cerr << "open error" << std::endl;
+        return 1;
+    }
+
+    // client
+    NetApplication app;
+    Benchmark benchmark(&app);
+
+    app.post([&]() {
+        benchmark.run(9002, "dispatch", [&]() {
+            benchmark.run(9003, "reuse port", [&]() {
+                app.stop();
+            });
+        });
+    });
+
+    int result = app.run();
+
+    closeServer(dispatchServer);
+    closeServer(reusePortServer);
+
+    return result;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include <subevent/subevent.hpp>
+
+SEV_USING_NS
+
+//---------------------------------------------------------------------------//
+// Benchmark
+//---------------------------------------------------------------------------//
+
+// Churns idle timers the way a server with one keep-alive timer
+// per connection does: every activity on a connection restarts its timer.
+
+static const size_t TIMER_COUNT = 100000;
+static const size_t CHURN_ROUNDS = 10;
+
+template<typename F>
+static void measure(const char* name, size_t count, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto nsec = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(elapsed).count();
+    std::cout << name << ": " << count << " timers in "
+        << nsec / 1000000 << "ms (" << nsec / count << "ns per timer)"
+        << std::endl;
+}
+
+//---------------------------------------------------------------------------//
+// Main
+//---------------------------------------------------------------------------//
+
+SEV_IMPL_GLOBAL
+
+int main(int, char**)
+{
+    Application app;
+
+    std::vector<Timer> timers(TIMER_COUNT);
+    TimerHandler idle = [](Timer*) {};
+
+    measure("start", TIMER_COUNT, [&]() {
+        for (size_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            timers[i].start(30000 + static_cast<uint32_t>(i % 30000), false, idle);
+        }
+    });
+
+    measure("restart", TIMER_COUNT * CHURN_ROUNDS, [&]() {
+        for (size_t round = 0; round < CHURN_ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < TIMER_COUNT; ++i)
+            {
+                // a pseudo random connection becomes active
+                Timer& timer = timers[(i * 7919 + round) % TIMER_COUNT];
+                timer.cancel();
+                timer.start(30000 + static_cast<uint32_t>(i % 30000), false, idle);
+            }
+        }
+    });
+
+    measure("cancel", TIMER_COUNT, [&]() {
+        for (size_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            timers[(i * 7919) % TIMER_COUNT].cancel();
+        }
+    });
+
+    // short timers still expire in order of their intervals
+    size_t expiredCount = 0;
+    uint32_t lastInterval = 0;
+    bool ordered = true;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        timers[i].start(static_cast<uint32_t>(1 + (i * 7) % 20), false,
+            [&](Timer* timer) {
+
+            ordered = ordered && (timer->getInterval() >= lastInterval);
+            lastInterval = timer->getInterval();
+
+            if (++expiredCount == 1000)
+            {
+                app.stop();
+            }
+        });
+    }
+
+    int32_t result = app.run();
+
+    std::cout << "expired: " << expiredCount
+        << (ordered ? " in order" : " out of order") << std::endl;
+
+    return result;
+}
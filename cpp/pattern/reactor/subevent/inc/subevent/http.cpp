@@ -2,6 +2,7 @@
 #define SUBEVENT_HTTP_INL
 
 #include <fstream>
+#include <cstring>
 #include <algorithm>
 
 #include <subevent/network.hpp>
@@ -582,6 +583,15 @@ void HttpHeader::add(
     }
 }
 
+void HttpHeader::add(
+    std::string&& name, std::string&& value)
+{
+    if (!value.empty())
+    {
+        mFields.push_back({ std::move(name), std::move(value) });
+    }
+}
+
 void HttpHeader::remove(const std::string& name)
 {
     auto it = std::remove_if(
@@ -1497,6 +1507,239 @@ HttpResponse& HttpResponse::operator=(HttpResponse&& other)
     return *this;
 }
 
+//----------------------------------------------------------------------------//
+// HttpRequestParser
+//----------------------------------------------------------------------------//
+
+HttpRequestParser::HttpRequestParser()
+{
+    // typical number of fields, grown once at most
+    mFields.reserve(16);
+
+    reset();
+}
+
+HttpRequestParser::~HttpRequestParser()
+{
+}
+
+void HttpRequestParser::reset(size_t start)
+{
+    mState = State::RequestLine;
+    mStart = start;
+    mSize = 0;
+    mScanned = 0;
+
+    mMethod = { 0, 0 };
+    mPath = { 0, 0 };
+    mProtocol = { 0, 0 };
+
+    // keeps the capacity
+    mFields.clear();
+}
+
+HttpRequestParser::Result HttpRequestParser::parse(
+    const char* data, size_t size)
+{
+    if (mState == State::Completed)
+    {
+        return Result::Completed;
+    }
+
+    const char* message = data + mStart;
+    size_t messageSize = size - mStart;
+
+    while (mState != State::Completed)
+    {
+        // scan from where the previous call stopped
+        const char* lf = static_cast<const char*>(std::memchr(
+            message + mScanned, '\n', messageSize - mScanned));
+
+        if (lf == nullptr)
+        {
+            mScanned = messageSize;
+
+            if (mScanned - mSize > MaxLineSize)
+            {
+                // too long line
+                return Result::Invalid;
+            }
+
+            return Result::Incomplete;
+        }
+
+        size_t lineSize = (lf - message) - mSize;
+
+        if ((lineSize == 0) || (message[mSize + lineSize - 1] != '\r'))
+        {
+            // CRLF only
+            return Result::Invalid;
+        }
+
+        if (lineSize > MaxLineSize)
+        {
+            return Result::Invalid;
+        }
+
+        bool result;
+
+        if (mState == State::RequestLine)
+        {
+            if (lineSize == 1)
+            {
+                // CRLF after the previous body
+                result = true;
+            }
+            else
+            {
+                result = parseRequestLine(message + mSize, lineSize - 1);
+                mState = State::FieldLine;
+            }
+        }
+        else if (lineSize == 1)
+        {
+            // empty line
+            result = true;
+            mState = State::Completed;
+        }
+        else
+        {
+            result = parseFieldLine(message + mSize, lineSize - 1);
+        }
+
+        if (!result)
+        {
+            return Result::Invalid;
+        }
+
+        mSize += lineSize + 1;
+        mScanned = mSize;
+    }
+
+    return Result::Completed;
+}
+
+bool HttpRequestParser::parseRequestLine(
+    const char* line, size_t size)
+{
+    const char* end = line + size;
+    size_t offset = mSize;
+
+    // method
+    const char* sp1 = std::find(line, end, ' ');
+
+    if ((sp1 == line) || (sp1 == end))
+    {
+        return false;
+    }
+
+    mMethod = { offset, static_cast<size_t>(sp1 - line) };
+
+    // path
+    const char* path = sp1 + 1;
+    const char* sp2 = std::find(path, end, ' ');
+
+    if ((sp2 == path) || (sp2 == end))
+    {
+        return false;
+    }
+
+    mPath = { offset + (path - line), static_cast<size_t>(sp2 - path) };
+
+    // protocol
+    const char* protocol = sp2 + 1;
+
+    if (protocol == end)
+    {
+        return false;
+    }
+
+    mProtocol = {
+        offset + (protocol - line), static_cast<size_t>(end - protocol) };
+
+    return true;
+}
+
+bool HttpRequestParser::parseFieldLine(
+    const char* line, size_t size)
+{
+    const char* end = line + size;
+    const char* colon = std::find(line, end, ':');
+
+    if (colon == end)
+    {
+        return false;
+    }
+
+    auto isSpace = [](char c) {
+        return ((c == ' ') || (c == '\t'));
+    };
+
+    // name
+    const char* nameFirst = line;
+    const char* nameLast = colon;
+
+    while ((nameFirst < nameLast) && isSpace(*nameFirst))
+    {
+        ++nameFirst;
+    }
+
+    while ((nameLast > nameFirst) && isSpace(*(nameLast - 1)))
+    {
+        --nameLast;
+    }
+
+    if (nameFirst == nameLast)
+    {
+        return false;
+    }
+
+    // value
+    const char* valueFirst = colon + 1;
+    const char* valueLast = end;
+
+    while ((valueFirst < valueLast) && isSpace(*valueFirst))
+    {
+        ++valueFirst;
+    }
+
+    while ((valueLast > valueFirst) && isSpace(*(valueLast - 1)))
+    {
+        --valueLast;
+    }
+
+    Field field;
+    field.name = {
+        mSize + (nameFirst - line),
+        static_cast<size_t>(nameLast - nameFirst) };
+    field.value = {
+        mSize + (valueFirst - line),
+        static_cast<size_t>(valueLast - valueFirst) };
+
+    mFields.push_back(field);
+
+    return true;
+}
+
+void HttpRequestParser::materialize(
+    const char* data, HttpRequest& request) const
+{
+    request.clear();
+
+    request.setMethod(toString(data, mMethod));
+    request.setPath(toString(data, mPath));
+    request.setProtocol(toString(data, mProtocol));
+
+    HttpHeader& header = request.getHeader();
+
+    for (const auto& field : mFields)
+    {
+        header.add(
+            toString(data, field.name),
+            toString(data, field.value));
+    }
+}
+
 //----------------------------------------------------------------------------//
 // HttpContentReceiver::ChunkWork
 //----------------------------------------------------------------------------//
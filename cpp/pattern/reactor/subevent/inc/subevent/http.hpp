@@ -437,6 +437,8 @@ public:
 
     SEV_DECL void add(
         const std::string& name, const std::string& value);
+    SEV_DECL void add(
+        std::string&& name, std::string&& value);
     SEV_DECL void remove(
         const std::string& name);
     SEV_DECL std::list<std::string> find(
@@ -714,6 +716,126 @@ private:
     std::string mMessage;
 };
 
+//----------------------------------------------------------------------------//
+// HttpRequestParser
+//----------------------------------------------------------------------------//
+
+// Parses the request line and header fields in the receive buffer
+// without copying them. It resumes after the last complete line when
+// more data has arrived. Tokens are offsets from the start of the
+// message, so they stay valid when the buffer grows or moves.
+class HttpRequestParser
+{
+public:
+    SEV_DECL HttpRequestParser();
+    SEV_DECL ~HttpRequestParser();
+
+    static const size_t MaxLineSize = 10240;
+
+    enum class Result
+    {
+        Completed,
+        Incomplete,
+        Invalid
+    };
+
+    struct Token
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    struct Field
+    {
+        Token name;
+        Token value;
+    };
+
+public:
+    // data is the whole buffer, the message begins at getStart()
+    SEV_DECL Result parse(const char* data, size_t size);
+
+    // next message
+    SEV_DECL void reset(size_t start = 0);
+
+    // the first size bytes have been erased from the buffer
+    SEV_DECL void shift(size_t size)
+    {
+        mStart -= size;
+    }
+
+    SEV_DECL size_t getStart() const
+    {
+        return mStart;
+    }
+
+    // the body begins here
+    SEV_DECL size_t getEnd() const
+    {
+        return mStart + mSize;
+    }
+
+    SEV_DECL bool isCompleted() const
+    {
+        return (mState == State::Completed);
+    }
+
+    SEV_DECL const Token& getMethod() const
+    {
+        return mMethod;
+    }
+
+    SEV_DECL const Token& getPath() const
+    {
+        return mPath;
+    }
+
+    SEV_DECL const Token& getProtocol() const
+    {
+        return mProtocol;
+    }
+
+    SEV_DECL const std::vector<Field>& getFields() const
+    {
+        return mFields;
+    }
+
+    SEV_DECL std::string toString(
+        const char* data, const Token& token) const
+    {
+        return std::string(data + mStart + token.offset, token.size);
+    }
+
+    // copies the tokens into the request
+    SEV_DECL void materialize(
+        const char* data, HttpRequest& request) const;
+
+private:
+    enum class State
+    {
+        RequestLine,
+        FieldLine,
+        Completed
+    };
+
+    SEV_DECL bool parseRequestLine(
+        const char* line, size_t size);
+    SEV_DECL bool parseFieldLine(
+        const char* line, size_t size);
+
+    State mState;
+
+    // from mStart
+    size_t mStart;
+    size_t mSize;
+    size_t mScanned;
+
+    Token mMethod;
+    Token mPath;
+    Token mProtocol;
+    std::vector<Field> mFields;
+};
+
 //----------------------------------------------------------------------------//
 // HttpContentReceiver
 //----------------------------------------------------------------------------//
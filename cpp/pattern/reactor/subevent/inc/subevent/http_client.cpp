@@ -37,17 +37,6 @@ bool HttpClient::request(
         return false;
     }
 
-    mUrl.clear();
-    mResponse.clear();
-    mContentReceiver.clear();
-    mResponseTempBuffer.clear();
-    mOption.clear();
-    mRedirectHashes.clear();
-
-#ifdef SEV_SUPPORTS_SSL
-    mSslContext.reset();
-#endif
-
     if (mRequest.getMethod().empty())
     {
         return false;
@@ -69,6 +58,7 @@ bool HttpClient::request(
     }
 #endif
 
+    // keep the connection to the same origin
     if ((httpUrl.getScheme() != mUrl.getScheme()) ||
         (httpUrl.getHost() != mUrl.getHost()) ||
         (httpUrl.getPort() != mUrl.getPort()))
@@ -76,6 +66,19 @@ bool HttpClient::request(
         close();
     }
 
+    mResponse.clear();
+    mContentReceiver.clear();
+    mResponseTempBuffer.clear();
+    mOption.clear();
+    mRedirectHashes.clear();
+
+#ifdef SEV_SUPPORTS_SSL
+    if (isClosed())
+    {
+        mSslContext.reset();
+    }
+#endif
+
     mUrl = std::move(httpUrl);
     mResponseHandler = responseHandler;
     mOption = option;
@@ -201,6 +204,33 @@ bool HttpClient::isResponseCompleted() const
     return true;
 }
 
+bool HttpClient::isKeepAlive() const
+{
+    const std::string& request =
+        mRequest.getHeader().get(HttpHeaderField::Connection);
+
+    if (String::iequals(request, "close"))
+    {
+        return false;
+    }
+
+    const std::string& response =
+        mResponse.getHeader().get(HttpHeaderField::Connection);
+
+    if (String::iequals(response, "close"))
+    {
+        return false;
+    }
+
+    if (mResponse.getProtocol() == HttpProtocol::v1_0)
+    {
+        // HTTP/1.0 closes unless asked otherwise
+        return String::iequals(response, "keep-alive");
+    }
+
+    return true;
+}
+
 void HttpClient::sendHttpRequest()
 {
     // path
@@ -263,7 +293,10 @@ Socket* HttpClient::createSocket(
                 SslContext::newInstance(SSLv23_client_method());
         }
 
-        socket = new SecureSocket(mSslContext);
+        SecureSocket* secureSocket = new SecureSocket(mSslContext);
+        secureSocket->setSession(mOption.sslSession);
+
+        socket = secureSocket;
     }
     else
     {
@@ -381,6 +414,12 @@ void HttpClient::onResponse(int32_t errorCode)
         }
     }
 
+    if ((errorCode == 0) && !isKeepAlive())
+    {
+        // the server closes, don't reuse
+        close();
+    }
+
     mRunning = false;
 
     if (mResponseHandler != nullptr)
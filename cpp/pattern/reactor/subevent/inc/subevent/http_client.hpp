@@ -51,6 +51,7 @@ public:
             sockOption.clear();
 #ifdef SEV_SUPPORTS_SSL
             sslCtx.reset();
+            sslSession.reset();
 #endif
         }
 
@@ -60,6 +61,9 @@ public:
         SocketOption sockOption;
 #ifdef SEV_SUPPORTS_SSL
         SslContextPtr sslCtx;
+
+        // resumed by a new connection and updated by it
+        SslSessionPtr sslSession;
 #endif
     };
 
@@ -121,6 +125,7 @@ private:
     SEV_DECL void start();
     SEV_DECL void sendHttpRequest();
     SEV_DECL bool isResponseCompleted() const;
+    SEV_DECL bool isKeepAlive() const;
     SEV_DECL bool onHttpResponse(StringReader& reader);
     SEV_DECL int32_t redirect();
 
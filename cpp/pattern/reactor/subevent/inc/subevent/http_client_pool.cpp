@@ -0,0 +1,313 @@
+#ifndef SUBEVENT_HTTP_CLIENT_POOL_INL
+#define SUBEVENT_HTTP_CLIENT_POOL_INL
+
+#include <iostream>
+
+#include <subevent/http_client_pool.hpp>
+#include <subevent/network.hpp>
+
+SEV_NS_BEGIN
+
+//----------------------------------------------------------------------------//
+// HttpClientPool
+//----------------------------------------------------------------------------//
+
+HttpClientPool::HttpClientPool(NetWorker* netWorker)
+{
+    mNetWorker = netWorker;
+}
+
+HttpClientPool::~HttpClientPool()
+{
+    closeIdleConnections();
+}
+
+bool HttpClientPool::request(
+    const std::string& url,
+    const HttpRequest& req,
+    const HttpResponseHandler& responseHandler,
+    const HttpClient::RequestOption& option)
+{
+    if (req.getMethod().empty())
+    {
+        return false;
+    }
+
+    HttpUrl httpUrl;
+
+    if (!httpUrl.parse(url))
+    {
+        return false;
+    }
+
+#ifndef SEV_SUPPORTS_SSL
+    if (httpUrl.isSecureScheme())
+    {
+        std::cerr <<
+            "[Subevent Error] OpenSSL is not installed." << std::endl;
+        return false;
+    }
+#endif
+
+    PendingPtr pending = std::make_shared<Pending>();
+    pending->url = url;
+    pending->request = req;
+    pending->responseHandler = responseHandler;
+    pending->option = option;
+    pending->retried = false;
+
+    return dispatch(makeKey(httpUrl), pending);
+}
+
+void HttpClientPool::closeIdleConnections()
+{
+    for (auto& origin : mOrigins)
+    {
+        for (auto& idle : origin.second.idles)
+        {
+            idle.timer->cancel();
+            idle.client->close();
+        }
+
+        origin.second.idles.clear();
+    }
+}
+
+size_t HttpClientPool::getIdleCount() const
+{
+    size_t count = 0;
+
+    for (const auto& origin : mOrigins)
+    {
+        count += origin.second.idles.size();
+    }
+
+    return count;
+}
+
+std::string HttpClientPool::makeKey(const HttpUrl& url)
+{
+    return url.getScheme() + "://" +
+        url.getHost() + ":" + std::to_string(url.getPort());
+}
+
+bool HttpClientPool::dispatch(
+    const std::string& key, const PendingPtr& pending)
+{
+    Origin& origin = mOrigins[key];
+
+    // most recently used first
+    while (!origin.idles.empty())
+    {
+        Idle idle = origin.idles.front();
+        origin.idles.pop_front();
+
+        idle.timer->cancel();
+
+        if (idle.client->isClosed())
+        {
+            // closed by the server
+            continue;
+        }
+
+        if (send(key, idle.client, pending, true))
+        {
+            return true;
+        }
+    }
+
+    if (origin.releasingCount > origin.pendings.size())
+    {
+        // requested in a response handler, take over its connection
+        origin.pendings.push_back(pending);
+        return true;
+    }
+
+    if (origin.activeCount < mOption.maxConnections)
+    {
+        return send(
+            key, HttpClient::newInstance(mNetWorker), pending, false);
+    }
+
+    // wait for a free connection
+    origin.pendings.push_back(pending);
+
+    return true;
+}
+
+bool HttpClientPool::send(
+    const std::string& key,
+    const HttpClientPtr& client,
+    const PendingPtr& pending,
+    bool reused)
+{
+    Origin& origin = mOrigins[key];
+
+    HttpClient::RequestOption option = pending->option;
+
+#ifdef SEV_SUPPORTS_SSL
+    if (option.sslSession == nullptr)
+    {
+        // resumed by new connections to the origin
+        if (origin.sslSession == nullptr)
+        {
+            origin.sslSession = SslSession::newInstance();
+        }
+
+        option.sslSession = origin.sslSession;
+    }
+#endif
+
+    client->getRequest() = pending->request;
+
+    HttpClientPoolPtr self(shared_from_this());
+
+    bool result = client->request(
+        pending->url,
+        [self, key, pending, reused](
+            const HttpClientPtr& client, int32_t errorCode) {
+
+        self->onResponse(key, client, errorCode, pending, reused);
+    }, option);
+
+    if (result)
+    {
+        ++origin.activeCount;
+    }
+
+    return result;
+}
+
+void HttpClientPool::release(
+    const std::string& key, const HttpClientPtr& client)
+{
+    Origin& origin = mOrigins[key];
+
+    // a redirect may have moved the connection to another origin
+    bool reusable =
+        !client->isClosed() && (makeKey(client->getUrl()) == key);
+
+    if (!reusable)
+    {
+        client->close();
+
+        if (!origin.pendings.empty() &&
+            (origin.activeCount < mOption.maxConnections))
+        {
+            PendingPtr pending = origin.pendings.front();
+            origin.pendings.pop_front();
+
+            HttpClientPtr next = HttpClient::newInstance(mNetWorker);
+
+            if (!send(key, next, pending, false))
+            {
+                fail(next, pending, -8901);
+            }
+        }
+
+        return;
+    }
+
+    if (!origin.pendings.empty())
+    {
+        // send the next one over the warm connection
+        PendingPtr pending = origin.pendings.front();
+        origin.pendings.pop_front();
+
+        if (send(key, client, pending, true))
+        {
+            return;
+        }
+
+        fail(client, pending, -8901);
+    }
+
+    if (origin.idles.size() >= mOption.maxIdleConnections)
+    {
+        client->close();
+        return;
+    }
+
+    Idle idle;
+    idle.client = client;
+    idle.timer = std::make_shared<Timer>();
+
+    const HttpClient* target = client.get();
+
+    idle.timer->start(mOption.idleTimeout, false,
+        [this, key, target](Timer*) {
+
+        onIdleTimeout(key, target);
+    });
+
+    origin.idles.push_front(std::move(idle));
+}
+
+void HttpClientPool::fail(
+    const HttpClientPtr& client,
+    const PendingPtr& pending,
+    int32_t errorCode)
+{
+    if (pending->responseHandler == nullptr)
+    {
+        return;
+    }
+
+    HttpResponseHandler handler = pending->responseHandler;
+
+    mNetWorker->postTask([client, handler, errorCode]() {
+        handler(client, errorCode);
+    });
+}
+
+void HttpClientPool::onResponse(
+    const std::string& key,
+    const HttpClientPtr& client,
+    int32_t errorCode,
+    const PendingPtr& pending,
+    bool reused)
+{
+    Origin& origin = mOrigins[key];
+    --origin.activeCount;
+
+    if ((errorCode != 0) && reused && !pending->retried &&
+        client->getResponse().isEmpty())
+    {
+        // the server closed the idle connection meanwhile
+        pending->retried = true;
+
+        if (send(key, HttpClient::newInstance(mNetWorker), pending, false))
+        {
+            return;
+        }
+    }
+
+    if (pending->responseHandler != nullptr)
+    {
+        ++origin.releasingCount;
+        pending->responseHandler(client, errorCode);
+        --origin.releasingCount;
+    }
+
+    release(key, client);
+}
+
+void HttpClientPool::onIdleTimeout(
+    const std::string& key, const HttpClient* client)
+{
+    Origin& origin = mOrigins[key];
+
+    for (auto it = origin.idles.begin(); it != origin.idles.end(); ++it)
+    {
+        if (it->client.get() == client)
+        {
+            it->client->close();
+            origin.idles.erase(it);
+            break;
+        }
+    }
+}
+
+SEV_NS_END
+
+#endif // SUBEVENT_HTTP_CLIENT_POOL_INL
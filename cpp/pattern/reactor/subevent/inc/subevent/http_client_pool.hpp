@@ -0,0 +1,163 @@
+#ifndef SUBEVENT_HTTP_CLIENT_POOL_HPP
+#define SUBEVENT_HTTP_CLIENT_POOL_HPP
+
+#include <map>
+#include <list>
+#include <string>
+#include <memory>
+
+#include <subevent/std.hpp>
+#include <subevent/timer.hpp>
+#include <subevent/http.hpp>
+#include <subevent/http_client.hpp>
+#include <subevent/ssl_socket.hpp>
+
+SEV_NS_BEGIN
+
+class NetWorker;
+class HttpClientPool;
+
+typedef std::shared_ptr<HttpClientPool> HttpClientPoolPtr;
+
+//----------------------------------------------------------------------------//
+// HttpClientPool
+//----------------------------------------------------------------------------//
+
+// Keeps the connections to each origin (scheme, host and port) open
+// between requests. Requests over the connection limit wait and are sent
+// over the first connection that becomes free. The client passed to the
+// response handler goes back to the pool when the handler returns.
+// Use it on the thread of the NetWorker.
+class HttpClientPool : public std::enable_shared_from_this<HttpClientPool>
+{
+public:
+    SEV_DECL static HttpClientPoolPtr newInstance(NetWorker* netWorker)
+    {
+        return HttpClientPoolPtr(new HttpClientPool(netWorker));
+    }
+
+    SEV_DECL ~HttpClientPool();
+
+    struct Option
+    {
+        SEV_DECL Option()
+        {
+            clear();
+        }
+
+        SEV_DECL void clear()
+        {
+            maxConnections = 6;
+            maxIdleConnections = 6;
+            idleTimeout = 30 * 1000;
+        }
+
+        // per origin
+        uint32_t maxConnections;
+        uint32_t maxIdleConnections;
+
+        // msec
+        uint32_t idleTimeout;
+    };
+
+public:
+    SEV_DECL bool request(
+        const std::string& url,
+        const HttpRequest& req,
+        const HttpResponseHandler& responseHandler,
+        const HttpClient::RequestOption& option =
+            HttpClient::RequestOption());
+
+    SEV_DECL void closeIdleConnections();
+
+public:
+    SEV_DECL Option& getOption()
+    {
+        return mOption;
+    }
+
+    SEV_DECL const Option& getOption() const
+    {
+        return mOption;
+    }
+
+    SEV_DECL size_t getIdleCount() const;
+
+private:
+    struct Pending
+    {
+        std::string url;
+        HttpRequest request;
+        HttpResponseHandler responseHandler;
+        HttpClient::RequestOption option;
+        bool retried;
+    };
+
+    typedef std::shared_ptr<Pending> PendingPtr;
+
+    struct Idle
+    {
+        HttpClientPtr client;
+        std::shared_ptr<Timer> timer;
+    };
+
+    struct Origin
+    {
+        SEV_DECL Origin()
+        {
+            activeCount = 0;
+            releasingCount = 0;
+        }
+
+        uint32_t activeCount;
+
+        // in the response handler, released after it
+        uint32_t releasingCount;
+
+        std::list<Idle> idles;
+        std::list<PendingPtr> pendings;
+#ifdef SEV_SUPPORTS_SSL
+        SslSessionPtr sslSession;
+#endif
+    };
+
+    SEV_DECL HttpClientPool(NetWorker* netWorker);
+
+    SEV_DECL static std::string makeKey(const HttpUrl& url);
+
+    SEV_DECL bool dispatch(
+        const std::string& key, const PendingPtr& pending);
+    SEV_DECL bool send(
+        const std::string& key,
+        const HttpClientPtr& client,
+        const PendingPtr& pending,
+        bool reused);
+    SEV_DECL void release(
+        const std::string& key, const HttpClientPtr& client);
+    SEV_DECL void fail(
+        const HttpClientPtr& client,
+        const PendingPtr& pending,
+        int32_t errorCode);
+
+    SEV_DECL void onResponse(
+        const std::string& key,
+        const HttpClientPtr& client,
+        int32_t errorCode,
+        const PendingPtr& pending,
+        bool reused);
+    SEV_DECL void onIdleTimeout(
+        const std::string& key, const HttpClient* client);
+
+    HttpClientPool() = delete;
+    HttpClientPool(const HttpClientPool&) = delete;
+    HttpClientPool& operator=(const HttpClientPool&) = delete;
+
+private:
+    NetWorker* mNetWorker;
+    Option mOption;
+    std::map<std::string, Origin> mOrigins;
+};
+
+SEV_NS_END
+
+#endif // SUBEVENT_HTTP_CLIENT_POOL_HPP
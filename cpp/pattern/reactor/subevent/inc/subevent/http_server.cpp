@@ -161,46 +161,84 @@ void HttpChannel::close()
 
 void HttpChannel::onTcpReceive(const TcpChannelPtr& channel)
 {
-    auto request = channel->receiveAll();
-
-    if (request.empty())
+    if (mReceiveBuffer.capacity() == 0)
     {
-        return;
+        mReceiveBuffer =
+            mNetWorker->getReceiveBufferPool().acquire();
     }
 
-    if (!mRequestTempBuffer.empty())
+    // after the incomplete header of the previous one
+    if (channel->receiveAll(mReceiveBuffer) == 0)
     {
-        std::copy(
-            request.begin(),
-            request.end(),
-            std::back_inserter(mRequestTempBuffer));
+        if (mReceiveBuffer.empty())
+        {
+            releaseReceiveBuffer();
+        }
 
-        request = std::move(mRequestTempBuffer);
+        return;
     }
 
-    StringReader reader(request);
+    StringReader reader(mReceiveBuffer);
 
-    if (!onHttpRequest(reader))
+    // pipelined requests
+    while (!reader.isEnd() && !isClosed() && (mWsChannel == nullptr))
     {
-        // header is not completed
-        mRequestTempBuffer = std::move(request);
+        size_t cur = reader.getCur();
+
+        if (!onHttpRequest(reader))
+        {
+            // header is not completed, keep it only
+            size_t start = mRequestParser.getStart();
+
+            if (start > 0)
+            {
+                mReceiveBuffer.erase(
+                    mReceiveBuffer.begin(),
+                    mReceiveBuffer.begin() + start);
+                mRequestParser.shift(start);
+            }
+
+            return;
+        }
+
+        if (reader.getCur() == cur)
+        {
+            break;
+        }
     }
+
+    releaseReceiveBuffer();
 }
 
 bool HttpChannel::onHttpRequest(StringReader& reader)
 {
     // header
-    if (mRequest.isEmpty())
+    if (!mRequestParser.isCompleted())
     {
-        try
+        const std::vector<char>& buff = reader.getBuffer();
+
+        HttpRequestParser::Result result =
+            mRequestParser.parse(buff.data(), buff.size());
+
+        if (result == HttpRequestParser::Result::Incomplete)
         {
-            if (!mRequest.deserializeMessage(reader))
-            {
-                // not completed
-                mRequest.clear();
-                return false;
-            }
+            return false;
+        }
+
+        if (result == HttpRequestParser::Result::Invalid)
+        {
+            close();
+            return true;
+        }
+
+        mRequestParser.materialize(buff.data(), mRequest);
+        reader.setCur(mRequestParser.getEnd());
+
+        // previous request on a kept-alive connection
+        mContentReceiver.clear();
 
+        try
+        {
             if (!mContentReceiver.init(mRequest))
             {
                 // too much data
@@ -227,12 +265,28 @@ bool HttpChannel::onHttpRequest(StringReader& reader)
     {
         mRequest.setBody(mContentReceiver.getData());
 
+        // the next one follows in the buffer
+        mRequestParser.reset(reader.getCur());
+
         onRequestCompleted();
     }
 
     return true;
 }
 
+void HttpChannel::releaseReceiveBuffer()
+{
+    mNetWorker->getReceiveBufferPool().release(
+        std::move(mReceiveBuffer));
+    mReceiveBuffer.clear();
+
+    if (!mRequestParser.isCompleted())
+    {
+        // the next one starts at the top of the next buffer
+        mRequestParser.reset();
+    }
+}
+
 bool HttpChannel::isRequestCompleted() const
 {
     if (mRequest.isEmpty())
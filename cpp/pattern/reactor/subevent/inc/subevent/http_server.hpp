@@ -129,14 +129,18 @@ private:
     SEV_DECL bool isRequestCompleted() const;
     SEV_DECL bool onHttpRequest(StringReader& reader);
     SEV_DECL void onRequestCompleted();
+    SEV_DECL void releaseReceiveBuffer();
 
     HttpChannel() = delete;
     HttpChannel(const HttpChannel&) = delete;
     HttpChannel& operator=(const HttpChannel&) = delete;
 
     HttpRequest mRequest;
+    HttpRequestParser mRequestParser;
     HttpContentReceiver mContentReceiver;
-    std::vector<char> mRequestTempBuffer;
+
+    // from the pool of the worker while a request is incomplete
+    std::vector<char> mReceiveBuffer;
     HttpRequestHandler mRequestHandler;
     WsChannelPtr mWsChannel;
 
@@ -15,33 +15,27 @@ HttpChannelWorker::HttpChannelWorker(Thread* thread)
 {
     mHandlerMap.setDefaultHandler(
         SEV_BIND_1(this, HttpChannelWorker::onHttpRequest));
+}
 
-    mThread->setEventHandler(
-        TcpEventId::Accept, [&](const Event* event) {
-
-        TcpChannelPtr newChannel = TcpServer::accept(event);
+HttpChannelWorker::~HttpChannelWorker()
+{
+}
 
-        if (newChannel != nullptr)
-        {
-            newChannel->setCloseHandler(
-                [&](const TcpChannelPtr& channel) {
+void HttpChannelWorker::initChannel(const TcpChannelPtr& newChannel)
+{
+    newChannel->setCloseHandler(
+        [&](const TcpChannelPtr& channel) {
 
-                onClose(channel);
-            });
+        onClose(channel);
+    });
 
-            HttpChannelPtr httpChannel =
-                std::dynamic_pointer_cast<HttpChannel>(newChannel);
+    HttpChannelPtr httpChannel =
+        std::dynamic_pointer_cast<HttpChannel>(newChannel);
 
-            httpChannel->setRequestHandler(
-                SEV_BIND_1(this, HttpChannelWorker::onRequest));
+    httpChannel->setRequestHandler(
+        SEV_BIND_1(this, HttpChannelWorker::onRequest));
 
-            onAccept(newChannel);
-        }
-    });
-}
-
-HttpChannelWorker::~HttpChannelWorker()
-{
+    onAccept(newChannel);
 }
 
 void HttpChannelWorker::setRequestHandler(
@@ -90,6 +84,17 @@ bool HttpServerWorker::open(
 #endif
     int32_t listenBacklog)
 {
+#ifdef SEV_SUPPORTS_SSL
+    mSslContext = sslCtx;
+#endif
+
+    if (getAcceptMode() == AcceptMode::ReusePort)
+    {
+        createTcpServer();
+
+        return openWorkers(localEndPoint, listenBacklog);
+    }
+
     HttpServerPtr httpServer =
         std::dynamic_pointer_cast<HttpServer>(getTcpServer());
 
@@ -104,6 +109,24 @@ bool HttpServerWorker::open(
     return result;
 }
 
+bool HttpServerWorker::openWorkerServer(
+    const TcpServerPtr& server,
+    const IpEndPoint& localEndPoint,
+    const TcpAcceptHandler& acceptHandler,
+    int32_t listenBacklog)
+{
+    HttpServerPtr httpServer =
+        std::dynamic_pointer_cast<HttpServer>(server);
+
+    return httpServer->open(
+        localEndPoint,
+#ifdef SEV_SUPPORTS_SSL
+        mSslContext,
+#endif
+        acceptHandler,
+        listenBacklog);
+}
+
 SEV_NS_END
 
 #endif // SUBEVENT_HTTP_SERVER_WORKER_INL
@@ -32,6 +32,8 @@ protected:
 protected:
     SEV_DECL HttpChannelWorker(Thread* thread);
 
+    SEV_DECL void initChannel(const TcpChannelPtr& channel) override;
+
     SEV_DECL void onRequest(
         const HttpChannelPtr& httpChannel);
 
@@ -78,8 +80,24 @@ protected:
         }
     }
 
+    SEV_DECL TcpServerPtr createWorkerServer(
+        TcpChannelWorker* worker) override
+    {
+        return HttpServer::newInstance(worker);
+    }
+
+    SEV_DECL bool openWorkerServer(
+        const TcpServerPtr& server,
+        const IpEndPoint& localEndPoint,
+        const TcpAcceptHandler& acceptHandler,
+        int32_t listenBacklog) override;
+
 private:
     HttpServerWorker() = delete;
+
+#ifdef SEV_SUPPORTS_SSL
+    SslContextPtr mSslContext;
+#endif
 };
 
 //---------------------------------------------------------------------------//
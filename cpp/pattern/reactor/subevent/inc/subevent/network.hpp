@@ -2,6 +2,8 @@
 #define SUBEVENT_NETWORK_HPP
 
 #include <string>
+#include <vector>
+#include <utility>
 
 #include <subevent/std.hpp>
 #include <subevent/thread.hpp>
@@ -26,6 +28,54 @@ private:
     int32_t mErrorCode;
 };
 
+//---------------------------------------------------------------------------//
+// ReceiveBufferPool
+//---------------------------------------------------------------------------//
+
+// Keeps released receive buffers with their capacity for the next
+// readable event. Use it on the thread of the NetWorker.
+class ReceiveBufferPool
+{
+public:
+    static const size_t MaxBuffers = 64;
+    static const size_t MaxBufferSize = 1024 * 1024;
+
+    SEV_DECL std::vector<char> acquire()
+    {
+        if (mBuffers.empty())
+        {
+            return std::vector<char>();
+        }
+
+        std::vector<char> buff = std::move(mBuffers.back());
+        mBuffers.pop_back();
+
+        return buff;
+    }
+
+    SEV_DECL void release(std::vector<char> buff)
+    {
+        // large ones go back to the heap
+        if ((buff.capacity() == 0) ||
+            (buff.capacity() > MaxBufferSize) ||
+            (mBuffers.size() >= MaxBuffers))
+        {
+            return;
+        }
+
+        buff.clear();
+        mBuffers.push_back(std::move(buff));
+    }
+
+    SEV_DECL size_t getCount() const
+    {
+        return mBuffers.size();
+    }
+
+private:
+    std::vector<std::vector<char>> mBuffers;
+};
+
 //---------------------------------------------------------------------------//
 // NetWorker
 //---------------------------------------------------------------------------//
@@ -72,11 +122,17 @@ public:
         return mThread;
     }
 
+    SEV_DECL ReceiveBufferPool& getReceiveBufferPool()
+    {
+        return mReceiveBufferPool;
+    }
+
 protected:
     SEV_DECL NetWorker(Thread* thread);
     SEV_DECL virtual ~NetWorker();
 
     Thread* mThread;
+    ReceiveBufferPool mReceiveBufferPool;
 
 private:
     NetWorker() = delete;
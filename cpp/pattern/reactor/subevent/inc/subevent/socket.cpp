@@ -13,6 +13,10 @@
 #include <arpa/inet.h>
 #endif
 
+#ifdef SEV_OS_LINUX
+#include <sys/sendfile.h>
+#endif
+
 SEV_NS_BEGIN
 
 //---------------------------------------------------------------------------//
@@ -33,11 +37,17 @@ SocketOption::SocketOption(Socket* socket)
 
 SocketOption::SocketOption(const SocketOption& other)
 {
+    mSocket = nullptr;
+    mStore = nullptr;
+
     operator=(other);
 }
 
 SocketOption::SocketOption(SocketOption&& other)
 {
+    mSocket = nullptr;
+    mStore = nullptr;
+
     operator=(other);
 }
 
@@ -161,6 +171,38 @@ bool SocketOption::getReuseAddress(bool& on) const
     return true;
 }
 
+void SocketOption::setReusePort(bool on)
+{
+#ifdef SO_REUSEPORT
+    int32_t value = (on ? 1 : 0);
+
+    setOption(SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value));
+#else
+    (void)on;
+#endif
+}
+
+bool SocketOption::getReusePort(bool& on) const
+{
+#ifdef SO_REUSEPORT
+    int32_t value;
+    socklen_t size = sizeof(value);
+
+    if (!getOption(SOL_SOCKET, SO_REUSEPORT, &value, &size))
+    {
+        return false;
+    }
+
+    on = (value == 0 ? false : true);
+
+    return true;
+#else
+    (void)on;
+
+    return false;
+#endif
+}
+
 void SocketOption::setKeepAlive(bool on)
 {
     int32_t value = (on ? 1 : 0);
@@ -644,6 +686,63 @@ int32_t Socket::send(const void* data, uint32_t size, int32_t flags)
     return result;
 }
 
+int32_t Socket::sendv(
+    const IoVector* vectors, uint32_t count, int32_t flags)
+{
+#ifdef SEV_OS_WIN
+    DWORD sent = 0;
+
+    int result = ::WSASend(getHandle(),
+        const_cast<IoVector*>(vectors), count,
+        &sent, static_cast<DWORD>(flags), nullptr, nullptr);
+
+    mErrorCode = Socket::getLastError();
+
+    return (result == 0) ? static_cast<int32_t>(sent) : -1;
+#else
+    struct msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = const_cast<IoVector*>(vectors);
+    message.msg_iovlen = count;
+
+    int32_t result = static_cast<int32_t>(
+        ::sendmsg(getHandle(), &message, flags));
+
+    mErrorCode = Socket::getLastError();
+
+    return result;
+#endif
+}
+
+bool Socket::isSendFileSupported() const
+{
+#ifdef SEV_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+int32_t Socket::sendFile(std::FILE* file, uint64_t offset, uint32_t size)
+{
+#ifdef SEV_OS_LINUX
+    off_t fileOffset = static_cast<off_t>(offset);
+
+    int32_t result = static_cast<int32_t>(
+        ::sendfile(getHandle(), fileno(file), &fileOffset, size));
+
+    mErrorCode = Socket::getLastError();
+
+    return result;
+#else
+    (void)file;
+    (void)offset;
+    (void)size;
+
+    return -1;
+#endif
+}
+
 int32_t Socket::receive(void* buff, uint32_t size, int32_t flags)
 {
     int32_t result = static_cast<int32_t>(
@@ -768,6 +867,11 @@ bool Socket::onConnect()
     return true;
 }
 
+bool Socket::hasPendingData() const
+{
+    return false;
+}
+
 int Socket::getLastError()
 {
 #ifdef SEV_OS_WIN
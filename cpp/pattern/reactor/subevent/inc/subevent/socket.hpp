@@ -6,6 +6,8 @@
 #include <vector>
 #include <string>
 #include <atomic>
+#include <cstdio>
+#include <climits>
 
 #include <subevent/std.hpp>
 
@@ -15,6 +17,7 @@
 #include <windows.h>
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #endif
 
@@ -47,6 +50,7 @@ public:
 
 public:
     SEV_DECL void setReuseAddress(bool on);
+    SEV_DECL void setReusePort(bool on);
     SEV_DECL void setKeepAlive(bool on);
     SEV_DECL void setLinger(bool on, uint16_t sec);
     SEV_DECL void setReceiveBuffSize(uint32_t buffSize);
@@ -56,6 +60,7 @@ public:
     SEV_DECL void setBroadcast(bool on);
 
     SEV_DECL bool getReuseAddress(bool& on) const;
+    SEV_DECL bool getReusePort(bool& on) const;
     SEV_DECL bool getKeepAlive(bool& on) const;
     SEV_DECL bool getLinger(bool& on, uint16_t& sec) const;
     SEV_DECL bool getReceiveBuffSize(uint32_t& buffSize) const;
@@ -118,6 +123,31 @@ public:
     static const int32_t SendFlags = MSG_NOSIGNAL;
 #endif
 
+    // one buffer of a gather send
+#ifdef SEV_OS_WIN
+    typedef WSABUF IoVector;
+    static const uint32_t MaxIoVectors = 64;
+#else
+    typedef struct iovec IoVector;
+#ifdef IOV_MAX
+    static const uint32_t MaxIoVectors = IOV_MAX;
+#else
+    static const uint32_t MaxIoVectors = 16;
+#endif
+#endif
+
+    SEV_DECL static void setIoVector(
+        IoVector& vector, const void* data, uint32_t size)
+    {
+#ifdef SEV_OS_WIN
+        vector.buf = static_cast<CHAR*>(const_cast<void*>(data));
+        vector.len = size;
+#else
+        vector.iov_base = const_cast<void*>(data);
+        vector.iov_len = size;
+#endif
+    }
+
     SEV_DECL Socket(Handle handle = InvalidHandle);
     SEV_DECL virtual ~Socket();
 
@@ -157,6 +187,18 @@ public:
         void* buff, uint32_t size, int32_t flags = 0);
     SEV_DECL virtual void close();
 
+    // gather send, returns the total size sent
+    SEV_DECL virtual int32_t sendv(
+        const IoVector* vectors, uint32_t count, int32_t flags = 0);
+
+    // from the file to the socket in the kernel
+    SEV_DECL virtual bool isSendFileSupported() const;
+    SEV_DECL virtual int32_t sendFile(
+        std::FILE* file, uint64_t offset, uint32_t size);
+
+    // received data kept above the kernel
+    SEV_DECL virtual bool hasPendingData() const;
+
 public:
     SEV_DECL bool getLocalEndPoint(IpEndPoint& localEndPoint) const;
     SEV_DECL bool getPeerEndPoint(IpEndPoint& peerEndPoint) const;
@@ -237,50 +237,197 @@ bool SocketController::tryTcpConnect(TcpClientItem& item)
 void SocketController::tryTcpSend(TcpChannelItem& item)
 {
     while (!item.sendBuffer.empty())
+    {
+        bool sent;
+
+        if (item.sendBuffer.front().file != nullptr)
+        {
+            sent = sendTcpFile(item);
+        }
+        else
+        {
+            sent = sendTcpBuffers(item);
+        }
+
+        if (!sent)
+        {
+            break;
+        }
+    }
+}
+
+bool SocketController::sendTcpBuffers(TcpChannelItem& item)
+{
+    Socket::IoVector vectors[Socket::MaxIoVectors];
+    uint32_t count = 0;
+    size_t total = 0;
+
+    // gather the queued buffers up to the next file
+    for (const auto& sendData : item.sendBuffer)
+    {
+        if ((sendData.file != nullptr) ||
+            (count == Socket::MaxIoVectors))
+        {
+            break;
+        }
+
+        size_t size = sendData.size - sendData.index;
+
+        if ((count > 0) && (total + size > INT32_MAX))
+        {
+            break;
+        }
+
+        Socket::setIoVector(vectors[count],
+            sendData.getData() + sendData.index,
+            static_cast<uint32_t>(size));
+
+        ++count;
+        total += size;
+    }
+
+    Socket* socket = item.tcpChannel->mSocket;
+
+    // send
+    int32_t result = socket->sendv(vectors, count, Socket::SendFlags);
+
+    if (result < 0)
+    {
+        return onTcpSendError(item);
+    }
+
+    size_t sent = static_cast<size_t>(result);
+
+    for (uint32_t i = 0; i < count; ++i)
     {
         TcpChannelItem::SendData& sendData =
             item.sendBuffer.front();
 
-        size_t size = sendData.buff.size() - sendData.index;
-        Socket* socket = item.tcpChannel->mSocket;
-
-        // send
-        int32_t result = socket->send(
-            &sendData.buff[sendData.index],
-            static_cast<uint32_t>(size), Socket::SendFlags);
+        size_t size = sendData.size - sendData.index;
 
-        if (result >= 0)
+        if (sent < size)
         {
-            sendData.index += static_cast<size_t>(result);
+            sendData.index += sent;
+            break;
+        }
 
-            if (sendData.index == sendData.buff.size())
-            {
-                // success
-                item.tcpChannel->onSend(0);
-            }
-            else
-            {
-                break;
-            }
+        // success
+        sent -= size;
+        item.tcpChannel->onSend(0);
+        item.sendBuffer.pop_front();
+    }
+
+    return (static_cast<size_t>(result) == total);
+}
+
+bool SocketController::sendTcpFile(TcpChannelItem& item)
+{
+    TcpChannelItem::SendData& sendData =
+        item.sendBuffer.front();
+
+    if (sendData.fileIndex == sendData.fileSize)
+    {
+        // empty
+        item.tcpChannel->onSend(0);
+        item.sendBuffer.pop_front();
+        return true;
+    }
+
+    Socket* socket = item.tcpChannel->mSocket;
+
+    static const uint32_t chunkSize = 64 * 1024;
+
+    uint64_t rest = sendData.fileSize - sendData.fileIndex;
+    uint32_t size = (rest < INT32_MAX) ?
+        static_cast<uint32_t>(rest) : INT32_MAX;
+
+    int32_t result;
+
+    if (socket->isSendFileSupported())
+    {
+        result = socket->sendFile(
+            sendData.file.get(), sendData.fileIndex, size);
+
+        if (result == 0)
+        {
+            // truncated while sending
+            item.tcpChannel->onSend(-5212);
+            item.sendBuffer.pop_front();
+            return true;
         }
-        else
+    }
+    else
+    {
+        if (sendData.index == sendData.size)
         {
-            if (socket->isBlockingError())
+            // read the next chunk
+            if (sendData.buff.empty())
             {
-                // blocking
-                item.sendBlocked = true;
-                break;
+                sendData.buff.resize(chunkSize);
             }
-            else
+
+            size_t readSize = std::fread(
+                sendData.buff.data(), 1,
+                (size < chunkSize) ? size : chunkSize,
+                sendData.file.get());
+
+            if (readSize == 0)
             {
-                // error
-                item.tcpChannel->onSend(
-                    socket->getErrorCode());
+                item.tcpChannel->onSend(-5212);
+                item.sendBuffer.pop_front();
+                return true;
             }
+
+            sendData.size = readSize;
+            sendData.index = 0;
+        }
+
+        size = static_cast<uint32_t>(sendData.size - sendData.index);
+
+        result = socket->send(
+            sendData.buff.data() + sendData.index,
+            size, Socket::SendFlags);
+
+        if (result > 0)
+        {
+            sendData.index += static_cast<size_t>(result);
         }
+    }
+
+    if (result < 0)
+    {
+        return onTcpSendError(item);
+    }
 
+    sendData.fileIndex += static_cast<uint64_t>(result);
+
+    if (sendData.fileIndex == sendData.fileSize)
+    {
+        // success
+        item.tcpChannel->onSend(0);
         item.sendBuffer.pop_front();
+        return true;
     }
+
+    return (static_cast<uint32_t>(result) == size);
+}
+
+bool SocketController::onTcpSendError(TcpChannelItem& item)
+{
+    Socket* socket = item.tcpChannel->mSocket;
+
+    if (socket->isBlockingError())
+    {
+        // blocking
+        item.sendBlocked = true;
+        return false;
+    }
+
+    // error
+    item.tcpChannel->onSend(socket->getErrorCode());
+    item.sendBuffer.pop_front();
+
+    return true;
 }
 
 void SocketController::startTcpChannelCloseTimer(TcpChannelItem& item)
@@ -668,6 +815,42 @@ bool SocketController::cancelTcpConnect(const TcpClientPtr& tcpClient)
 bool SocketController::requestTcpSend(
     const TcpChannelPtr& tcpChannel,
     std::vector<char>&& data)
+{
+    TcpChannelItem::SendData sendData;
+    sendData.size = data.size();
+    sendData.buff = std::move(data);
+
+    return requestTcpSend(tcpChannel, std::move(sendData));
+}
+
+bool SocketController::requestTcpSend(
+    const TcpChannelPtr& tcpChannel,
+    const std::shared_ptr<const void>& owner,
+    const void* data, size_t size)
+{
+    TcpChannelItem::SendData sendData;
+    sendData.owner = owner;
+    sendData.data = static_cast<const char*>(data);
+    sendData.size = size;
+
+    return requestTcpSend(tcpChannel, std::move(sendData));
+}
+
+bool SocketController::requestTcpSend(
+    const TcpChannelPtr& tcpChannel,
+    const std::shared_ptr<std::FILE>& file,
+    uint64_t fileSize)
+{
+    TcpChannelItem::SendData sendData;
+    sendData.file = file;
+    sendData.fileSize = fileSize;
+
+    return requestTcpSend(tcpChannel, std::move(sendData));
+}
+
+bool SocketController::requestTcpSend(
+    const TcpChannelPtr& tcpChannel,
+    TcpChannelItem::SendData&& sendData)
 {
     Socket::Handle sockHandle =
         tcpChannel->mSocket->getHandle();
@@ -680,9 +863,6 @@ bool SocketController::requestTcpSend(
 
     TcpChannelItem& item = it->second;
 
-    TcpChannelItem::SendData sendData;
-    sendData.buff = std::move(data);
-    sendData.index = 0;
     item.sendBuffer.push_back(std::move(sendData));
 
     if (!item.sendBlocked)
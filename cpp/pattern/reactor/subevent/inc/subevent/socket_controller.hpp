@@ -4,6 +4,8 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <memory>
+#include <cstdio>
 
 #include <subevent/std.hpp>
 #include <subevent/event_controller.hpp>
@@ -48,6 +50,14 @@ public:
     SEV_DECL bool requestTcpSend(
         const TcpChannelPtr& tcpChannel,
         std::vector<char>&& data);
+    SEV_DECL bool requestTcpSend(
+        const TcpChannelPtr& tcpChannel,
+        const std::shared_ptr<const void>& owner,
+        const void* data, size_t size);
+    SEV_DECL bool requestTcpSend(
+        const TcpChannelPtr& tcpChannel,
+        const std::shared_ptr<std::FILE>& file,
+        uint64_t fileSize);
     SEV_DECL bool cancelTcpSend(const TcpChannelPtr& tcpChannel);
 
     SEV_DECL void requestTcpChannelClose(const TcpChannelPtr& tcpChannel);
@@ -118,8 +128,31 @@ private:
 
         struct SendData
         {
+            SEV_DECL SendData()
+            {
+                data = nullptr;
+                size = 0;
+                index = 0;
+                fileSize = 0;
+                fileIndex = 0;
+            }
+
+            SEV_DECL const char* getData() const
+            {
+                return (data != nullptr) ? data : buff.data();
+            }
+
+            // copied, or kept alive by the owner (none for static data)
             std::vector<char> buff;
+            std::shared_ptr<const void> owner;
+            const char* data;
+            size_t size;
             size_t index;
+
+            // buff is the read buffer without sendfile
+            std::shared_ptr<std::FILE> file;
+            uint64_t fileSize;
+            uint64_t fileIndex;
         };
 
         std::list<SendData> sendBuffer;
@@ -134,7 +167,13 @@ private:
     };
 
     SEV_DECL bool tryTcpConnect(TcpClientItem& item);
+    SEV_DECL bool requestTcpSend(
+        const TcpChannelPtr& tcpChannel,
+        TcpChannelItem::SendData&& sendData);
     SEV_DECL void tryTcpSend(TcpChannelItem& item);
+    SEV_DECL bool sendTcpBuffers(TcpChannelItem& item);
+    SEV_DECL bool sendTcpFile(TcpChannelItem& item);
+    SEV_DECL bool onTcpSendError(TcpChannelItem& item);
     SEV_DECL void startTcpChannelCloseTimer(TcpChannelItem& item);
 
     std::map<Socket::Handle, TcpServerItem> mTcpServers;
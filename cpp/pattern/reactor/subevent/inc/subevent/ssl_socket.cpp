@@ -100,6 +100,30 @@ void SslContext::setVerifyDepth(int depth)
     SSL_CTX_set_verify_depth(mHandle, depth);
 }
 
+//----------------------------------------------------------------------------//
+// SslSession
+//----------------------------------------------------------------------------//
+
+SslSession::SslSession()
+{
+    mHandle = nullptr;
+}
+
+SslSession::~SslSession()
+{
+    setHandle(nullptr);
+}
+
+void SslSession::setHandle(SSL_SESSION* handle)
+{
+    if (mHandle != nullptr)
+    {
+        SSL_SESSION_free(mHandle);
+    }
+
+    mHandle = handle;
+}
+
 //----------------------------------------------------------------------------//
 // SecureSocket
 //----------------------------------------------------------------------------//
@@ -115,6 +139,8 @@ SecureSocket::SecureSocket(const SslContextPtr& sslCtx, Handle handle)
 
 SecureSocket::~SecureSocket()
 {
+    // the base destructor doesn't reach this close()
+    close();
 }
 
 Socket* SecureSocket::accept()
@@ -143,6 +169,36 @@ int32_t SecureSocket::send(
     return result;
 }
 
+int32_t SecureSocket::sendv(
+    const IoVector* vectors, uint32_t count, int32_t flags)
+{
+    int32_t total = 0;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+#ifdef SEV_OS_WIN
+        int32_t result = send(vectors[i].buf, vectors[i].len, flags);
+#else
+        int32_t result = send(vectors[i].iov_base,
+            static_cast<uint32_t>(vectors[i].iov_len), flags);
+#endif
+        if (result <= 0)
+        {
+            // retried from this buffer, as SSL_write requires
+            return (total > 0) ? total : result;
+        }
+
+        total += result;
+    }
+
+    return total;
+}
+
+bool SecureSocket::isSendFileSupported() const
+{
+    return false;
+}
+
 int32_t SecureSocket::receive(
     void* buff, uint32_t size, int32_t flags)
 {
@@ -176,6 +232,9 @@ void SecureSocket::close()
 {
     if (mSsl != nullptr)
     {
+        // TLS 1.3 tickets arrive after the handshake
+        saveSession();
+
         SSL_shutdown(mSsl);
 
         SSL_free(mSsl);
@@ -185,6 +244,16 @@ void SecureSocket::close()
     Socket::close();
 }
 
+bool SecureSocket::hasPendingData() const
+{
+    if (mSsl == nullptr)
+    {
+        return false;
+    }
+
+    return (SSL_pending(mSsl) > 0);
+}
+
 bool SecureSocket::onAccept()
 {
     mSsl = SSL_new(mSslCtx->getHandle());
@@ -216,6 +285,12 @@ bool SecureSocket::onConnect()
     {
         return false;
     }
+
+    if ((mSession != nullptr) && (mSession->getHandle() != nullptr))
+    {
+        // resume
+        SSL_set_session(mSsl, mSession->getHandle());
+    }
     
     int result = SSL_connect(mSsl);
 
@@ -226,9 +301,34 @@ bool SecureSocket::onConnect()
         return false;
     }
 
+    saveSession();
+
     return true;
 }
 
+void SecureSocket::saveSession()
+{
+    if (mSession == nullptr)
+    {
+        return;
+    }
+
+    SSL_SESSION* session = SSL_get1_session(mSsl);
+
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    if (SSL_SESSION_is_resumable(session) != 1)
+    {
+        SSL_SESSION_free(session);
+        return;
+    }
+
+    mSession->setHandle(session);
+}
+
 //---------------------------------------------------------------------------//
 // OpenSsl
 //---------------------------------------------------------------------------//
@@ -13,8 +13,10 @@
 SEV_NS_BEGIN
 
 class SslContext;
+class SslSession;
 
 typedef std::shared_ptr<SslContext> SslContextPtr;
+typedef std::shared_ptr<SslSession> SslSessionPtr;
 
 //---------------------------------------------------------------------------//
 // SslContext
@@ -65,6 +67,39 @@ private:
     SSL_CTX* mHandle;
 };
 
+//---------------------------------------------------------------------------//
+// SslSession
+//---------------------------------------------------------------------------//
+
+// Holds the session of a client connection, so that the next connection
+// to the same server resumes it instead of a full handshake.
+class SslSession
+{
+public:
+    SEV_DECL static SslSessionPtr newInstance()
+    {
+        return std::make_shared<SslSession>();
+    }
+
+    SEV_DECL SslSession();
+    SEV_DECL ~SslSession();
+
+public:
+    SEV_DECL SSL_SESSION* getHandle() const
+    {
+        return mHandle;
+    }
+
+    // takes the ownership
+    SEV_DECL void setHandle(SSL_SESSION* handle);
+
+private:
+    SslSession(const SslSession&) = delete;
+    SslSession& operator=(const SslSession&) = delete;
+
+    SSL_SESSION* mHandle;
+};
+
 //---------------------------------------------------------------------------//
 // SecureSocket
 //---------------------------------------------------------------------------//
@@ -86,15 +121,33 @@ public:
 
     SEV_DECL void close() override;
 
+    // records are written buffer by buffer
+    SEV_DECL int32_t sendv(const IoVector* vectors,
+        uint32_t count, int32_t flags = 0) override;
+
+    // the kernel cannot encrypt
+    SEV_DECL bool isSendFileSupported() const override;
+
+    SEV_DECL bool hasPendingData() const override;
+
 public:
     SEV_DECL bool onAccept() override;
     SEV_DECL bool onConnect() override;
 
+public:
+    SEV_DECL void setSession(const SslSessionPtr& session)
+    {
+        mSession = session;
+    }
+
 private:
     SecureSocket() = delete;
 
+    SEV_DECL void saveSession();
+
     SSL* mSsl;
     SslContextPtr mSslCtx;
+    SslSessionPtr mSession;
 };
 
 //---------------------------------------------------------------------------//
@@ -18,6 +18,7 @@
 #include <subevent/ssl_socket.hpp>
 #include <subevent/http.hpp>
 #include <subevent/http_client.hpp>
+#include <subevent/http_client_pool.hpp>
 #include <subevent/http_server.hpp>
 #include <subevent/http_server_worker.hpp>
 #include <subevent/ws.hpp>
@@ -26,6 +27,7 @@
 #include <subevent/ssl_socket.inl>
 #include <subevent/http.inl>
 #include <subevent/http_client.inl>
+#include <subevent/http_client_pool.inl>
 #include <subevent/http_server.inl>
 #include <subevent/http_server_worker.inl>
 #include <subevent/ws.inl>
@@ -2,6 +2,7 @@
 #define SUBEVENT_TCP_INL
 
 #include <cassert>
+#include <cstdio>
 
 #include <subevent/network.hpp>
 #include <subevent/tcp.hpp>
@@ -431,6 +432,111 @@ int32_t TcpChannel::send(
     return 0;
 }
 
+int32_t TcpChannel::send(
+    const std::shared_ptr<const void>& owner,
+    const void* data, size_t size,
+    const TcpSendHandler& sendHandler)
+{
+    assert(NetWorker::getCurrent() != nullptr);
+
+    if (isClosed())
+    {
+        return -1;
+    }
+
+    if (mNetWorker != NetWorker::getCurrent())
+    {
+        assert(false);
+        return -5260;
+    }
+
+    if (size > INT32_MAX)
+    {
+        return -5261;
+    }
+
+    if ((data == nullptr) && (size != 0))
+    {
+        return -5262;
+    }
+
+    if (sendHandler == nullptr)
+    {
+        return mSocket->send(
+            data, static_cast<int32_t>(size), Socket::SendFlags);
+    }
+    else
+    {
+        mSendHandlers.push_back(sendHandler);
+    }
+
+    if (!mNetWorker->getSocketController()->
+        requestTcpSend(shared_from_this(), owner, data, size))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t TcpChannel::sendFile(
+    const std::string& fileName,
+    const TcpSendHandler& sendHandler)
+{
+    assert(NetWorker::getCurrent() != nullptr);
+
+    if (isClosed())
+    {
+        return -1;
+    }
+
+    if (mNetWorker != NetWorker::getCurrent())
+    {
+        assert(false);
+        return -5270;
+    }
+
+    std::shared_ptr<std::FILE> file(
+        std::fopen(fileName.c_str(), "rb"),
+        [](std::FILE* fp) {
+            if (fp != nullptr)
+            {
+                std::fclose(fp);
+            }
+        });
+
+    if (file == nullptr)
+    {
+        return -5271;
+    }
+
+    if (std::fseek(file.get(), 0, SEEK_END) != 0)
+    {
+        return -5272;
+    }
+
+    long fileSize = std::ftell(file.get());
+
+    if ((fileSize < 0) ||
+        (std::fseek(file.get(), 0, SEEK_SET) != 0))
+    {
+        return -5272;
+    }
+
+    // keeps the handlers in step with the queue
+    mSendHandlers.push_back((sendHandler != nullptr) ? sendHandler :
+        [](const TcpChannelPtr&, int32_t) {});
+
+    if (!mNetWorker->getSocketController()->
+        requestTcpSend(shared_from_this(), file,
+            static_cast<uint64_t>(fileSize)))
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
 int32_t TcpChannel::receive(void* buff, size_t size)
 {
     assert(NetWorker::getCurrent() != nullptr);
@@ -464,6 +570,16 @@ int32_t TcpChannel::receive(void* buff, size_t size)
 }
 
 std::vector<char> TcpChannel::receiveAll(size_t reserveSize)
+{
+    std::vector<char> buff;
+
+    receiveAll(buff, reserveSize);
+
+    return buff;
+}
+
+size_t TcpChannel::receiveAll(
+    std::vector<char>& buff, size_t reserveSize)
 {
     assert(NetWorker::getCurrent() != nullptr);
 
@@ -472,15 +588,17 @@ std::vector<char> TcpChannel::receiveAll(size_t reserveSize)
         reserveSize = INT32_MAX;
     }
 
-    size_t total = 0;
-    std::vector<char> buff;
+    // appended to the data already in the buffer
+    size_t first = buff.size();
+    size_t total = first;
 
     try
     {
-        buff.resize(reserveSize);
-
         for (;;)
         {
+            // no allocation within the capacity of a reused buffer
+            buff.resize(total + reserveSize);
+
             // receive
             int32_t size = receive(&buff[total], reserveSize);
 
@@ -493,17 +611,15 @@ std::vector<char> TcpChannel::receiveAll(size_t reserveSize)
                 buff.resize(total);
                 break;
             }
-
-            buff.resize(total + reserveSize);
         }
     }
     catch (...)
     {
-        buff.clear();
+        buff.resize(first);
         close();
     }
 
-    return buff;
+    return (total - first);
 }
 
 bool TcpChannel::cancelSend()
@@ -560,6 +676,12 @@ void TcpChannel::onReceive()
 
     mNetWorker->postTask([self, handler]() {
 
+        if (self->isClosed())
+        {
+            // closed by an earlier task
+            return;
+        }
+
         handler(self);
 
         if (self->isClosed())
@@ -575,6 +697,12 @@ void TcpChannel::onReceive()
             self->mNetWorker->getSocketController()->
                 onTcpReceiveEof(self);
         }
+        else if (self->mSocket->hasPendingData())
+        {
+            // the peek has read the next data off the socket,
+            // its edge-triggered event is gone
+            self->onReceive();
+        }
     });
 }
 
@@ -123,8 +123,20 @@ public:
     SEV_DECL int32_t sendString(const std::string& data,
         const TcpSendHandler& sendHandler = nullptr);
 
+    // sent without a copy, the owner keeps the data alive until then
+    // (null for static data)
+    SEV_DECL int32_t send(const std::shared_ptr<const void>& owner,
+        const void* data, size_t size,
+        const TcpSendHandler& sendHandler = nullptr);
+
+    // always async, by sendfile where the socket supports it
+    SEV_DECL int32_t sendFile(const std::string& fileName,
+        const TcpSendHandler& sendHandler = nullptr);
+
     SEV_DECL int32_t receive(void* buff, size_t size);
     SEV_DECL std::vector<char> receiveAll(size_t reserveSize = 8192);
+    SEV_DECL size_t receiveAll(
+        std::vector<char>& buff, size_t reserveSize = 8192);
 
     SEV_DECL void close();
 
@@ -2,6 +2,7 @@
 #define SUBEVENT_TCP_SERVER_WORKER_INL
 
 #include <subevent/tcp_server_worker.hpp>
+#include <subevent/semaphore.hpp>
 #include <subevent/utility.hpp>
 
 SEV_NS_BEGIN
@@ -20,30 +21,54 @@ TcpChannelWorker::TcpChannelWorker(Thread* thread)
 
         if (newChannel != nullptr)
         {
-            newChannel->setReceiveHandler(
-                [&](const TcpChannelPtr& channel) {
-
-                auto buffer = channel->receiveAll();
+            initChannel(newChannel);
+        }
+    });
+}
 
-                if (!buffer.empty())
-                {
-                    onReceive(channel, std::move(buffer));
-                }
-            });
+TcpChannelWorker::~TcpChannelWorker()
+{
+}
 
-            newChannel->setCloseHandler(
-                [&](const TcpChannelPtr& channel) {
+void TcpChannelWorker::initChannel(const TcpChannelPtr& newChannel)
+{
+    newChannel->setReceiveHandler(
+        [&](const TcpChannelPtr& channel) {
 
-                onClose(channel);
-            });
+        auto buffer = channel->receiveAll();
 
-            onAccept(newChannel);
+        if (!buffer.empty())
+        {
+            onReceive(channel, std::move(buffer));
         }
     });
+
+    newChannel->setCloseHandler(
+        [&](const TcpChannelPtr& channel) {
+
+        onClose(channel);
+    });
+
+    onAccept(newChannel);
 }
 
-TcpChannelWorker::~TcpChannelWorker()
+void TcpChannelWorker::onTcpAccept(
+    const TcpServerPtr& server, const TcpChannelPtr& channel)
 {
+    // the kernel does not know the limit
+    if (isChannelFull() || isSocketFull())
+    {
+        channel->close();
+        return;
+    }
+
+    if (!server->accept(this, channel))
+    {
+        channel->close();
+        return;
+    }
+
+    initChannel(channel);
 }
 
 //----------------------------------------------------------------------------//
@@ -52,6 +77,7 @@ TcpChannelWorker::~TcpChannelWorker()
 
 TcpServerWorker::TcpServerWorker(Thread* thread)
     : NetWorker(thread)
+    , mAcceptMode(AcceptMode::Dispatch)
     , mWorkerIndex(-1)
 {
 }
@@ -65,6 +91,11 @@ bool TcpServerWorker::open(
 {
     createTcpServer();
 
+    if (mAcceptMode == AcceptMode::ReusePort)
+    {
+        return openWorkers(localEndPoint, listenBacklog);
+    }
+
     // listen
     bool result = mTcpServer->open(
         localEndPoint,
@@ -80,6 +111,81 @@ void TcpServerWorker::close()
     {
         mTcpServer->close();
     }
+
+    closeWorkers();
+}
+
+bool TcpServerWorker::openWorkers(
+    const IpEndPoint& localEndPoint, int32_t listenBacklog)
+{
+#ifndef SO_REUSEPORT
+    (void)localEndPoint;
+    (void)listenBacklog;
+
+    return false;
+#else
+    if (mWorkerPool.empty())
+    {
+        return false;
+    }
+
+    SocketOption sockOption = mTcpServer->getSocketOption();
+    sockOption.setReusePort(true);
+
+    for (auto worker : mWorkerPool)
+    {
+        TcpServerPtr server = createWorkerServer(worker);
+        server->getSocketOption() = sockOption;
+
+        bool result = false;
+        Semaphore opened;
+
+        bool posted = worker->postTask([&]() {
+
+            result = openWorkerServer(server, localEndPoint,
+                [worker](const TcpServerPtr& tcpServer,
+                    const TcpChannelPtr& channel) {
+
+                worker->onTcpAccept(tcpServer, channel);
+            }, listenBacklog);
+
+            if (result)
+            {
+                worker->mTcpServer = server;
+            }
+
+            opened.post();
+        });
+
+        if (posted)
+        {
+            opened.wait();
+        }
+
+        if (!result)
+        {
+            closeWorkers();
+            return false;
+        }
+    }
+
+    return true;
+#endif
+}
+
+void TcpServerWorker::closeWorkers()
+{
+    for (auto worker : mWorkerPool)
+    {
+        worker->postTask([worker]() {
+
+            if (worker->mTcpServer != nullptr)
+            {
+                worker->mTcpServer->close();
+                worker->mTcpServer = nullptr;
+            }
+        });
+    }
 }
 
 void TcpServerWorker::onTcpAccept(
@@ -129,10 +235,8 @@ TcpChannelWorker* TcpServerWorker::nextWorker()
         return nullptr;
     }
 
-    int32_t startIndex = mWorkerIndex;
-
-    // round robin
-    for (;;)
+    // round robin, the last one included
+    for (size_t count = 0; count < mWorkerPool.size(); ++count)
     {
         ++mWorkerIndex;
 
@@ -142,11 +246,6 @@ TcpChannelWorker* TcpServerWorker::nextWorker()
             mWorkerIndex = 0;
         }
 
-        if (startIndex == mWorkerIndex)
-        {
-            break;
-        }
-
         auto worker = mWorkerPool[mWorkerIndex];
 
         if (!worker->isChannelFull() &&
@@ -23,12 +23,21 @@ public:
 public:
     SEV_DECL bool isChannelFull() const
     {
-        return (getSocketCount() >= getMaxChannels());
+        return (getChannelCount() >= getMaxChannels());
+    }
+
+    SEV_DECL uint32_t getChannelCount() const
+    {
+        // without its own listening socket
+        return getSocketCount() - ((mTcpServer != nullptr) ? 1 : 0);
     }
 
 protected:
     SEV_DECL TcpChannelWorker(Thread* thread);
 
+    // sets the handlers of an accepted channel
+    SEV_DECL virtual void initChannel(const TcpChannelPtr& channel);
+
     SEV_DECL virtual uint16_t getMaxChannels() const
     {
 #ifdef _WIN32
@@ -48,6 +57,14 @@ protected:
 
 private:
     TcpChannelWorker() = delete;
+
+    SEV_DECL void onTcpAccept(
+        const TcpServerPtr& server, const TcpChannelPtr& channel);
+
+    // SO_REUSEPORT mode
+    TcpServerPtr mTcpServer;
+
+    friend class TcpServerWorker;
 };
 
 //---------------------------------------------------------------------------//
@@ -65,7 +82,28 @@ class TcpServerWorker : public NetWorker
 public:
     SEV_DECL virtual ~TcpServerWorker() override;
 
+    enum class AcceptMode
+    {
+        // accepts here and hands the channels to the workers
+        Dispatch,
+
+        // each worker accepts on its own SO_REUSEPORT socket
+        // on the same end point, balanced by the kernel (Linux)
+        ReusePort
+    };
+
 public:
+    // before open()
+    SEV_DECL void setAcceptMode(AcceptMode acceptMode)
+    {
+        mAcceptMode = acceptMode;
+    }
+
+    SEV_DECL AcceptMode getAcceptMode() const
+    {
+        return mAcceptMode;
+    }
+
     SEV_DECL bool open(
         const IpEndPoint& localEndPoint,
         int32_t listenBacklog = SOMAXCONN);
@@ -121,6 +159,27 @@ protected:
     SEV_DECL void onTcpAccept(
         const TcpServerPtr& server, const TcpChannelPtr& channel);
 
+    // SO_REUSEPORT mode, with the options of getTcpServer()
+    SEV_DECL bool openWorkers(
+        const IpEndPoint& localEndPoint, int32_t listenBacklog);
+    SEV_DECL void closeWorkers();
+
+    SEV_DECL virtual TcpServerPtr createWorkerServer(
+        TcpChannelWorker* worker)
+    {
+        return TcpServer::newInstance(worker);
+    }
+
+    // on the thread of the worker
+    SEV_DECL virtual bool openWorkerServer(
+        const TcpServerPtr& server,
+        const IpEndPoint& localEndPoint,
+        const TcpAcceptHandler& acceptHandler,
+        int32_t listenBacklog)
+    {
+        return server->open(localEndPoint, acceptHandler, listenBacklog);
+    }
+
     TcpServerPtr mTcpServer;
 
 private:
@@ -129,6 +188,7 @@ private:
     SEV_DECL void setCpuAffinity();
     SEV_DECL TcpChannelWorker* nextWorker();
 
+    AcceptMode mAcceptMode;
     int32_t mWorkerIndex;
     std::vector<TcpChannelWorker*> mWorkerPool;
 };
@@ -17,6 +17,7 @@ Timer::Timer()
     mInterval = 0;
     mRepeat = false;
     mRunning = false;
+    mIndex = SIZE_MAX;
 }
 
 Timer::~Timer()
@@ -53,6 +53,7 @@ private:
     bool mRepeat;
     TimerHandler mHandler;
     bool mRunning;
+    size_t mIndex;
 
     friend class TimerManager;
 };
@@ -17,6 +17,7 @@ SEV_NS_BEGIN
 
 TimerManager::TimerManager()
 {
+    mSequence = 0;
 }
 
 TimerManager::~TimerManager()
@@ -29,33 +30,23 @@ void TimerManager::start(Timer* timer)
     timer->mRunning = true;
 
     Item item;
-    item.end = std::chrono::system_clock::now() +
+    item.end = Clock::now() +
         std::chrono::milliseconds(timer->getInterval());
     item.timer = timer;
+    item.sequence = mSequence++;
 
-    for (auto it = mItems.begin(); it != mItems.end(); ++it)
-    {
-        if (it->end > item.end)
-        {
-            mItems.insert(it, std::move(item));
-            return;
-        }
-    }
     mItems.push_back(std::move(item));
+    timer->mIndex = mItems.size() - 1;
+    siftUp(mItems.size() - 1);
 }
 
 void TimerManager::cancel(Timer* timer)
 {
     timer->mRunning = false;
 
-    auto it = std::find_if(
-        mItems.begin(), mItems.end(),
-        [&](const Item& item) {
-            return (item.timer == timer);
-        });
-    if (it != mItems.end())
+    if (timer->mIndex != SIZE_MAX)
     {
-        mItems.erase(it);
+        remove(timer->mIndex);
         return;
     }
 
@@ -67,6 +58,7 @@ void TimerManager::cancelAll()
     for (Item& item : mItems)
     {
         item.timer->mRunning = false;
+        item.timer->mIndex = SIZE_MAX;
     }
     mItems.clear();
 
@@ -85,13 +77,15 @@ uint32_t TimerManager::nextTimeout()
     }
     else
     {
-        auto now = std::chrono::system_clock::now();
+        auto now = Clock::now();
         if (mItems.front().end <= now)
         {
             return 0;
         }
 
-        auto remain = mItems.front().end - now;
+        // round up, so the timer has expired when the wait times out
+        auto remain = mItems.front().end - now +
+            std::chrono::milliseconds(1) - Clock::duration(1);
         return static_cast<uint32_t>(std::chrono::duration_cast<
             std::chrono::milliseconds>(remain).count());
     }
@@ -99,7 +93,7 @@ uint32_t TimerManager::nextTimeout()
 
 void TimerManager::expire()
 {
-    auto now = std::chrono::system_clock::now();
+    auto now = Clock::now();
 
     while (!mItems.empty())
     {
@@ -111,12 +105,7 @@ void TimerManager::expire()
         }
 
         Timer* timer = item.timer;
-        mItems.pop_front();
-
-        if (!timer->isRunning())
-        {
-            continue;
-        }
+        remove(0);
 
         mExpired.insert(timer);
 
@@ -144,6 +133,81 @@ void TimerManager::expire()
     }
 }
 
+void TimerManager::place(size_t index, Item&& item)
+{
+    item.timer->mIndex = index;
+    mItems[index] = std::move(item);
+}
+
+void TimerManager::siftUp(size_t index)
+{
+    Item item = std::move(mItems[index]);
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!(item < mItems[parent]))
+        {
+            break;
+        }
+        place(index, std::move(mItems[parent]));
+        index = parent;
+    }
+    place(index, std::move(item));
+}
+
+void TimerManager::siftDown(size_t index)
+{
+    Item item = std::move(mItems[index]);
+    size_t size = mItems.size();
+
+    for (;;)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if ((child + 1 < size) && (mItems[child + 1] < mItems[child]))
+        {
+            ++child;
+        }
+        if (!(mItems[child] < item))
+        {
+            break;
+        }
+        place(index, std::move(mItems[child]));
+        index = child;
+    }
+    place(index, std::move(item));
+}
+
+void TimerManager::remove(size_t index)
+{
+    mItems[index].timer->mIndex = SIZE_MAX;
+
+    size_t last = mItems.size() - 1;
+    if (index != last)
+    {
+        // move the last item into the hole and restore the heap order
+        place(index, std::move(mItems[last]));
+        mItems.pop_back();
+
+        if ((index > 0) && (mItems[index] < mItems[(index - 1) / 2]))
+        {
+            siftUp(index);
+        }
+        else
+        {
+            siftDown(index);
+        }
+    }
+    else
+    {
+        mItems.pop_back();
+    }
+}
+
 SEV_NS_END
 
 #endif // SUBEVENT_TIMER_MANAGER_INL
@@ -2,7 +2,7 @@
 #define SUBEVENT_TIMER_MANAGER_HPP
 
 #include <set>
-#include <list>
+#include <vector>
 #include <chrono>
 
 #include <subevent/std.hpp>
@@ -31,14 +31,30 @@ public:
     SEV_DECL void expire();
 
 private:
+    typedef std::chrono::steady_clock Clock;
 
+    // Timers with the same end expire in the order they were started.
     struct Item
     {
         Timer* timer;
-        std::chrono::system_clock::time_point end;
+        Clock::time_point end;
+        uint64_t sequence;
+
+        SEV_DECL bool operator<(const Item& other) const
+        {
+            return (end != other.end) ? (end < other.end) :
+                (sequence < other.sequence);
+        }
     };
 
-    std::list<Item> mItems;
+    SEV_DECL void place(size_t index, Item&& item);
+    SEV_DECL void siftUp(size_t index);
+    SEV_DECL void siftDown(size_t index);
+    SEV_DECL void remove(size_t index);
+
+    // Min-heap of the running timers, each timer knows its index.
+    std::vector<Item> mItems;
+    uint64_t mSequence;
     std::set<Timer*> mExpired;
 };
 